@@ -9,15 +9,57 @@
 
 #include <openrct2/Context.h>
 #include <openrct2/OpenRCT2.h>
+#include <openrct2/cmdline/CommandLine.hpp>
 #include <openrct2/platform/platform.h>
 
+#ifdef USE_BENCHMARK
+#    include <atomic>
+#    include <cstdlib>
+#    include <new>
+#endif
+
 using namespace OpenRCT2;
 
+#ifdef USE_BENCHMARK
+// Counts the allocations made through the global operator new so simulate can report them. This lives in the executable
+// rather than libopenrct2 so that linking the library never replaces the allocator of its host.
+static std::atomic<uint64_t> _numAllocations{ 0 };
+
+void* operator new(size_t size)
+{
+    _numAllocations.fetch_add(1, std::memory_order_relaxed);
+    void* ptr = std::malloc(size == 0 ? 1 : size);
+    if (ptr == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept
+{
+    std::free(ptr);
+}
+
+static uint64_t GetNumAllocations()
+{
+    return _numAllocations.load(std::memory_order_relaxed);
+}
+#endif
+
 /**
  * Main entry point for non-Windows sytems. Windows instead uses its own DLL proxy.
  */
 int main(int argc, const char** argv)
 {
+#ifdef USE_BENCHMARK
+    CommandLine::GetNumAllocations = GetNumAllocations;
+#endif
     int runGame = cmdline_run(argv, argc);
     core_init();
     if (runGame == 1)
@@ -51,6 +51,7 @@
 #include "paint/Painter.h"
 #include "platform/Crash.h"
 #include "platform/platform.h"
+#include "ride/RideRatings.h"
 #include "ride/TrackDesignRepository.h"
 #include "scenario/Scenario.h"
 #include "scenario/ScenarioRepository.h"
@@ -542,6 +543,7 @@ namespace OpenRCT2
                                 network_close();
                             }
                             game_load_init();
+                            ride_ratings_calculate_all();
                             if (network_get_mode() == NETWORK_MODE_SERVER)
                             {
                                 network_send_map();
@@ -550,6 +552,7 @@ namespace OpenRCT2
                         else
                         {
                             scenario_begin();
+                            ride_ratings_calculate_all();
                             if (network_get_mode() == NETWORK_MODE_SERVER)
                             {
                                 network_send_map();
@@ -306,7 +306,7 @@ namespace Editor
         ride_init_all();
 
         //
-        for (int32_t i = 0; i < MAX_SPRITES; i++)
+        for (size_t i = 0; i < sprite_get_capacity(); i++)
         {
             rct_sprite* sprite = get_sprite(i);
             user_string_free(sprite->generic.name_string_idx);
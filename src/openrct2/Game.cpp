@@ -1205,7 +1205,7 @@ void game_load_init()
  */
 void reset_all_sprite_quadrant_placements()
 {
-    for (size_t i = 0; i < MAX_SPRITES; i++)
+    for (size_t i = 0; i < sprite_get_capacity(); i++)
     {
         rct_sprite* spr = get_sprite(i);
         if (spr->generic.sprite_identifier != SPRITE_IDENTIFIER_NULL)
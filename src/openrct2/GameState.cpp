@@ -15,6 +15,7 @@
 #include "Input.h"
 #include "OpenRCT2.h"
 #include "ReplayManager.h"
+#include "TickProfiler.h"
 #include "interface/Screenshot.h"
 #include "localisation/Date.h"
 #include "localisation/Localisation.h"
@@ -217,13 +218,21 @@ void GameState::Update()
 
 void GameState::UpdateLogic()
 {
+    TickProfiler::BeginTick();
+
     gScreenAge++;
     if (gScreenAge == 0)
         gScreenAge--;
 
-    network_update();
+    {
+        TickProfiler::ScopedTimer timer(TickStage::NetworkUpdate);
+        network_update();
+    }
 
-    GetContext()->GetReplayManager()->Update();
+    {
+        TickProfiler::ScopedTimer timer(TickStage::ReplayUpdate);
+        GetContext()->GetReplayManager()->Update();
+    }
 
     if (network_get_mode() == NETWORK_MODE_CLIENT && network_get_status() == NETWORK_STATUS_CONNECTED
         && network_get_authstatus() == NETWORK_AUTH_OK)
@@ -236,47 +245,104 @@ void GameState::UpdateLogic()
         }
     }
 
-    if (network_get_mode() == NETWORK_MODE_SERVER)
     {
-        // Send current tick out.
-        network_send_tick();
+        TickProfiler::ScopedTimer timer(TickStage::NetworkTick);
+        if (network_get_mode() == NETWORK_MODE_SERVER)
+        {
+            // Send current tick out.
+            network_send_tick();
+        }
+        else if (network_get_mode() == NETWORK_MODE_CLIENT)
+        {
+            // Check desync.
+            network_check_desynchronization();
+        }
+    }
+
+    {
+        TickProfiler::ScopedTimer timer(TickStage::DateUpdate);
+        date_update();
+        _date = Date(gDateMonthTicks, gDateMonthTicks);
     }
-    else if (network_get_mode() == NETWORK_MODE_CLIENT)
     {
-        // Check desync.
-        network_check_desynchronization();
+        TickProfiler::ScopedTimer timer(TickStage::ScenarioUpdate);
+        scenario_update();
+    }
+    {
+        TickProfiler::ScopedTimer timer(TickStage::ClimateUpdate);
+        climate_update();
+    }
+    {
+        TickProfiler::ScopedTimer timer(TickStage::MapUpdateTiles);
+        map_update_tiles();
+        map_update_tile_element_store();
+    }
+    {
+        TickProfiler::ScopedTimer timer(TickStage::MapProvisionalElements);
+        // Temporarily remove provisional paths to prevent peep from interacting with them
+        map_remove_provisional_elements();
+    }
+    {
+        TickProfiler::ScopedTimer timer(TickStage::MapUpdatePathWideFlags);
+        map_update_path_wide_flags();
+    }
+    {
+        TickProfiler::ScopedTimer timer(TickStage::PeepUpdateAll);
+        peep_update_all();
+    }
+    {
+        TickProfiler::ScopedTimer timer(TickStage::MapProvisionalElements);
+        map_restore_provisional_elements();
+    }
+    {
+        TickProfiler::ScopedTimer timer(TickStage::VehicleUpdateAll);
+        vehicle_update_all();
+    }
+    {
+        TickProfiler::ScopedTimer timer(TickStage::SpriteMiscUpdateAll);
+        sprite_misc_update_all();
+    }
+    {
+        TickProfiler::ScopedTimer timer(TickStage::RideUpdateAll);
+        ride_update_all();
     }
-
-    date_update();
-    _date = Date(gDateMonthTicks, gDateMonthTicks);
-
-    scenario_update();
-    climate_update();
-    map_update_tiles();
-    // Temporarily remove provisional paths to prevent peep from interacting with them
-    map_remove_provisional_elements();
-    map_update_path_wide_flags();
-    peep_update_all();
-    map_restore_provisional_elements();
-    vehicle_update_all();
-    sprite_misc_update_all();
-    ride_update_all();
 
     if (!(gScreenFlags & (SCREEN_FLAGS_SCENARIO_EDITOR | SCREEN_FLAGS_TRACK_DESIGNER | SCREEN_FLAGS_TRACK_MANAGER)))
     {
+        TickProfiler::ScopedTimer timer(TickStage::ParkUpdate);
         _park->Update(_date);
     }
 
-    research_update();
-    ride_ratings_update_all();
-    ride_measurements_update();
-    news_item_update_current();
-
-    map_animation_invalidate_all();
-    vehicle_sounds_update();
-    peep_update_crowd_noise();
-    climate_update_sound();
-    editor_open_windows_for_current_step();
+    {
+        TickProfiler::ScopedTimer timer(TickStage::ResearchUpdate);
+        research_update();
+    }
+    {
+        TickProfiler::ScopedTimer timer(TickStage::RideRatingsUpdateAll);
+        ride_ratings_update_all();
+    }
+    {
+        TickProfiler::ScopedTimer timer(TickStage::RideMeasurementsUpdate);
+        ride_measurements_update();
+    }
+    {
+        TickProfiler::ScopedTimer timer(TickStage::NewsItemUpdate);
+        news_item_update_current();
+    }
+    {
+        TickProfiler::ScopedTimer timer(TickStage::MapAnimationInvalidateAll);
+        map_animation_invalidate_all();
+    }
+    {
+        TickProfiler::ScopedTimer timer(TickStage::Sounds);
+        vehicle_sounds_update();
+        peep_update_crowd_noise();
+        climate_update_sound();
+    }
+    {
+        TickProfiler::ScopedTimer timer(TickStage::EditorWindows);
+        editor_open_windows_for_current_step();
+    }
 
     // Update windows
     // window_dispatch_update_all();
@@ -303,11 +369,18 @@ void GameState::UpdateLogic()
 
     // Separated out processing commands in network_update which could call scenario_rand where gInUpdateCode is false.
     // All commands that are received are first queued and then executed where gInUpdateCode is set to true.
-    network_process_pending();
-
-    network_flush();
+    {
+        TickProfiler::ScopedTimer timer(TickStage::NetworkProcessPending);
+        network_process_pending();
+    }
+    {
+        TickProfiler::ScopedTimer timer(TickStage::NetworkFlush);
+        network_flush();
+    }
 
     gCurrentTicks++;
     gScenarioTicks++;
     gSavedAge++;
+
+    TickProfiler::EndTick();
 }
@@ -84,6 +84,7 @@ namespace OpenRCT2
         std::string networkId;
         MemoryStream parkData;
         MemoryStream spriteSpatialData;
+        MemoryStream spritePoolData;
         MemoryStream parkParams;
         std::string name;      // Name of play
         std::string filePath;  // File path of replay.
@@ -97,7 +98,7 @@ namespace OpenRCT2
 
     class ReplayManager final : public IReplayManager
     {
-        static constexpr uint16_t ReplayVersion = 1;
+        static constexpr uint16_t ReplayVersion = 2;
         static constexpr uint32_t ReplayMagic = 0x5243524F; // ORCR.
 
         enum class ReplayMode
@@ -258,10 +259,12 @@ namespace OpenRCT2
 
             auto s6exporter = std::make_unique<S6Exporter>();
             s6exporter->ExportObjectsList = objects;
+            s6exporter->ExtendedSpritePoolFollows = true;
             s6exporter->Export();
             s6exporter->SaveGame(&replayData->parkData);
 
             replayData->spriteSpatialData.Write(gSpriteSpatialIndex, sizeof(gSpriteSpatialIndex));
+            sprite_write_extended_pool(&replayData->spritePoolData);
             replayData->timeRecorded = std::chrono::seconds(std::time(nullptr)).count();
 
             DataSerialiser parkParams(true, replayData->parkParams);
@@ -514,13 +517,14 @@ namespace OpenRCT2
 
                 importer->Import();
 
-                sprite_position_tween_reset();
-
                 Guard::Assert(sizeof(gSpriteSpatialIndex) >= data.spriteSpatialData.GetLength());
 
                 // In case the sprite limit will be increased we keep the unused fields cleared.
                 std::fill_n(gSpriteSpatialIndex, std::size(gSpriteSpatialIndex), SPRITE_INDEX_NULL);
                 std::memcpy(gSpriteSpatialIndex, data.spriteSpatialData.GetData(), data.spriteSpatialData.GetLength());
+                sprite_read_extended_pool(&data.spritePoolData);
+                sprite_spatial_index_sync();
+                sprite_position_tween_reset();
 
                 // Load all map global variables.
                 DataSerialiser parkParams(false, data.parkParams);
@@ -595,6 +599,7 @@ namespace OpenRCT2
             data.parkData.SetPosition(0);
             data.parkParams.SetPosition(0);
             data.spriteSpatialData.SetPosition(0);
+            data.spritePoolData.SetPosition(0);
 
             return true;
         }
@@ -702,6 +707,7 @@ namespace OpenRCT2
             serialiser << data.parkData;
             serialiser << data.parkParams;
             serialiser << data.spriteSpatialData;
+            serialiser << data.spritePoolData;
             serialiser << data.tickStart;
             serialiser << data.tickEnd;
 
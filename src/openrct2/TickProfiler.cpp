@@ -0,0 +1,266 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "TickProfiler.h"
+
+#include "core/CircularBuffer.h"
+#include "core/Json.hpp"
+#include "core/String.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <vector>
+
+using namespace OpenRCT2;
+
+constexpr size_t NUM_TICK_STAGES = static_cast<size_t>(TickStage::Count);
+
+// clang-format off
+static constexpr const char* TickStageNames[NUM_TICK_STAGES] = {
+    "network_update",
+    "replay_update",
+    "network_tick",
+    "date_update",
+    "scenario_update",
+    "climate_update",
+    "map_update_tiles",
+    "map_provisional_elements",
+    "map_update_path_wide_flags",
+    "peep_update_all",
+    "vehicle_update_all",
+    "sprite_misc_update_all",
+    "ride_update_all",
+    "park_update",
+    "research_update",
+    "ride_ratings_update_all",
+    "ride_measurements_update",
+    "news_item_update_current",
+    "map_animation_invalidate_all",
+    "sounds",
+    "editor_windows",
+    "network_process_pending",
+    "network_flush",
+};
+// clang-format on
+
+struct TickSample
+{
+    std::array<uint64_t, NUM_TICK_STAGES> Durations{};
+    std::array<uint32_t, NUM_TICK_STAGES> Calls{};
+    uint64_t Total = 0;
+};
+
+struct StageSummary
+{
+    const char* Name;
+    uint64_t Calls;
+    double Mean;
+    double P50;
+    double P90;
+    double P99;
+    double Max;
+};
+
+static bool _enabled = false;
+static TickSample _currentSample;
+static TickProfiler::Clock::time_point _tickStart;
+static CircularBuffer<TickSample, TickProfiler::HistorySize> _history;
+
+bool TickProfiler::IsEnabled()
+{
+    return _enabled;
+}
+
+void TickProfiler::SetEnabled(bool enabled)
+{
+    if (enabled && !_enabled)
+    {
+        _currentSample = {};
+        _tickStart = Clock::now();
+    }
+    _enabled = enabled;
+}
+
+void TickProfiler::Reset()
+{
+    _history.clear();
+    _currentSample = {};
+}
+
+void TickProfiler::BeginTick()
+{
+    if (_enabled)
+    {
+        _currentSample = {};
+        _tickStart = Clock::now();
+    }
+}
+
+void TickProfiler::EndTick()
+{
+    if (_enabled)
+    {
+        _currentSample.Total = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - _tickStart).count();
+        _history.push_back(_currentSample);
+    }
+}
+
+void TickProfiler::Record(TickStage stage, Clock::duration elapsed)
+{
+    auto index = static_cast<size_t>(stage);
+    if (index < NUM_TICK_STAGES)
+    {
+        _currentSample.Durations[index] += std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+        _currentSample.Calls[index]++;
+    }
+}
+
+size_t TickProfiler::GetNumTicks()
+{
+    return _history.size();
+}
+
+const char* TickProfiler::GetStageName(TickStage stage)
+{
+    auto index = static_cast<size_t>(stage);
+    if (index < NUM_TICK_STAGES)
+    {
+        return TickStageNames[index];
+    }
+    return "total";
+}
+
+static double GetPercentile(const std::vector<uint64_t>& sortedValues, double percentile)
+{
+    if (sortedValues.empty())
+    {
+        return 0;
+    }
+    auto index = static_cast<size_t>((sortedValues.size() - 1) * percentile / 100.0);
+    return sortedValues[index] / 1000.0;
+}
+
+static StageSummary Summarise(const char* name, std::vector<uint64_t>& values, uint64_t calls)
+{
+    std::sort(values.begin(), values.end());
+
+    uint64_t sum = 0;
+    for (auto value : values)
+    {
+        sum += value;
+    }
+
+    StageSummary summary{};
+    summary.Name = name;
+    summary.Calls = calls;
+    if (!values.empty())
+    {
+        summary.Mean = (sum / 1000.0) / values.size();
+        summary.Max = values.back() / 1000.0;
+    }
+    summary.P50 = GetPercentile(values, 50);
+    summary.P90 = GetPercentile(values, 90);
+    summary.P99 = GetPercentile(values, 99);
+    return summary;
+}
+
+static std::vector<StageSummary> GetSummaries()
+{
+    std::vector<StageSummary> summaries;
+    std::vector<uint64_t> values;
+    values.reserve(_history.size());
+
+    for (size_t stage = 0; stage < NUM_TICK_STAGES; stage++)
+    {
+        uint64_t calls = 0;
+        values.clear();
+        for (size_t i = 0; i < _history.size(); i++)
+        {
+            values.push_back(_history[i].Durations[stage]);
+            calls += _history[i].Calls[stage];
+        }
+        summaries.push_back(Summarise(TickStageNames[stage], values, calls));
+    }
+
+    values.clear();
+    for (size_t i = 0; i < _history.size(); i++)
+    {
+        values.push_back(_history[i].Total);
+    }
+    summaries.push_back(Summarise("total", values, _history.size()));
+    return summaries;
+}
+
+static std::string GetReportJson(const std::vector<StageSummary>& summaries)
+{
+    json_t* jStages = json_array();
+    for (const auto& summary : summaries)
+    {
+        json_t* jStage = json_object();
+        json_object_set_new(jStage, "name", json_string(summary.Name));
+        json_object_set_new(jStage, "calls", json_integer(summary.Calls));
+        json_object_set_new(jStage, "mean_us", json_real(summary.Mean));
+        json_object_set_new(jStage, "p50_us", json_real(summary.P50));
+        json_object_set_new(jStage, "p90_us", json_real(summary.P90));
+        json_object_set_new(jStage, "p99_us", json_real(summary.P99));
+        json_object_set_new(jStage, "max_us", json_real(summary.Max));
+        json_array_append_new(jStages, jStage);
+    }
+
+    json_t* jReport = json_object();
+    json_object_set_new(jReport, "ticks", json_integer(_history.size()));
+    json_object_set_new(jReport, "stages", jStages);
+
+    char* raw = json_dumps(jReport, JSON_INDENT(2) | JSON_PRESERVE_ORDER);
+    std::string result = raw != nullptr ? raw : "";
+    free(raw);
+    json_decref(jReport);
+    return result;
+}
+
+static std::string GetReportCsv(const std::vector<StageSummary>& summaries)
+{
+    std::string result = "stage,calls,mean_us,p50_us,p90_us,p99_us,max_us\n";
+    for (const auto& summary : summaries)
+    {
+        result += String::StdFormat(
+            "%s,%llu,%.3f,%.3f,%.3f,%.3f,%.3f\n", summary.Name, (unsigned long long)summary.Calls, summary.Mean, summary.P50,
+            summary.P90, summary.P99, summary.Max);
+    }
+    return result;
+}
+
+std::string TickProfiler::GetReport(TickProfilerFormat format)
+{
+    auto summaries = GetSummaries();
+    switch (format)
+    {
+        case TickProfilerFormat::Json:
+            return GetReportJson(summaries);
+        case TickProfilerFormat::Csv:
+        default:
+            return GetReportCsv(summaries);
+    }
+}
+
+bool TickProfiler::TryParseFormat(const std::string& s, TickProfilerFormat* outFormat)
+{
+    if (String::Equals(s, "json", true))
+    {
+        *outFormat = TickProfilerFormat::Json;
+        return true;
+    }
+    if (String::Equals(s, "csv", true))
+    {
+        *outFormat = TickProfilerFormat::Csv;
+        return true;
+    }
+    return false;
+}
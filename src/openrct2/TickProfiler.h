@@ -0,0 +1,116 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "common.h"
+
+#include <chrono>
+#include <string>
+
+namespace OpenRCT2
+{
+    /**
+     * The stages of GameState::UpdateLogic that are timed by the tick profiler.
+     */
+    enum class TickStage : uint8_t
+    {
+        NetworkUpdate,
+        ReplayUpdate,
+        NetworkTick,
+        DateUpdate,
+        ScenarioUpdate,
+        ClimateUpdate,
+        MapUpdateTiles,
+        // Removing the provisional elements before the peeps are updated and restoring them afterwards
+        MapProvisionalElements,
+        MapUpdatePathWideFlags,
+        PeepUpdateAll,
+        VehicleUpdateAll,
+        SpriteMiscUpdateAll,
+        RideUpdateAll,
+        ParkUpdate,
+        ResearchUpdate,
+        RideRatingsUpdateAll,
+        RideMeasurementsUpdate,
+        NewsItemUpdate,
+        MapAnimationInvalidateAll,
+        Sounds,
+        EditorWindows,
+        NetworkProcessPending,
+        NetworkFlush,
+        Count,
+    };
+
+    enum class TickProfilerFormat : uint8_t
+    {
+        Json,
+        Csv,
+    };
+
+    /**
+     * Records the wall time and call count of every stage of each game tick into a ring buffer
+     * of the last HistorySize ticks. Disabled by default; when disabled the timers do not read the clock.
+     */
+    namespace TickProfiler
+    {
+        constexpr size_t HistorySize = 1024;
+
+        using Clock = std::chrono::high_resolution_clock;
+
+        bool IsEnabled();
+        void SetEnabled(bool enabled);
+        void Reset();
+
+        void BeginTick();
+        void EndTick();
+        void Record(TickStage stage, Clock::duration elapsed);
+
+        size_t GetNumTicks();
+        const char* GetStageName(TickStage stage);
+
+        /**
+         * Formats the per-stage mean, percentiles (in microseconds) and call counts over the recorded history.
+         */
+        std::string GetReport(TickProfilerFormat format);
+        bool TryParseFormat(const std::string& s, TickProfilerFormat* outFormat);
+
+        /**
+         * Times the enclosing scope and records it against the given stage.
+         */
+        class ScopedTimer final
+        {
+        private:
+            TickStage _stage;
+            bool _active;
+            Clock::time_point _start;
+
+        public:
+            explicit ScopedTimer(TickStage stage)
+                : _stage(stage)
+                , _active(IsEnabled())
+            {
+                if (_active)
+                {
+                    _start = Clock::now();
+                }
+            }
+            ScopedTimer(const ScopedTimer&) = delete;
+            ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+            ~ScopedTimer()
+            {
+                if (_active)
+                {
+                    Record(_stage, Clock::now() - _start);
+                }
+            }
+        };
+    } // namespace TickProfiler
+} // namespace OpenRCT2
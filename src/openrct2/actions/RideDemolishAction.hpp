@@ -308,9 +308,14 @@ private:
                     type | (it.element->AsTrack()->GetSequenceIndex() << 8), GAME_COMMAND_REMOVE_TRACK, z, 0);
 
                 if (removePrice == MONEY32_UNDEFINED)
+                {
+                    peep_pathfind_cache_invalidate(x, y);
                     tile_element_remove(it.element);
+                }
                 else
+                {
                     refundPrice += removePrice;
+                }
 
                 tile_element_iterator_restart_for_tile(&it);
                 continue;
@@ -0,0 +1,162 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "CommandLine.hpp"
+
+#ifdef USE_BENCHMARK
+
+#    include "../drawing/Drawing.h"
+#    include "../util/Util.h"
+
+#    include <benchmark/benchmark.h>
+#    include <cstdint>
+#    include <random>
+#    include <vector>
+
+using palette_to_rgba_func = void (*)(
+    const uint8_t* RESTRICT src, uint32_t* RESTRICT dst, size_t count, const uint32_t* RESTRICT palette);
+using palette_to_rgba_lit_func = void (*)(
+    const uint8_t* RESTRICT src, const uint8_t* RESTRICT light, uint32_t* RESTRICT dst, size_t count,
+    const uint32_t* RESTRICT palette, const uint32_t* RESTRICT lightPalette);
+
+/**
+ * A frame of random pixels, of which roughly a third are lit, the same for every run.
+ */
+struct BenchFrame
+{
+    std::vector<uint8_t> Bits;
+    std::vector<uint8_t> LightBits;
+    std::vector<uint32_t> Palette;
+    std::vector<uint32_t> LightPalette;
+    std::vector<uint32_t> Pixels;
+
+    explicit BenchFrame(size_t numPixels)
+        : Bits(numPixels)
+        , LightBits(numPixels)
+        , Palette(256)
+        , LightPalette(256)
+        , Pixels(numPixels)
+    {
+        std::mt19937 random(0);
+        for (size_t i = 0; i < numPixels; i++)
+        {
+            Bits[i] = (uint8_t)random();
+            LightBits[i] = random() % 3 == 0 ? (uint8_t)random() : 0;
+        }
+        for (size_t i = 0; i < 256; i++)
+        {
+            Palette[i] = (uint32_t)random();
+            LightPalette[i] = (uint32_t)random();
+        }
+    }
+};
+
+static void BM_palette_to_rgba(benchmark::State& state, palette_to_rgba_func func)
+{
+    BenchFrame frame((size_t)(state.range(0) * state.range(1)));
+    for (auto _ : state)
+    {
+        func(frame.Bits.data(), frame.Pixels.data(), frame.Pixels.size(), frame.Palette.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * frame.Pixels.size());
+}
+
+static void BM_palette_to_rgba_lit(benchmark::State& state, palette_to_rgba_lit_func func)
+{
+    BenchFrame frame((size_t)(state.range(0) * state.range(1)));
+    for (auto _ : state)
+    {
+        func(
+            frame.Bits.data(), frame.LightBits.data(), frame.Pixels.data(), frame.Pixels.size(), frame.Palette.data(),
+            frame.LightPalette.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * frame.Pixels.size());
+}
+
+static void RegisterPaletteBenchmark(const char* name, palette_to_rgba_func func)
+{
+    benchmark::RegisterBenchmark(name, BM_palette_to_rgba, func)->Args({ 1920, 1080 })->Args({ 3840, 2160 });
+}
+
+static void RegisterPaletteLitBenchmark(const char* name, palette_to_rgba_lit_func func)
+{
+    benchmark::RegisterBenchmark(name, BM_palette_to_rgba_lit, func)->Args({ 1920, 1080 })->Args({ 3840, 2160 });
+}
+
+static int cmdline_for_bench_palette(int argc, const char** argv)
+{
+    // Google benchmark does stuff to argv. It doesn't modify the pointees,
+    // but it wants to reorder the pointers, so present a copy of them.
+    std::vector<char*> argv_for_benchmark;
+
+    // argv[0] is expected to contain the binary name. It's only for logging purposes, don't bother.
+    argv_for_benchmark.push_back(nullptr);
+    for (int i = 0; i < argc; i++)
+    {
+        argv_for_benchmark.push_back((char*)argv[i]);
+    }
+
+    // Only the kernels this CPU can run are registered, no park or game data is needed.
+    RegisterPaletteBenchmark("palette_to_rgba/scalar", palette_to_rgba_scalar);
+    RegisterPaletteLitBenchmark("palette_to_rgba_lit/scalar", palette_to_rgba_lit_scalar);
+    if (sse41_available())
+    {
+        RegisterPaletteLitBenchmark("palette_to_rgba_lit/sse4_1", palette_to_rgba_lit_sse4_1);
+    }
+    if (avx2_available())
+    {
+        RegisterPaletteBenchmark("palette_to_rgba/avx2", palette_to_rgba_avx2);
+        RegisterPaletteLitBenchmark("palette_to_rgba_lit/avx2", palette_to_rgba_lit_avx2);
+    }
+
+    // Update argc with all the changes made
+    argc = (int)argv_for_benchmark.size();
+    ::benchmark::Initialize(&argc, &argv_for_benchmark[0]);
+    if (::benchmark::ReportUnrecognizedArguments(argc, &argv_for_benchmark[0]))
+        return -1;
+    ::benchmark::RunSpecifiedBenchmarks();
+    return 0;
+}
+
+static exitcode_t HandleBenchPalette(CommandLineArgEnumerator* argEnumerator)
+{
+    const char** argv = (const char**)argEnumerator->GetArguments() + argEnumerator->GetIndex();
+    int32_t argc = argEnumerator->GetCount() - argEnumerator->GetIndex();
+    int32_t result = cmdline_for_bench_palette(argc, argv);
+    if (result < 0)
+    {
+        return EXITCODE_FAIL;
+    }
+    return EXITCODE_OK;
+}
+
+#else
+static exitcode_t HandleBenchPalette(CommandLineArgEnumerator* argEnumerator)
+{
+    log_error("Sorry, Google benchmark not enabled in this build");
+    return EXITCODE_FAIL;
+}
+#endif // USE_BENCHMARK
+
+const CommandLineCommand CommandLine::BenchPaletteCommands[]{
+#ifdef USE_BENCHMARK
+    DefineCommand(
+        "",
+        "[--benchmark_list_tests={true|false}] [--benchmark_filter=<regex>] [--benchmark_min_time=<min_time>] "
+        "[--benchmark_repetitions=<num_repetitions>] [--benchmark_report_aggregates_only={true|false}] "
+        "[--benchmark_format=<console|json|csv>] [--benchmark_out=<filename>] [--benchmark_out_format=<json|console|csv>] "
+        "[--benchmark_color={auto|true|false}] [--benchmark_counters_tabular={true|false}] [--v=<verbosity>]",
+        nullptr, HandleBenchPalette),
+    CommandTableEnd
+#else
+    DefineCommand("", "*** SORRY NOT ENABLED IN THIS BUILD ***", nullptr, HandleBenchPalette), CommandTableEnd
+#endif // USE_BENCHMARK
+};
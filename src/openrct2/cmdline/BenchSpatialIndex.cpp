@@ -0,0 +1,160 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "CommandLine.hpp"
+
+#ifdef USE_BENCHMARK
+
+#    include "../Context.h"
+#    include "../OpenRCT2.h"
+#    include "../platform/platform.h"
+#    include "../world/Map.h"
+#    include "../world/Sprite.h"
+
+#    include <benchmark/benchmark.h>
+#    include <cstdint>
+#    include <memory>
+#    include <vector>
+
+// Both benchmarks visit every tile of the map and count the sprites that are within 16 units of a
+// height, which is what most of the game's quadrant queries do before looking at anything else.
+static constexpr int32_t BENCH_QUERY_Z = 14 * 8;
+
+static void BM_spatial_index_linked_list(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        uint32_t found = 0;
+        for (int32_t x = 0; x < gMapSize; x++)
+        {
+            for (int32_t y = 0; y < gMapSize; y++)
+            {
+                uint16_t spriteIndex = sprite_get_first_in_quadrant(x * 32, y * 32);
+                while (spriteIndex != SPRITE_INDEX_NULL)
+                {
+                    const rct_sprite* sprite = get_sprite(spriteIndex);
+                    if (abs(sprite->generic.z - BENCH_QUERY_Z) <= 16)
+                    {
+                        found++;
+                    }
+                    spriteIndex = sprite->generic.next_in_quadrant;
+                }
+            }
+        }
+        benchmark::DoNotOptimize(found);
+    }
+    state.SetItemsProcessed(state.iterations() * gMapSize * gMapSize);
+}
+
+static void BM_spatial_index_cells(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        uint32_t found = 0;
+        for (int32_t x = 0; x < gMapSize; x++)
+        {
+            for (int32_t y = 0; y < gMapSize; y++)
+            {
+                for (const auto& entry : sprite_get_quadrant(x * 32, y * 32))
+                {
+                    if (abs(entry.z - BENCH_QUERY_Z) <= 16)
+                    {
+                        found++;
+                    }
+                }
+            }
+        }
+        benchmark::DoNotOptimize(found);
+    }
+    state.SetItemsProcessed(state.iterations() * gMapSize * gMapSize);
+}
+
+static int cmdline_for_bench_spatial_index(int argc, const char** argv)
+{
+    // Google benchmark does stuff to argv. It doesn't modify the pointees,
+    // but it wants to reorder the pointers, so present a copy of them.
+    std::vector<char*> argv_for_benchmark;
+
+    // argv[0] is expected to contain the binary name. It's only for logging purposes, don't bother.
+    argv_for_benchmark.push_back(nullptr);
+
+    // The park has to stay loaded while the benchmarks run, so only the first park given is used.
+    const char* parkPath = nullptr;
+    for (int i = 0; i < argc; i++)
+    {
+        if (parkPath == nullptr && platform_file_exists(argv[i]))
+        {
+            parkPath = argv[i];
+        }
+        else
+        {
+            argv_for_benchmark.push_back((char*)argv[i]);
+        }
+    }
+    if (parkPath == nullptr)
+    {
+        log_error("No park given.");
+        return -1;
+    }
+
+    core_init();
+    gOpenRCT2Headless = true;
+    std::unique_ptr<OpenRCT2::IContext> context(OpenRCT2::CreateContext());
+    if (!context->Initialise() || !context->LoadParkFromFile(parkPath))
+    {
+        log_error("Failed to load park!");
+        return -1;
+    }
+
+    benchmark::RegisterBenchmark("linked_list", BM_spatial_index_linked_list);
+    benchmark::RegisterBenchmark("cells", BM_spatial_index_cells);
+
+    // Update argc with all the changes made
+    argc = (int)argv_for_benchmark.size();
+    ::benchmark::Initialize(&argc, &argv_for_benchmark[0]);
+    if (::benchmark::ReportUnrecognizedArguments(argc, &argv_for_benchmark[0]))
+        return -1;
+    ::benchmark::RunSpecifiedBenchmarks();
+    return 0;
+}
+
+static exitcode_t HandleBenchSpatialIndex(CommandLineArgEnumerator* argEnumerator)
+{
+    const char** argv = (const char**)argEnumerator->GetArguments() + argEnumerator->GetIndex();
+    int32_t argc = argEnumerator->GetCount() - argEnumerator->GetIndex();
+    int32_t result = cmdline_for_bench_spatial_index(argc, argv);
+    if (result < 0)
+    {
+        return EXITCODE_FAIL;
+    }
+    return EXITCODE_OK;
+}
+
+#else
+static exitcode_t HandleBenchSpatialIndex(CommandLineArgEnumerator* argEnumerator)
+{
+    log_error("Sorry, Google benchmark not enabled in this build");
+    return EXITCODE_FAIL;
+}
+#endif // USE_BENCHMARK
+
+const CommandLineCommand CommandLine::BenchSpatialIndexCommands[]{
+#ifdef USE_BENCHMARK
+    DefineCommand(
+        "",
+        "<file> [--benchmark_list_tests={true|false}] [--benchmark_filter=<regex>] [--benchmark_min_time=<min_time>] "
+        "[--benchmark_repetitions=<num_repetitions>] [--benchmark_report_aggregates_only={true|false}] "
+        "[--benchmark_format=<console|json|csv>] [--benchmark_out=<filename>] [--benchmark_out_format=<json|console|csv>] "
+        "[--benchmark_color={auto|true|false}] [--benchmark_counters_tabular={true|false}] [--v=<verbosity>]",
+        nullptr, HandleBenchSpatialIndex),
+    CommandTableEnd
+#else
+    DefineCommand("", "*** SORRY NOT ENABLED IN THIS BUILD ***", nullptr, HandleBenchSpatialIndex), CommandTableEnd
+#endif // USE_BENCHMARK
+};
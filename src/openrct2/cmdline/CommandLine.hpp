@@ -118,8 +118,16 @@ namespace CommandLine
     extern const CommandLineCommand SpriteCommands[];
     extern const CommandLineCommand BenchGfxCommands[];
     extern const CommandLineCommand BenchSpriteSortCommands[];
+    extern const CommandLineCommand BenchSpatialIndexCommands[];
+    extern const CommandLineCommand BenchPaletteCommands[];
     extern const CommandLineCommand SimulateCommands[];
 
+    /**
+     * Set by executables that count the calls to the global operator new, simulate reports the allocations made while
+     * measuring when it is set.
+     */
+    extern uint64_t (*GetNumAllocations)();
+
     extern const CommandLineExample RootExamples[];
 
     void PrintHelp(bool allCommands = false);
@@ -11,23 +11,191 @@
 #include "../Game.h"
 #include "../GameState.h"
 #include "../OpenRCT2.h"
+#include "../TickProfiler.h"
 #include "../core/Console.hpp"
+#include "../core/File.h"
+#include "../core/String.hpp"
 #include "../network/network.h"
+#include "../platform/Platform2.h"
 #include "../platform/platform.h"
 #include "../world/Sprite.h"
 #include "CommandLine.hpp"
 
+#include <algorithm>
+#include <chrono>
 #include <cstdlib>
+#include <map>
 #include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
 
 using namespace OpenRCT2;
 
+static int32_t _warmupTicks = 0;
+static int32_t _repetitions = 1;
+static utf8* _checksumsPath = nullptr;
+static utf8* _recordChecksumsPath = nullptr;
+static utf8* _profileFormat = nullptr;
+static utf8* _profileOutput = nullptr;
+
+// clang-format off
+static constexpr const CommandLineOptionDefinition SimulateOptions[]
+{
+    { CMDLINE_TYPE_INTEGER, &_warmupTicks,         NAC, "warmup",           "number of ticks to run before measuring"                      },
+    { CMDLINE_TYPE_INTEGER, &_repetitions,         NAC, "repetitions",      "number of times to reload and run each park"                 },
+    { CMDLINE_TYPE_STRING,  &_checksumsPath,       NAC, "checksums",        "verify the final sprite checksums against the given file"    },
+    { CMDLINE_TYPE_STRING,  &_recordChecksumsPath, NAC, "record-checksums", "write the final sprite checksums to the given file"          },
+    { CMDLINE_TYPE_STRING,  &_profileFormat,       NAC, "profile",          "record per-stage tick timings and print them as json or csv" },
+    { CMDLINE_TYPE_STRING,  &_profileOutput,       NAC, "profile-output",   "write the tick profile to the given file instead of stdout"  },
+    OptionTableEnd
+};
+
 static exitcode_t HandleSimulate(CommandLineArgEnumerator* argEnumerator);
 
-const CommandLineCommand CommandLine::SimulateCommands[]{ // Main commands
-                                                          DefineCommand("", "<ticks>", nullptr, HandleSimulate), CommandTableEnd
+const CommandLineCommand CommandLine::SimulateCommands[]
+{
+    // Main commands
+    DefineCommand("", "<file> [<file>...] <ticks>", SimulateOptions, HandleSimulate),
+    CommandTableEnd
+};
+// clang-format on
+
+struct SimulateResult
+{
+    std::string Path;
+    std::string Checksum;
+    bool Deterministic = true;
+    std::vector<uint64_t> TickTimes;
+    uint64_t TotalTime = 0;
+    uint64_t NumTicks = 0;
+    uint64_t NumAllocations = 0;
 };
 
+uint64_t (*CommandLine::GetNumAllocations)() = nullptr;
+
+/**
+ * Checksum files contain one line per park in the form: <checksum> <ticks> <park path>
+ * Paths are compared as given on the command line so checksum files can be shared between machines, record and verify
+ * them from the same working directory.
+ */
+static std::string GetChecksumKey(const std::string& path, uint32_t ticks)
+{
+    return std::to_string(ticks) + " " + path;
+}
+
+static std::map<std::string, std::string> ReadChecksums(const std::string& path)
+{
+    std::map<std::string, std::string> checksums;
+    for (const auto& line : File::ReadAllLines(path))
+    {
+        std::istringstream ss(line);
+        std::string checksum;
+        uint32_t ticks;
+        std::string parkPath;
+        if (ss >> checksum >> ticks && std::getline(ss >> std::ws, parkPath))
+        {
+            checksums[GetChecksumKey(parkPath, ticks)] = checksum;
+        }
+    }
+    return checksums;
+}
+
+static void WriteChecksums(const std::string& path, const std::vector<SimulateResult>& results, uint32_t ticks)
+{
+    std::string text;
+    for (const auto& result : results)
+    {
+        text += result.Checksum + " " + GetChecksumKey(result.Path, ticks) + "\n";
+    }
+    File::WriteAllBytes(path, text.data(), text.size());
+}
+
+static double GetPercentileMs(const std::vector<uint64_t>& sortedTimes, double percentile)
+{
+    if (sortedTimes.empty())
+    {
+        return 0;
+    }
+    auto index = static_cast<size_t>((sortedTimes.size() - 1) * percentile / 100.0);
+    return sortedTimes[index] / 1000000.0;
+}
+
+static void PrintResult(SimulateResult& result)
+{
+    std::sort(result.TickTimes.begin(), result.TickTimes.end());
+
+    double seconds = result.TotalTime / 1000000000.0;
+    double ticksPerSecond = seconds > 0 ? result.NumTicks / seconds : 0;
+
+    Console::WriteLine("%s", result.Path.c_str());
+    Console::WriteLine(
+        "  Ticks:       %llu in %.3f s (%.1f ticks/s)", (unsigned long long)result.NumTicks, seconds, ticksPerSecond);
+    Console::WriteLine(
+        "  Tick (ms):   p50 %.3f, p90 %.3f, p99 %.3f, max %.3f", GetPercentileMs(result.TickTimes, 50),
+        GetPercentileMs(result.TickTimes, 90), GetPercentileMs(result.TickTimes, 99), GetPercentileMs(result.TickTimes, 100));
+    if (CommandLine::GetNumAllocations != nullptr)
+    {
+        Console::WriteLine(
+            "  Allocations: %llu (%.1f per tick)", (unsigned long long)result.NumAllocations,
+            result.NumTicks > 0 ? (double)result.NumAllocations / result.NumTicks : 0.0);
+    }
+    Console::WriteLine("  Checksum:    %s", result.Checksum.c_str());
+}
+
+static bool RunPark(IContext* context, const std::string& path, uint32_t ticks, SimulateResult& result)
+{
+    result.Path = path;
+    for (int32_t repetition = 0; repetition < std::max(1, _repetitions); repetition++)
+    {
+        if (!context->LoadParkFromFile(path))
+        {
+            Console::Error::WriteLine("Unable to load park: %s", path.c_str());
+            return false;
+        }
+
+        auto gameState = context->GetGameState();
+        for (int32_t i = 0; i < _warmupTicks; i++)
+        {
+            gameState->UpdateLogic();
+        }
+
+        // Only the measured ticks are profiled, the report covers every park and repetition
+        TickProfiler::SetEnabled(_profileFormat != nullptr);
+        uint64_t allocationsBefore = CommandLine::GetNumAllocations != nullptr ? CommandLine::GetNumAllocations() : 0;
+        for (uint32_t i = 0; i < ticks; i++)
+        {
+            auto startTime = std::chrono::high_resolution_clock::now();
+            gameState->UpdateLogic();
+            auto endTime = std::chrono::high_resolution_clock::now();
+
+            auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(endTime - startTime).count();
+            result.TickTimes.push_back(elapsed);
+            result.TotalTime += elapsed;
+        }
+        if (CommandLine::GetNumAllocations != nullptr)
+        {
+            result.NumAllocations += CommandLine::GetNumAllocations() - allocationsBefore;
+        }
+        TickProfiler::SetEnabled(false);
+        result.NumTicks += ticks;
+
+        auto checksum = sprite_checksum().ToString();
+        if (repetition == 0)
+        {
+            result.Checksum = checksum;
+        }
+        else if (checksum != result.Checksum)
+        {
+            Console::Error::WriteLine(
+                "Repetition %d of %s ended with checksum %s, expected %s", repetition + 1, path.c_str(), checksum.c_str(),
+                result.Checksum.c_str());
+            result.Deterministic = false;
+        }
+    }
+    return true;
+}
+
 static exitcode_t HandleSimulate(CommandLineArgEnumerator* argEnumerator)
 {
     const char** argv = (const char**)argEnumerator->GetArguments() + argEnumerator->GetIndex();
@@ -41,8 +209,29 @@ static exitcode_t HandleSimulate(CommandLineArgEnumerator* argEnumerator)
 
     core_init();
 
-    const char* inputPath = argv[0];
-    uint32_t ticks = atol(argv[1]);
+    std::vector<std::string> inputPaths(argv, argv + argc - 1);
+    uint32_t ticks = atol(argv[argc - 1]);
+
+    auto profileFormat = TickProfilerFormat::Csv;
+    if (_profileFormat != nullptr && !TickProfiler::TryParseFormat(_profileFormat, &profileFormat))
+    {
+        Console::Error::WriteLine("Unknown profile format '%s', expected json or csv.", _profileFormat);
+        return EXITCODE_FAIL;
+    }
+
+    std::map<std::string, std::string> expectedChecksums;
+    if (_checksumsPath != nullptr)
+    {
+        try
+        {
+            expectedChecksums = ReadChecksums(_checksumsPath);
+        }
+        catch (const std::exception& e)
+        {
+            Console::Error::WriteLine("Unable to read checksums: %s", e.what());
+            return EXITCODE_FAIL;
+        }
+    }
 
     gOpenRCT2Headless = true;
 
@@ -51,25 +240,82 @@ static exitcode_t HandleSimulate(CommandLineArgEnumerator* argEnumerator)
 #endif
 
     std::unique_ptr<IContext> context(CreateContext());
-    if (context->Initialise())
+    if (!context->Initialise())
     {
-        if (!context->LoadParkFromFile(inputPath))
+        Console::Error::WriteLine("Context initialization failed.");
+        return EXITCODE_FAIL;
+    }
+
+    TickProfiler::Reset();
+
+    Console::WriteLine(
+        "Running %u ticks (%d warmup) %d time(s) on %zu park(s)...", ticks, _warmupTicks, std::max(1, _repetitions),
+        inputPaths.size());
+
+    bool passed = true;
+    std::vector<SimulateResult> results;
+    for (const auto& inputPath : inputPaths)
+    {
+        SimulateResult result;
+        if (!RunPark(context.get(), inputPath, ticks, result))
         {
             return EXITCODE_FAIL;
         }
+        PrintResult(result);
 
-        Console::WriteLine("Running %d ticks...", ticks);
-        for (uint32_t i = 0; i < ticks; i++)
+        passed &= result.Deterministic;
+        if (_checksumsPath != nullptr)
         {
-            context->GetGameState()->UpdateLogic();
+            auto it = expectedChecksums.find(GetChecksumKey(inputPath, ticks));
+            if (it == expectedChecksums.end())
+            {
+                Console::Error::WriteLine("  No recorded checksum for %s after %u ticks.", inputPath.c_str(), ticks);
+                passed = false;
+            }
+            else if (it->second != result.Checksum)
+            {
+                Console::Error::WriteLine("  Checksum mismatch, expected %s", it->second.c_str());
+                passed = false;
+            }
         }
-        Console::WriteLine("Completed: %s", sprite_checksum());
+        results.push_back(std::move(result));
     }
-    else
+
+    Console::WriteLine("Peak resident memory: %.1f MiB", Platform::GetPeakResidentMemory() / (1024.0 * 1024.0));
+
+    if (_recordChecksumsPath != nullptr)
     {
-        Console::Error::WriteLine("Context initialization failed.");
-        return EXITCODE_FAIL;
+        try
+        {
+            WriteChecksums(_recordChecksumsPath, results, ticks);
+        }
+        catch (const std::exception& e)
+        {
+            Console::Error::WriteLine("Unable to write checksums: %s", e.what());
+            return EXITCODE_FAIL;
+        }
+    }
+
+    if (_profileFormat != nullptr)
+    {
+        auto report = TickProfiler::GetReport(profileFormat);
+        if (_profileOutput != nullptr)
+        {
+            try
+            {
+                File::WriteAllBytes(_profileOutput, report.data(), report.size());
+            }
+            catch (const std::exception& e)
+            {
+                Console::Error::WriteLine("Unable to write tick profile: %s", e.what());
+                return EXITCODE_FAIL;
+            }
+        }
+        else
+        {
+            Console::WriteLine("%s", report.c_str());
+        }
     }
 
-    return EXITCODE_OK;
+    return passed ? EXITCODE_OK : EXITCODE_FAIL;
 }
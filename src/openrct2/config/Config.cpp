@@ -212,6 +212,7 @@ namespace Config
             model->show_guest_purchases = reader->GetBoolean("show_guest_purchases", false);
             model->show_real_names_of_guests = reader->GetBoolean("show_real_names_of_guests", true);
             model->allow_early_completion = reader->GetBoolean("allow_early_completion", false);
+            model->multithreading = reader->GetBoolean("multithreading", false);
         }
     }
 
@@ -285,6 +286,7 @@ namespace Config
         writer->WriteBoolean("show_guest_purchases", model->show_guest_purchases);
         writer->WriteBoolean("show_real_names_of_guests", model->show_real_names_of_guests);
         writer->WriteBoolean("allow_early_completion", model->allow_early_completion);
+        writer->WriteBoolean("multithreading", model->multithreading);
         writer->WriteEnum<int32_t>("virtual_floor_style", model->virtual_floor_style, Enum_VirtualFloorStyle);
     }
 
@@ -393,6 +395,8 @@ namespace Config
             model->log_chat = reader->GetBoolean("log_chat", false);
             model->log_server_actions = reader->GetBoolean("log_server_actions", false);
             model->pause_server_if_no_clients = reader->GetBoolean("pause_server_if_no_clients", false);
+            model->io_thread = reader->GetBoolean("io_thread", false);
+            model->packet_compression = reader->GetBoolean("packet_compression", true);
         }
     }
 
@@ -418,6 +422,8 @@ namespace Config
         writer->WriteBoolean("log_chat", model->log_chat);
         writer->WriteBoolean("log_server_actions", model->log_server_actions);
         writer->WriteBoolean("pause_server_if_no_clients", model->pause_server_if_no_clients);
+        writer->WriteBoolean("io_thread", model->io_thread);
+        writer->WriteBoolean("packet_compression", model->packet_compression);
     }
 
     static void ReadNotifications(IIniReader* reader)
@@ -83,6 +83,7 @@ struct GeneralConfiguration
     bool steam_overlay_pause;
     bool show_real_names_of_guests;
     bool allow_early_completion;
+    bool multithreading;
 
     // Loading and saving
     bool confirmation_prompt;
@@ -153,6 +154,8 @@ struct NetworkConfiguration
     bool log_chat;
     bool log_server_actions;
     bool pause_server_if_no_clients;
+    bool io_thread;
+    bool packet_compression;
 };
 
 struct NotificationConfiguration
@@ -14,36 +14,31 @@
 #include "File.h"
 #include "FileScanner.h"
 #include "FileStream.hpp"
-#include "JobPool.hpp"
+#include "JobPool.h"
 #include "Path.hpp"
 
 #include <chrono>
 #include <list>
 #include <string>
 #include <tuple>
+#include <unordered_map>
 #include <vector>
 
 template<typename TItem> class FileIndex
 {
 private:
-    struct DirectoryStats
+    /**
+     * A file found by the scan, together with the item created from it.
+     */
+    struct IndexedFile
     {
-        uint32_t TotalFiles = 0;
-        uint64_t TotalFileSize = 0;
-        uint32_t FileDateModifiedChecksum = 0;
-        uint32_t PathChecksum = 0;
-    };
-
-    struct ScanResult
-    {
-        DirectoryStats const Stats;
-        std::vector<std::string> const Files;
-
-        ScanResult(DirectoryStats stats, std::vector<std::string> files)
-            : Stats(stats)
-            , Files(files)
-        {
-        }
+        std::string Path;
+        uint64_t Size = 0;
+        uint64_t LastModified = 0;
+        // 0 if the file could not be read
+        uint64_t ContentHash = 0;
+        bool HasItem = false;
+        TItem Item{};
     };
 
     struct FileIndexHeader
@@ -53,12 +48,11 @@ private:
         uint8_t VersionA = 0;
         uint8_t VersionB = 0;
         uint16_t LanguageId = 0;
-        DirectoryStats Stats;
-        uint32_t NumItems = 0;
+        uint32_t NumFiles = 0;
     };
 
     // Index file format version which when incremented forces a rebuild
-    static constexpr uint8_t FILE_INDEX_VERSION = 4;
+    static constexpr uint8_t FILE_INDEX_VERSION = 6;
 
     std::string const _name;
     uint32_t const _magicNumber;
@@ -94,32 +88,31 @@ public:
     virtual ~FileIndex() = default;
 
     /**
-     * Queries and directories and loads the index header. If the index is up to date,
-     * the items are loaded from the index and returned, otherwise the index is rebuilt.
+     * Queries the directories and loads the index. Items of files that have not changed since the index was written
+     * are taken from the index, only new and changed files are loaded again.
      */
     std::vector<TItem> LoadOrBuild(int32_t language) const
     {
-        std::vector<TItem> items;
-        auto scanResult = Scan();
-        auto readIndexResult = ReadIndexFile(language, scanResult.Stats);
+        auto files = Scan();
+        auto readIndexResult = ReadIndexFile(language);
         if (std::get<0>(readIndexResult))
         {
             // Index was loaded
-            items = std::get<1>(readIndexResult);
+            Update(language, files, std::get<1>(readIndexResult));
         }
         else
         {
             // Index was not loaded
-            items = Build(language, scanResult);
+            Build(language, files);
         }
-        return items;
+        return GetItems(files);
     }
 
     std::vector<TItem> Rebuild(int32_t language) const
     {
-        auto scanResult = Scan();
-        auto items = Build(language, scanResult);
-        return items;
+        auto files = Scan();
+        Build(language, files);
+        return GetItems(files);
     }
 
 protected:
@@ -139,11 +132,18 @@ protected:
      */
     virtual TItem Deserialise(IStream* stream) const abstract;
 
+    /**
+     * Called for the item of a file whose modification date has changed without its contents changing, as the item is
+     * kept rather than created again.
+     */
+    virtual void UpdateLastModified([[maybe_unused]] TItem& item, [[maybe_unused]] uint64_t lastModified) const
+    {
+    }
+
 private:
-    ScanResult Scan() const
+    std::vector<IndexedFile> Scan() const
     {
-        DirectoryStats stats{};
-        std::vector<std::string> files;
+        std::vector<IndexedFile> files;
         for (const auto& directory : SearchPaths)
         {
             auto absoluteDirectory = Path::GetAbsolute(directory);
@@ -154,62 +154,56 @@ private:
             while (scanner->Next())
             {
                 auto fileInfo = scanner->GetFileInfo();
-                auto path = std::string(scanner->GetPath());
 
-                files.push_back(path);
-
-                stats.TotalFiles++;
-                stats.TotalFileSize += fileInfo->Size;
-                stats.FileDateModifiedChecksum ^= (uint32_t)(fileInfo->LastModified >> 32)
-                    ^ (uint32_t)(fileInfo->LastModified & 0xFFFFFFFF);
-                stats.FileDateModifiedChecksum = ror32(stats.FileDateModifiedChecksum, 5);
-                stats.PathChecksum += GetPathChecksum(path);
+                IndexedFile file;
+                file.Path = std::string(scanner->GetPath());
+                file.Size = fileInfo->Size;
+                file.LastModified = fileInfo->LastModified;
+                files.push_back(std::move(file));
             }
             delete scanner;
         }
-        return ScanResult(stats, files);
+        return files;
     }
 
     void BuildRange(
-        int32_t language, const ScanResult& scanResult, size_t rangeStart, size_t rangeEnd, std::vector<TItem>& items,
+        int32_t language, const std::vector<IndexedFile*>& files, size_t rangeStart, size_t rangeEnd,
         std::atomic<size_t>& processed, std::mutex& printLock) const
     {
-        items.reserve(rangeEnd - rangeStart);
         for (size_t i = rangeStart; i < rangeEnd; i++)
         {
-            const auto& filePath = scanResult.Files.at(i);
+            auto& file = *files[i];
 
             if (_log_levels[DIAGNOSTIC_LEVEL_VERBOSE])
             {
                 std::lock_guard<std::mutex> lock(printLock);
-                log_verbose("FileIndex:Indexing '%s'", filePath.c_str());
+                log_verbose("FileIndex:Indexing '%s'", file.Path.c_str());
             }
 
-            auto item = Create(language, filePath);
-            if (std::get<0>(item))
+            auto item = Create(language, file.Path);
+            file.HasItem = std::get<0>(item);
+            file.Item = file.HasItem ? std::get<1>(item) : TItem{};
+            if (file.ContentHash == 0)
             {
-                items.push_back(std::get<1>(item));
+                // Hashed here while the file is still cached, so a later touch of it does not create the item again
+                file.ContentHash = GetContentHash(file.Path);
             }
 
             processed++;
         }
     }
 
-    std::vector<TItem> Build(int32_t language, const ScanResult& scanResult) const
+    /**
+     * Creates the items of the given files, each range of files is indexed by a separate job.
+     */
+    void CreateItems(int32_t language, const std::vector<IndexedFile*>& files) const
     {
-        std::vector<TItem> allItems;
-        Console::WriteLine("Building %s (%zu items)", _name.c_str(), scanResult.Files.size());
-
-        auto startTime = std::chrono::high_resolution_clock::now();
-
-        const size_t totalCount = scanResult.Files.size();
+        const size_t totalCount = files.size();
         if (totalCount > 0)
         {
-            JobPool jobPool;
+            TaskGroup taskGroup;
             std::mutex printLock; // For verbose prints.
 
-            std::list<std::vector<TItem>> containers;
-
             size_t stepSize = 100; // Handpicked, seems to work well with 4/8 cores.
 
             std::atomic<size_t> processed = ATOMIC_VAR_INIT(0);
@@ -226,36 +220,113 @@ private:
                     stepSize = totalCount - rangeStart;
                 }
 
-                auto& items = containers.emplace_back();
-
-                jobPool.AddTask(std::bind(
-                    &FileIndex<TItem>::BuildRange, this, language, std::cref(scanResult), rangeStart, rangeStart + stepSize,
-                    std::ref(items), std::ref(processed), std::ref(printLock)));
+                size_t rangeEnd = rangeStart + stepSize;
+                taskGroup.Run([this, language, &files, rangeStart, rangeEnd, &processed, &printLock]() {
+                    BuildRange(language, files, rangeStart, rangeEnd, processed, printLock);
+                });
 
                 reportProgress();
             }
 
-            jobPool.Join(reportProgress);
+            taskGroup.Wait(reportProgress);
+        }
+    }
 
-            for (auto&& itr : containers)
-            {
-                allItems.insert(allItems.end(), itr.begin(), itr.end());
-            }
+    void Build(int32_t language, std::vector<IndexedFile>& files) const
+    {
+        Console::WriteLine("Building %s (%zu items)", _name.c_str(), files.size());
+
+        auto startTime = std::chrono::high_resolution_clock::now();
+
+        std::vector<IndexedFile*> filesToIndex;
+        filesToIndex.reserve(files.size());
+        for (auto& file : files)
+        {
+            filesToIndex.push_back(&file);
         }
+        CreateItems(language, filesToIndex);
 
-        WriteIndexFile(language, scanResult.Stats, allItems);
+        WriteIndexFile(language, files);
 
         auto endTime = std::chrono::high_resolution_clock::now();
         auto duration = (std::chrono::duration<float>)(endTime - startTime);
         Console::WriteLine("Finished building %s in %.2f seconds.", _name.c_str(), duration.count());
+    }
+
+    /**
+     * Takes the items of unchanged files from the loaded index and only creates the items of new and changed files.
+     * Files whose size and modification date match the index are assumed to be unchanged, files with only a different
+     * modification date are compared by their content hash, which is taken when the item is created. Files no longer
+     * found are dropped from the index.
+     */
+    void Update(
+        int32_t language, std::vector<IndexedFile>& files, std::unordered_map<std::string, IndexedFile>& indexedFiles) const
+    {
+        std::vector<IndexedFile*> changedFiles;
+        size_t numTouchedFiles = 0;
+        for (auto& file : files)
+        {
+            auto it = indexedFiles.find(file.Path);
+            if (it != indexedFiles.end())
+            {
+                auto indexedFile = std::move(it->second);
+                indexedFiles.erase(it);
+                if (indexedFile.Size == file.Size && indexedFile.LastModified == file.LastModified)
+                {
+                    file = std::move(indexedFile);
+                    continue;
+                }
+                if (indexedFile.Size == file.Size)
+                {
+                    file.ContentHash = GetContentHash(file.Path);
+                }
+                if (file.ContentHash != 0 && file.ContentHash == indexedFile.ContentHash)
+                {
+                    // The file has been touched without being changed
+                    indexedFile.LastModified = file.LastModified;
+                    if (indexedFile.HasItem)
+                    {
+                        UpdateLastModified(indexedFile.Item, file.LastModified);
+                    }
+                    file = std::move(indexedFile);
+                    numTouchedFiles++;
+                    continue;
+                }
+            }
+            changedFiles.push_back(&file);
+        }
+
+        // Whatever is left in the index has been deleted or moved
+        size_t numRemovedFiles = indexedFiles.size();
+        if (changedFiles.empty() && numTouchedFiles == 0 && numRemovedFiles == 0)
+        {
+            return;
+        }
 
-        return allItems;
+        Console::WriteLine(
+            "Updating %s (%zu new or changed, %zu removed)", _name.c_str(), changedFiles.size(), numRemovedFiles);
+        CreateItems(language, changedFiles);
+        WriteIndexFile(language, files);
     }
 
-    std::tuple<bool, std::vector<TItem>> ReadIndexFile(int32_t language, const DirectoryStats& stats) const
+    static std::vector<TItem> GetItems(const std::vector<IndexedFile>& files)
     {
-        bool loadedItems = false;
         std::vector<TItem> items;
+        items.reserve(files.size());
+        for (const auto& file : files)
+        {
+            if (file.HasItem)
+            {
+                items.push_back(file.Item);
+            }
+        }
+        return items;
+    }
+
+    std::tuple<bool, std::unordered_map<std::string, IndexedFile>> ReadIndexFile(int32_t language) const
+    {
+        bool loadedFiles = false;
+        std::unordered_map<std::string, IndexedFile> files;
         if (File::Exists(_indexPath))
         {
             try
@@ -263,22 +334,28 @@ private:
                 log_verbose("FileIndex:Loading index: '%s'", _indexPath.c_str());
                 auto fs = FileStream(_indexPath, FILE_MODE_OPEN);
 
-                // Read header, check if we need to re-scan
+                // Read header, check if the index is still compatible
                 auto header = fs.ReadValue<FileIndexHeader>();
                 if (header.HeaderSize == sizeof(FileIndexHeader) && header.MagicNumber == _magicNumber
-                    && header.VersionA == FILE_INDEX_VERSION && header.VersionB == _version && header.LanguageId == language
-                    && header.Stats.TotalFiles == stats.TotalFiles && header.Stats.TotalFileSize == stats.TotalFileSize
-                    && header.Stats.FileDateModifiedChecksum == stats.FileDateModifiedChecksum
-                    && header.Stats.PathChecksum == stats.PathChecksum)
+                    && header.VersionA == FILE_INDEX_VERSION && header.VersionB == _version && header.LanguageId == language)
                 {
-                    items.reserve(header.NumItems);
-                    // Directory is the same, just read the saved items
-                    for (uint32_t i = 0; i < header.NumItems; i++)
+                    files.reserve(header.NumFiles);
+                    for (uint32_t i = 0; i < header.NumFiles; i++)
                     {
-                        auto item = Deserialise(&fs);
-                        items.push_back(item);
+                        IndexedFile file;
+                        file.Path = fs.ReadStdString();
+                        file.Size = fs.ReadValue<uint64_t>();
+                        file.LastModified = fs.ReadValue<uint64_t>();
+                        file.ContentHash = fs.ReadValue<uint64_t>();
+                        file.HasItem = fs.ReadValue<uint8_t>() != 0;
+                        if (file.HasItem)
+                        {
+                            file.Item = Deserialise(&fs);
+                        }
+                        auto path = file.Path;
+                        files.emplace(std::move(path), std::move(file));
                     }
-                    loadedItems = true;
+                    loadedFiles = true;
                 }
                 else
                 {
@@ -289,12 +366,13 @@ private:
             {
                 Console::Error::WriteLine("Unable to load index: '%s'.", _indexPath.c_str());
                 Console::Error::WriteLine("%s", e.what());
+                files.clear();
             }
         }
-        return std::make_tuple(loadedItems, items);
+        return std::make_tuple(loadedFiles, std::move(files));
     }
 
-    void WriteIndexFile(int32_t language, const DirectoryStats& stats, const std::vector<TItem>& items) const
+    void WriteIndexFile(int32_t language, const std::vector<IndexedFile>& files) const
     {
         try
         {
@@ -308,14 +386,21 @@ private:
             header.VersionA = FILE_INDEX_VERSION;
             header.VersionB = _version;
             header.LanguageId = language;
-            header.Stats = stats;
-            header.NumItems = (uint32_t)items.size();
+            header.NumFiles = (uint32_t)files.size();
             fs.WriteValue(header);
 
-            // Write items
-            for (const auto& item : items)
+            // Write files and their items
+            for (const auto& file : files)
             {
-                Serialise(&fs, item);
+                fs.WriteString(file.Path);
+                fs.WriteValue(file.Size);
+                fs.WriteValue(file.LastModified);
+                fs.WriteValue(file.ContentHash);
+                fs.WriteValue<uint8_t>(file.HasItem ? 1 : 0);
+                if (file.HasItem)
+                {
+                    Serialise(&fs, file.Item);
+                }
             }
         }
         catch (const std::exception& e)
@@ -325,18 +410,25 @@ private:
         }
     }
 
-    static uint32_t GetPathChecksum(const std::string& path)
+    /**
+     * FNV-1a hash of the contents of a file, 0 if it can not be read.
+     */
+    static uint64_t GetContentHash(const std::string& path)
     {
-        uint32_t hash = 0xD8430DED;
-        for (const utf8* ch = path.c_str(); *ch != '\0'; ch++)
+        try
+        {
+            auto data = File::ReadAllBytes(path);
+            uint64_t hash = 0xCBF29CE484222325;
+            for (auto b : data)
+            {
+                hash ^= b;
+                hash *= 0x100000001B3;
+            }
+            return hash;
+        }
+        catch (const std::exception&)
         {
-            hash += (*ch);
-            hash += (hash << 10);
-            hash ^= (hash >> 6);
+            return 0;
         }
-        hash += (hash << 3);
-        hash ^= (hash >> 11);
-        hash += (hash << 15);
-        return hash;
     }
 };
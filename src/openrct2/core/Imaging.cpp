@@ -162,7 +162,7 @@ namespace Imaging
         }
     }
 
-    static void WritePng(std::ostream& ostream, const Image& image)
+    static void WritePng(std::ostream& ostream, const Image& image, const ImageRowFunc& getRow)
     {
         png_structp png_ptr = nullptr;
         png_colorp png_palette = nullptr;
@@ -225,11 +225,9 @@ namespace Imaging
             png_write_info(png_ptr, info_ptr);
 
             // Write pixels
-            auto pixels = image.Pixels.data();
             for (uint32_t y = 0; y < image.Height; y++)
             {
-                png_write_row(png_ptr, (png_byte*)pixels);
-                pixels += image.Stride;
+                png_write_row(png_ptr, (png_byte*)getRow(y));
             }
 
             png_write_end(png_ptr, nullptr);
@@ -323,11 +321,18 @@ namespace Imaging
     }
 
     void WriteToFile(const std::string_view& path, const Image& image, IMAGE_FORMAT format)
+    {
+        auto pixels = image.Pixels.data();
+        auto stride = image.Stride;
+        WriteToFile(path, image, [pixels, stride](uint32_t y) { return pixels + (size_t)y * stride; }, format);
+    }
+
+    void WriteToFile(const std::string_view& path, const Image& image, const ImageRowFunc& getRow, IMAGE_FORMAT format)
     {
         switch (format)
         {
             case IMAGE_FORMAT::AUTOMATIC:
-                WriteToFile(path, image, GetImageFormatFromPath(path));
+                WriteToFile(path, image, getRow, GetImageFormatFromPath(path));
                 break;
             case IMAGE_FORMAT::PNG:
             {
@@ -337,7 +342,7 @@ namespace Imaging
 #else
                 std::ofstream fs(path.data(), std::ios::binary);
 #endif
-                WritePng(fs, image);
+                WritePng(fs, image, getRow);
                 break;
             }
             default:
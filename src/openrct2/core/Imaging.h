@@ -53,6 +53,10 @@ struct Image
 
 using ImageReaderFunc = std::function<Image(std::istream&, IMAGE_FORMAT)>;
 
+// Gets the pixels of row y of an image that is being written. Rows are requested in order, from top to bottom,
+// and the returned pointer only has to stay valid until the next row is requested.
+using ImageRowFunc = std::function<const uint8_t*(uint32_t y)>;
+
 namespace Imaging
 {
     IMAGE_FORMAT GetImageFormatFromPath(const std::string_view& path);
@@ -60,5 +64,13 @@ namespace Imaging
     Image ReadFromBuffer(const std::vector<uint8_t>& buffer, IMAGE_FORMAT format = IMAGE_FORMAT::AUTOMATIC);
     void WriteToFile(const std::string_view& path, const Image& image, IMAGE_FORMAT format = IMAGE_FORMAT::AUTOMATIC);
 
+    /**
+     * Writes an image whose pixels are produced row by row, so it never has to be held in memory as a whole.
+     * Only the meta data and palette of image are used.
+     */
+    void WriteToFile(
+        const std::string_view& path, const Image& image, const ImageRowFunc& getRow,
+        IMAGE_FORMAT format = IMAGE_FORMAT::AUTOMATIC);
+
     void SetReader(IMAGE_FORMAT format, ImageReaderFunc impl);
 } // namespace Imaging
@@ -0,0 +1,317 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "JobPool.h"
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace JobPool;
+
+/**
+ * Bounded double-ended queue of jobs. The owner pushes and pops at the back, other threads steal from the front.
+ */
+class JobQueue final
+{
+private:
+    std::mutex _mutex;
+    std::vector<Job> _jobs;
+    size_t _head = 0;
+    size_t _tail = 0;
+
+public:
+    explicit JobQueue(size_t capacity)
+        : _jobs(capacity)
+    {
+    }
+
+    bool TryPush(const Job& job)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_tail - _head == _jobs.size())
+            return false;
+
+        _jobs[_tail % _jobs.size()] = job;
+        _tail++;
+        return true;
+    }
+
+    bool TryPop(Job* outJob)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_tail == _head)
+            return false;
+
+        _tail--;
+        *outJob = _jobs[_tail % _jobs.size()];
+        return true;
+    }
+
+    bool TrySteal(Job* outJob)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_tail == _head)
+            return false;
+
+        *outJob = _jobs[_head % _jobs.size()];
+        _head++;
+        return true;
+    }
+
+    /**
+     * Takes the newest job of the given group, wherever it is in the queue.
+     */
+    bool TryTakeFromGroup(const TaskGroup* group, Job* outJob)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        for (size_t i = _tail; i != _head; i--)
+        {
+            if (_jobs[(i - 1) % _jobs.size()].Group == group)
+            {
+                *outJob = _jobs[(i - 1) % _jobs.size()];
+                // Close the gap by moving the newer jobs down
+                for (size_t j = i; j != _tail; j++)
+                {
+                    _jobs[(j - 1) % _jobs.size()] = _jobs[j % _jobs.size()];
+                }
+                _tail--;
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+static constexpr size_t WORKER_QUEUE_CAPACITY = 1024;
+static constexpr size_t SHARED_QUEUE_CAPACITY = 4096;
+
+class Scheduler final
+{
+private:
+    std::vector<std::thread> _threads;
+    std::vector<std::unique_ptr<JobQueue>> _workerQueues;
+    JobQueue _sharedQueue{ SHARED_QUEUE_CAPACITY };
+
+    std::atomic<size_t> _numQueued = { 0 };
+    std::atomic_bool _shouldStop = { false };
+    size_t _numSleeping = 0;
+    std::mutex _sleepMutex;
+    std::condition_variable _sleepCondition;
+
+    static thread_local JobQueue* _localQueue;
+    static thread_local size_t _localIndex;
+
+public:
+    Scheduler()
+    {
+        size_t numWorkers = std::max<size_t>(1, std::thread::hardware_concurrency()) - 1;
+        // Always have at least one worker so jobs make progress while the submitting thread is busy.
+        numWorkers = std::max<size_t>(1, numWorkers);
+        for (size_t i = 0; i < numWorkers; i++)
+        {
+            _workerQueues.push_back(std::make_unique<JobQueue>(WORKER_QUEUE_CAPACITY));
+        }
+        for (size_t i = 0; i < numWorkers; i++)
+        {
+            _threads.emplace_back(&Scheduler::WorkerLoop, this, i);
+        }
+    }
+
+    ~Scheduler()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_sleepMutex);
+            _shouldStop = true;
+        }
+        _sleepCondition.notify_all();
+        for (auto& thread : _threads)
+        {
+            thread.join();
+        }
+    }
+
+    size_t GetNumThreads() const
+    {
+        return _threads.size() + 1;
+    }
+
+    bool TrySubmit(const Job& job)
+    {
+        auto queue = _localQueue != nullptr ? _localQueue : &_sharedQueue;
+        if (!queue->TryPush(job))
+            return false;
+
+        _numQueued++;
+        std::lock_guard<std::mutex> lock(_sleepMutex);
+        if (_numSleeping > 0)
+        {
+            _sleepCondition.notify_one();
+        }
+        return true;
+    }
+
+    bool TryTake(Job* outJob)
+    {
+        bool found = false;
+        if (_localQueue != nullptr)
+        {
+            found = _localQueue->TryPop(outJob);
+        }
+        if (!found)
+        {
+            found = _sharedQueue.TrySteal(outJob);
+        }
+        for (size_t i = 0; !found && i < _workerQueues.size(); i++)
+        {
+            // Start with the worker after this one so that thieves spread out over the queues.
+            auto& victim = _workerQueues[(_localIndex + 1 + i) % _workerQueues.size()];
+            if (victim.get() != _localQueue)
+            {
+                found = victim->TrySteal(outJob);
+            }
+        }
+        if (found)
+        {
+            _numQueued--;
+        }
+        return found;
+    }
+
+    bool TryTakeFromGroup(const TaskGroup* group, Job* outJob)
+    {
+        bool found = false;
+        if (_localQueue != nullptr)
+        {
+            found = _localQueue->TryTakeFromGroup(group, outJob);
+        }
+        if (!found)
+        {
+            found = _sharedQueue.TryTakeFromGroup(group, outJob);
+        }
+        for (size_t i = 0; !found && i < _workerQueues.size(); i++)
+        {
+            auto& queue = _workerQueues[(_localIndex + 1 + i) % _workerQueues.size()];
+            if (queue.get() != _localQueue)
+            {
+                found = queue->TryTakeFromGroup(group, outJob);
+            }
+        }
+        if (found)
+        {
+            _numQueued--;
+        }
+        return found;
+    }
+
+private:
+    void WorkerLoop(size_t index)
+    {
+        _localQueue = _workerQueues[index].get();
+        _localIndex = index;
+        while (!_shouldStop)
+        {
+            if (RunPendingJob())
+                continue;
+
+            std::unique_lock<std::mutex> lock(_sleepMutex);
+            _numSleeping++;
+            _sleepCondition.wait(lock, [this]() { return _shouldStop || _numQueued > 0; });
+            _numSleeping--;
+        }
+    }
+};
+
+thread_local JobQueue* Scheduler::_localQueue = nullptr;
+thread_local size_t Scheduler::_localIndex = 0;
+
+static Scheduler& GetScheduler()
+{
+    static Scheduler scheduler;
+    return scheduler;
+}
+
+size_t JobPool::GetNumThreads()
+{
+    return GetScheduler().GetNumThreads();
+}
+
+void JobPool::Submit(const Job& job)
+{
+    job.Group->_pending.fetch_add(1, std::memory_order_relaxed);
+    if (!GetScheduler().TrySubmit(job))
+    {
+        // The queue is full, so run the job straight away rather than allocating more room.
+        Job localJob = job;
+        TaskGroup::RunJob(localJob);
+    }
+}
+
+bool JobPool::RunPendingJob(const TaskGroup* group)
+{
+    Job job;
+    bool found = group != nullptr ? GetScheduler().TryTakeFromGroup(group, &job) : GetScheduler().TryTake(&job);
+    if (!found)
+        return false;
+
+    TaskGroup::RunJob(job);
+    return true;
+}
+
+void TaskGroup::RunJob(Job& job)
+{
+    std::exception_ptr exception;
+    try
+    {
+        job.Invoke(job.Storage);
+    }
+    catch (...)
+    {
+        exception = std::current_exception();
+    }
+    job.Group->OnJobFinished(exception);
+}
+
+void TaskGroup::WaitForJobs(const std::function<void()>& reportFn)
+{
+    size_t lastPending = _pending.load(std::memory_order_acquire);
+    while (lastPending != 0)
+    {
+        // Only jobs of this group are run, so waiting for a few short jobs never gets stuck behind a long unrelated one.
+        if (!RunPendingJob(this))
+        {
+            // The remaining jobs of this group are running on other threads, sleep until one of them finishes.
+            std::unique_lock<std::mutex> lock(_mutex);
+            _finishedCondition.wait(
+                lock, [this, lastPending]() { return _pending.load(std::memory_order_acquire) != lastPending; });
+        }
+
+        size_t pending = _pending.load(std::memory_order_acquire);
+        if (pending != lastPending && reportFn)
+        {
+            reportFn();
+        }
+        lastPending = pending;
+    }
+
+    // The last job may still be notifying, wait for it to let go of the group before the caller can destroy it.
+    std::lock_guard<std::mutex> lock(_mutex);
+}
+
+void TaskGroup::OnJobFinished(std::exception_ptr exception)
+{
+    // The lock is held until the notification is sent, the waiting thread may destroy the group straight after.
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (exception != nullptr && _exception == nullptr)
+    {
+        _exception = exception;
+    }
+    _pending.fetch_sub(1, std::memory_order_acq_rel);
+    _finishedCondition.notify_all();
+}
@@ -0,0 +1,209 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <type_traits>
+
+class TaskGroup;
+
+/**
+ * Process-wide work-stealing scheduler. Worker threads are started on first use, each owning a
+ * bounded deque of jobs; a worker takes its newest job first and steals the oldest job of
+ * another worker when it runs out. Threads that are not workers submit jobs to a shared queue.
+ *
+ * Jobs are stored by value inside the queues, so submitting a job never allocates. A thread that
+ * waits for a task group runs pending jobs of that group in the meantime, so task groups can be
+ * nested. Jobs of other groups are left to the workers.
+ */
+namespace JobPool
+{
+    // The largest callable (in bytes) that can be given to TaskGroup::Run.
+    constexpr size_t MaxJobSize = 64;
+
+    struct Job
+    {
+        void (*Invoke)(void* storage);
+        TaskGroup* Group;
+        alignas(std::max_align_t) uint8_t Storage[MaxJobSize];
+    };
+
+    /**
+     * Gets the number of threads that run jobs, including the thread that waits for them.
+     */
+    size_t GetNumThreads();
+
+    void Submit(const Job& job);
+
+    /**
+     * Runs a single pending job of the given group, or of any group if it is null, on the calling thread.
+     * Returns false if there were none.
+     */
+    bool RunPendingJob(const TaskGroup* group = nullptr);
+
+    /**
+     * Calls fn(i) for every i in [begin, end), splitting the range into chunks of grainSize
+     * indices that are run in parallel. Returns once all of them have been called.
+     * A grainSize of 0 picks a size that gives each thread a few chunks to balance out.
+     */
+    template<typename TFn> void ParallelFor(size_t begin, size_t end, const TFn& fn, size_t grainSize = 0);
+} // namespace JobPool
+
+/**
+ * A set of jobs that can be waited for independently of any other jobs in the pool.
+ * The group must outlive its jobs, the destructor waits for any that are still running.
+ */
+class TaskGroup final
+{
+    friend void JobPool::Submit(const JobPool::Job& job);
+    friend bool JobPool::RunPendingJob(const TaskGroup* group);
+
+private:
+    std::atomic<size_t> _pending = { 0 };
+    // Guards _exception and is held while a job finishes, so the waiting thread can sleep on _finishedCondition.
+    std::mutex _mutex;
+    std::condition_variable _finishedCondition;
+    std::exception_ptr _exception;
+
+public:
+    TaskGroup() = default;
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+    ~TaskGroup()
+    {
+        WaitForJobs(nullptr);
+    }
+
+    /**
+     * Queues fn() to be run on the pool. The callable is copied into the job itself, so it must be
+     * trivially copyable and no larger than JobPool::MaxJobSize, i.e. capture by reference or pointer.
+     */
+    template<typename TFn> void Run(const TFn& fn)
+    {
+        static_assert(std::is_trivially_copyable<TFn>::value, "Jobs must be trivially copyable.");
+        static_assert(sizeof(TFn) <= JobPool::MaxJobSize, "Job is too large, capture by reference instead.");
+        static_assert(alignof(TFn) <= alignof(std::max_align_t), "Job is over-aligned.");
+
+        JobPool::Job job;
+        job.Invoke = [](void* storage) { (*static_cast<TFn*>(storage))(); };
+        job.Group = this;
+        std::memcpy(job.Storage, &fn, sizeof(TFn));
+        JobPool::Submit(job);
+    }
+
+    bool IsDone() const
+    {
+        return _pending.load(std::memory_order_acquire) == 0;
+    }
+
+    /**
+     * Waits until every job of this group has run, running its pending jobs on this thread meanwhile and
+     * sleeping while the rest run on other threads.
+     * reportFn is called every time the wait makes progress. Rethrows the first exception a job threw.
+     */
+    void Wait(const std::function<void()>& reportFn = nullptr)
+    {
+        WaitForJobs(reportFn);
+
+        std::exception_ptr exception;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            std::swap(exception, _exception);
+        }
+        if (exception != nullptr)
+        {
+            std::rethrow_exception(exception);
+        }
+    }
+
+private:
+    static void RunJob(JobPool::Job& job);
+    void WaitForJobs(const std::function<void()>& reportFn);
+    void OnJobFinished(std::exception_ptr exception);
+};
+
+/**
+ * The result of a single job run on the pool. Like the task group it wraps, it must outlive its job.
+ */
+template<typename T> class JobFuture final
+{
+private:
+    TaskGroup _group;
+    T _result{};
+
+public:
+    /**
+     * Queues fn() to be run on the pool, its return value is kept until Get is called.
+     * The same restrictions as for TaskGroup::Run apply to fn.
+     */
+    template<typename TFn> void Run(const TFn& fn)
+    {
+        T* result = &_result;
+        _group.Run([result, fn]() { *result = fn(); });
+    }
+
+    bool IsReady() const
+    {
+        return _group.IsDone();
+    }
+
+    /**
+     * Waits for the job, running it on this thread if no other thread has started it yet.
+     * Rethrows the exception the job threw.
+     */
+    T& Get()
+    {
+        _group.Wait();
+        return _result;
+    }
+};
+
+template<typename TFn> void JobPool::ParallelFor(size_t begin, size_t end, const TFn& fn, size_t grainSize)
+{
+    if (begin >= end)
+        return;
+
+    size_t count = end - begin;
+    if (grainSize == 0)
+    {
+        grainSize = std::max<size_t>(1, count / (GetNumThreads() * 4));
+    }
+    if (count <= grainSize)
+    {
+        for (size_t i = begin; i < end; i++)
+        {
+            fn(i);
+        }
+        return;
+    }
+
+    const TFn* pFn = &fn;
+    TaskGroup group;
+    for (size_t chunkBegin = begin; chunkBegin < end; chunkBegin += std::min(grainSize, end - chunkBegin))
+    {
+        size_t chunkEnd = chunkBegin + std::min(grainSize, end - chunkBegin);
+        group.Run([pFn, chunkBegin, chunkEnd]() {
+            for (size_t i = chunkBegin; i < chunkEnd; i++)
+            {
+                (*pFn)(i);
+            }
+        });
+    }
+    group.Wait();
+}
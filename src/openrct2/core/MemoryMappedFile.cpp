@@ -0,0 +1,119 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#ifdef _WIN32
+#    define WIN32_LEAN_AND_MEAN
+#    include <windows.h>
+#else
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#endif
+
+#include "../Diagnostic.h"
+#include "File.h"
+#include "MemoryMappedFile.h"
+#include "String.hpp"
+
+MemoryMappedFile::MemoryMappedFile(const std::string& path)
+{
+    if (!Map(path))
+    {
+        log_verbose("Unable to map '%s', reading it instead.", path.c_str());
+        _fallbackData = File::ReadAllBytes(path);
+        _data = _fallbackData.data();
+        _length = _fallbackData.size();
+    }
+}
+
+MemoryMappedFile::~MemoryMappedFile()
+{
+    if (_mapped)
+    {
+#ifdef _WIN32
+        UnmapViewOfFile(_data);
+#else
+        munmap((void*)_data, _length);
+#endif
+    }
+}
+
+#ifdef _WIN32
+
+bool MemoryMappedFile::Map(const std::string& path)
+{
+    auto pathW = String::ToUtf16(path);
+    HANDLE file = CreateFileW(
+        pathW.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0 || (uint64_t)fileSize.QuadPart > SIZE_MAX)
+    {
+        CloseHandle(file);
+        return false;
+    }
+
+    // The view keeps the mapping and the file open, so the handles are not needed once it has been created.
+    HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (mapping == nullptr)
+    {
+        return false;
+    }
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+    if (view == nullptr)
+    {
+        return false;
+    }
+
+    _data = (const uint8_t*)view;
+    _length = (size_t)fileSize.QuadPart;
+    _mapped = true;
+    return true;
+}
+
+#else
+
+bool MemoryMappedFile::Map(const std::string& path)
+{
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd == -1)
+    {
+        return false;
+    }
+
+    struct stat statInfo;
+    if (fstat(fd, &statInfo) != 0 || statInfo.st_size <= 0 || (uint64_t)statInfo.st_size > SIZE_MAX)
+    {
+        close(fd);
+        return false;
+    }
+
+    // The mapping keeps the file open, so the descriptor is not needed once it has been created.
+    size_t length = (size_t)statInfo.st_size;
+    void* data = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED)
+    {
+        return false;
+    }
+
+    _data = (const uint8_t*)data;
+    _length = length;
+    _mapped = true;
+    return true;
+}
+
+#endif
@@ -0,0 +1,52 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "../common.h"
+
+#include <string>
+#include <vector>
+
+/**
+ * A file mapped read-only into memory. Pages are only read from disk once they are touched and are shared with every
+ * other process that maps the same file. If the file can not be mapped, it is read into memory instead.
+ */
+class MemoryMappedFile final
+{
+private:
+    const uint8_t* _data = nullptr;
+    size_t _length = 0;
+    bool _mapped = false;
+    std::vector<uint8_t> _fallbackData;
+
+public:
+    explicit MemoryMappedFile(const std::string& path);
+    MemoryMappedFile(const MemoryMappedFile&) = delete;
+    MemoryMappedFile& operator=(const MemoryMappedFile&) = delete;
+    ~MemoryMappedFile();
+
+    const uint8_t* GetData() const
+    {
+        return _data;
+    }
+
+    size_t GetLength() const
+    {
+        return _length;
+    }
+
+    bool IsMapped() const
+    {
+        return _mapped;
+    }
+
+private:
+    bool Map(const std::string& path);
+};
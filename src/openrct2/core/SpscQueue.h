@@ -0,0 +1,76 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <utility>
+
+/**
+ * Unbounded lock-free queue for handing values from one thread to another. Push must only ever be called by one
+ * thread and TryPop by one other thread at a time, neither of them blocks.
+ *
+ * Values are kept in a linked list of nodes. The consumer owns the first node, which has already been popped and
+ * only serves as the link to the next one, so the two threads never touch the same node other than its link.
+ */
+template<typename T> class SpscQueue final
+{
+private:
+    struct Node
+    {
+        std::atomic<Node*> Next = { nullptr };
+        T Value{};
+    };
+
+    // Only used by the consumer.
+    Node* _head;
+    // Only used by the producer.
+    Node* _tail;
+
+public:
+    SpscQueue()
+        : _head(new Node())
+        , _tail(_head)
+    {
+    }
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    ~SpscQueue()
+    {
+        while (_head != nullptr)
+        {
+            Node* next = _head->Next.load(std::memory_order_relaxed);
+            delete _head;
+            _head = next;
+        }
+    }
+
+    void Push(T value)
+    {
+        Node* node = new Node();
+        node->Value = std::move(value);
+        _tail->Next.store(node, std::memory_order_release);
+        _tail = node;
+    }
+
+    bool TryPop(T& value)
+    {
+        Node* next = _head->Next.load(std::memory_order_acquire);
+        if (next == nullptr)
+        {
+            return false;
+        }
+        value = std::move(next->Value);
+        delete _head;
+        _head = next;
+        return true;
+    }
+};
@@ -42,6 +42,140 @@ void mask_avx2(
     }
 }
 
+/**
+ * As palette_load_sse4_1, with each table repeated in both lanes as shuffles do not cross them.
+ */
+static void palette_load_avx2(const uint8_t* palette, __m256i tables[16])
+{
+    for (int32_t i = 0; i < 16; i++)
+    {
+        tables[i] = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)(palette + i * 16)));
+    }
+}
+
+static inline __m256i palette_lookup_avx2(const __m256i tables[16], __m256i indices)
+{
+    const __m256i nibbleMask = _mm256_set1_epi8(0x0F);
+    const __m256i lo = _mm256_and_si256(indices, nibbleMask);
+    const __m256i hi = _mm256_and_si256(_mm256_srli_epi16(indices, 4), nibbleMask);
+    __m256i result = _mm256_setzero_si256();
+    for (int32_t i = 0; i < 16; i++)
+    {
+        const __m256i select = _mm256_cmpeq_epi8(hi, _mm256_set1_epi8((char)i));
+        result = _mm256_blendv_epi8(result, _mm256_shuffle_epi8(tables[i], lo), select);
+    }
+    return result;
+}
+
+void bmp_blit_copy_avx2(
+    int32_t width, int32_t height, const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t srcWrap, int32_t dstWrap)
+{
+    const __m256i zero = {};
+    const int32_t simdWidth = width & ~31;
+    for (int32_t yy = 0; yy < height; yy++)
+    {
+        for (int32_t xx = 0; xx < simdWidth; xx += 32)
+        {
+            const __m256i source = _mm256_lddqu_si256((const __m256i*)(src + xx));
+            const __m256i dest = _mm256_lddqu_si256((const __m256i*)(dst + xx));
+            _mm256_storeu_si256((__m256i*)(dst + xx), _mm256_blendv_epi8(source, dest, _mm256_cmpeq_epi8(source, zero)));
+        }
+        bmp_blit_copy_scalar(width - simdWidth, 1, src + simdWidth, dst + simdWidth, 0, 0);
+        src += width + srcWrap;
+        dst += width + dstWrap;
+    }
+}
+
+void bmp_blit_remap_avx2(
+    int32_t width, int32_t height, const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, const uint8_t* RESTRICT palette,
+    int32_t srcWrap, int32_t dstWrap)
+{
+    __m256i tables[16];
+    palette_load_avx2(palette, tables);
+    const __m256i zero = {};
+    const int32_t simdWidth = width & ~31;
+    for (int32_t yy = 0; yy < height; yy++)
+    {
+        for (int32_t xx = 0; xx < simdWidth; xx += 32)
+        {
+            const __m256i source = palette_lookup_avx2(tables, _mm256_lddqu_si256((const __m256i*)(src + xx)));
+            const __m256i dest = _mm256_lddqu_si256((const __m256i*)(dst + xx));
+            _mm256_storeu_si256((__m256i*)(dst + xx), _mm256_blendv_epi8(source, dest, _mm256_cmpeq_epi8(source, zero)));
+        }
+        bmp_blit_remap_scalar(width - simdWidth, 1, src + simdWidth, dst + simdWidth, palette, 0, 0);
+        src += width + srcWrap;
+        dst += width + dstWrap;
+    }
+}
+
+void bmp_blit_glass_avx2(
+    int32_t width, int32_t height, const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, const uint8_t* RESTRICT palette,
+    int32_t srcWrap, int32_t dstWrap)
+{
+    __m256i tables[16];
+    palette_load_avx2(palette, tables);
+    const __m256i zero = {};
+    const int32_t simdWidth = width & ~31;
+    for (int32_t yy = 0; yy < height; yy++)
+    {
+        for (int32_t xx = 0; xx < simdWidth; xx += 32)
+        {
+            const __m256i source = _mm256_lddqu_si256((const __m256i*)(src + xx));
+            const __m256i dest = _mm256_lddqu_si256((const __m256i*)(dst + xx));
+            const __m256i remapped = palette_lookup_avx2(tables, dest);
+            _mm256_storeu_si256(
+                (__m256i*)(dst + xx), _mm256_blendv_epi8(remapped, dest, _mm256_cmpeq_epi8(source, zero)));
+        }
+        bmp_blit_glass_scalar(width - simdWidth, 1, src + simdWidth, dst + simdWidth, palette, 0, 0);
+        src += width + srcWrap;
+        dst += width + dstWrap;
+    }
+}
+
+void palette_to_rgba_avx2(const uint8_t* RESTRICT src, uint32_t* RESTRICT dst, size_t count, const uint32_t* RESTRICT palette)
+{
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        const __m256i indices = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)(src + i)));
+        _mm256_storeu_si256((__m256i*)(dst + i), _mm256_i32gather_epi32((const int*)palette, indices, 4));
+    }
+    palette_to_rgba_scalar(src + i, dst + i, count - i, palette);
+}
+
+void palette_to_rgba_lit_avx2(
+    const uint8_t* RESTRICT src, const uint8_t* RESTRICT light, uint32_t* RESTRICT dst, size_t count,
+    const uint32_t* RESTRICT palette, const uint32_t* RESTRICT lightPalette)
+{
+    const __m256i zero = {};
+    const __m256i six = _mm256_set1_epi16(6);
+    // Copies the intensity of the first two and the last two pixels of each lane into the 16-bit channels of each pixel.
+    const __m256i spreadLo = _mm256_setr_epi8(
+        0, 1, 0, 1, 0, 1, 0, 1, 4, 5, 4, 5, 4, 5, 4, 5, 0, 1, 0, 1, 0, 1, 0, 1, 4, 5, 4, 5, 4, 5, 4, 5);
+    const __m256i spreadHi = _mm256_setr_epi8(
+        8, 9, 8, 9, 8, 9, 8, 9, 12, 13, 12, 13, 12, 13, 12, 13, 8, 9, 8, 9, 8, 9, 8, 9, 12, 13, 12, 13, 12, 13, 12, 13);
+
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        const __m256i indices = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)(src + i)));
+        const __m256i dark = _mm256_i32gather_epi32((const int*)palette, indices, 4);
+        const __m256i lit = _mm256_i32gather_epi32((const int*)lightPalette, indices, 4);
+        const __m256i intensity = _mm256_mullo_epi16(
+            _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)(light + i))), six);
+
+        // See palette_to_rgba_lit_sse4_1, unpacking and packing stay within each 128-bit lane so the order is kept.
+        const __m256i mixLo = _mm256_add_epi16(
+            _mm256_unpacklo_epi8(dark, zero),
+            _mm256_mulhi_epu16(_mm256_unpacklo_epi8(zero, lit), _mm256_shuffle_epi8(intensity, spreadLo)));
+        const __m256i mixHi = _mm256_add_epi16(
+            _mm256_unpackhi_epi8(dark, zero),
+            _mm256_mulhi_epu16(_mm256_unpackhi_epi8(zero, lit), _mm256_shuffle_epi8(intensity, spreadHi)));
+        _mm256_storeu_si256((__m256i*)(dst + i), _mm256_packus_epi16(mixLo, mixHi));
+    }
+    palette_to_rgba_lit_scalar(src + i, light + i, dst + i, count - i, palette, lightPalette);
+}
+
 #else
 
 #    ifdef OPENRCT2_X86
@@ -55,4 +189,36 @@ void mask_avx2(
     openrct2_assert(false, "AVX2 function called on a CPU that doesn't support AVX2");
 }
 
+void palette_to_rgba_avx2(const uint8_t* RESTRICT src, uint32_t* RESTRICT dst, size_t count, const uint32_t* RESTRICT palette)
+{
+    openrct2_assert(false, "AVX2 function called on a CPU that doesn't support AVX2");
+}
+
+void palette_to_rgba_lit_avx2(
+    const uint8_t* RESTRICT src, const uint8_t* RESTRICT light, uint32_t* RESTRICT dst, size_t count,
+    const uint32_t* RESTRICT palette, const uint32_t* RESTRICT lightPalette)
+{
+    openrct2_assert(false, "AVX2 function called on a CPU that doesn't support AVX2");
+}
+
+void bmp_blit_copy_avx2(
+    int32_t width, int32_t height, const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t srcWrap, int32_t dstWrap)
+{
+    openrct2_assert(false, "AVX2 function called on a CPU that doesn't support AVX2");
+}
+
+void bmp_blit_remap_avx2(
+    int32_t width, int32_t height, const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, const uint8_t* RESTRICT palette,
+    int32_t srcWrap, int32_t dstWrap)
+{
+    openrct2_assert(false, "AVX2 function called on a CPU that doesn't support AVX2");
+}
+
+void bmp_blit_glass_avx2(
+    int32_t width, int32_t height, const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, const uint8_t* RESTRICT palette,
+    int32_t srcWrap, int32_t dstWrap)
+{
+    openrct2_assert(false, "AVX2 function called on a CPU that doesn't support AVX2");
+}
+
 #endif // __AVX2__
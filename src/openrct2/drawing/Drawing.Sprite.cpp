@@ -12,6 +12,8 @@
 #include "../PlatformEnvironment.h"
 #include "../config/Config.h"
 #include "../core/FileStream.hpp"
+#include "../core/MemoryMappedFile.h"
+#include "../core/MemoryStream.h"
 #include "../core/Path.hpp"
 #include "../platform/platform.h"
 #include "../sprites.h"
@@ -40,7 +42,8 @@ struct rct_gx
 {
     rct_g1_header header;
     std::vector<rct_g1_element> elements;
-    void* data;
+    // Sprite data is read straight from the mapped file, so it is shared between processes and only paged in when drawn.
+    std::unique_ptr<MemoryMappedFile> file;
 };
 
 // clang-format off
@@ -193,6 +196,64 @@ void mask_scalar(
     }
 }
 
+void bmp_blit_copy_scalar(
+    int32_t width, int32_t height, const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t srcWrap, int32_t dstWrap)
+{
+    for (int32_t yy = 0; yy < height; yy++)
+    {
+        for (int32_t xx = 0; xx < width; xx++)
+        {
+            uint8_t pixel = *src++;
+            if (pixel)
+            {
+                *dst = pixel;
+            }
+            dst++;
+        }
+        src += srcWrap;
+        dst += dstWrap;
+    }
+}
+
+void bmp_blit_remap_scalar(
+    int32_t width, int32_t height, const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, const uint8_t* RESTRICT palette,
+    int32_t srcWrap, int32_t dstWrap)
+{
+    for (int32_t yy = 0; yy < height; yy++)
+    {
+        for (int32_t xx = 0; xx < width; xx++)
+        {
+            uint8_t pixel = palette[*src++];
+            if (pixel)
+            {
+                *dst = pixel;
+            }
+            dst++;
+        }
+        src += srcWrap;
+        dst += dstWrap;
+    }
+}
+
+void bmp_blit_glass_scalar(
+    int32_t width, int32_t height, const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, const uint8_t* RESTRICT palette,
+    int32_t srcWrap, int32_t dstWrap)
+{
+    for (int32_t yy = 0; yy < height; yy++)
+    {
+        for (int32_t xx = 0; xx < width; xx++)
+        {
+            if (*src++)
+            {
+                *dst = palette[*dst];
+            }
+            dst++;
+        }
+        src += srcWrap;
+        dst += dstWrap;
+    }
+}
+
 static std::string gfx_get_csg_header_path()
 {
     auto path = Path::ResolveCasing(Path::Combine(gConfigGeneral.rct1_path, "Data", "csg1i.dat"));
@@ -217,6 +278,19 @@ static std::string gfx_get_csg_data_path()
     return path;
 }
 
+/**
+ * Returns the sprite data of a mapped graphics file, which starts at the given offset.
+ */
+static uint8_t* gfx_get_gx_data(const MemoryMappedFile& file, uint64_t offset, uint64_t size)
+{
+    if (offset + size > file.GetLength())
+    {
+        throw IOException("Graphics data is truncated.");
+    }
+    // The data is never written to, offsets are only non-const for the sprites that are generated at runtime.
+    return const_cast<uint8_t*>(file.GetData() + offset);
+}
+
 static rct_gx _g1 = {};
 static rct_gx _g2 = {};
 static rct_gx _csg = {};
@@ -235,7 +309,8 @@ bool gfx_load_g1(const IPlatformEnvironment& env)
     try
     {
         auto path = Path::Combine(env.GetDirectoryPath(DIRBASE::RCT2, DIRID::DATA), "g1.dat");
-        auto fs = FileStream(path, FILE_MODE_OPEN);
+        _g1.file = std::make_unique<MemoryMappedFile>(path);
+        auto fs = MemoryStream(_g1.file->GetData(), _g1.file->GetLength());
         _g1.header = fs.ReadValue<rct_g1_header>();
 
         log_verbose("g1.dat, number of entries: %u", _g1.header.num_entries);
@@ -251,18 +326,17 @@ bool gfx_load_g1(const IPlatformEnvironment& env)
         read_and_convert_gxdat(&fs, _g1.header.num_entries, is_rctc, _g1.elements.data());
         gTinyFontAntiAliased = is_rctc;
 
-        // Read element data
-        _g1.data = fs.ReadArray<uint8_t>(_g1.header.total_size);
-
         // Fix entry data offsets
+        auto data = gfx_get_gx_data(*_g1.file, fs.GetPosition(), _g1.header.total_size);
         for (uint32_t i = 0; i < _g1.header.num_entries; i++)
         {
-            _g1.elements[i].offset += (uintptr_t)_g1.data;
+            _g1.elements[i].offset += (uintptr_t)data;
         }
         return true;
     }
     catch (const std::exception&)
     {
+        _g1.file = nullptr;
         _g1.elements.clear();
         _g1.elements.shrink_to_fit();
 
@@ -278,21 +352,21 @@ bool gfx_load_g1(const IPlatformEnvironment& env)
 
 void gfx_unload_g1()
 {
-    SafeFree(_g1.data);
+    _g1.file = nullptr;
     _g1.elements.clear();
     _g1.elements.shrink_to_fit();
 }
 
 void gfx_unload_g2()
 {
-    SafeFree(_g2.data);
+    _g2.file = nullptr;
     _g2.elements.clear();
     _g2.elements.shrink_to_fit();
 }
 
 void gfx_unload_csg()
 {
-    SafeFree(_csg.data);
+    _csg.file = nullptr;
     _csg.elements.clear();
     _csg.elements.shrink_to_fit();
 }
@@ -307,25 +381,25 @@ bool gfx_load_g2()
     safe_strcat_path(path, "g2.dat", MAX_PATH);
     try
     {
-        auto fs = FileStream(path, FILE_MODE_OPEN);
+        _g2.file = std::make_unique<MemoryMappedFile>(path);
+        auto fs = MemoryStream(_g2.file->GetData(), _g2.file->GetLength());
         _g2.header = fs.ReadValue<rct_g1_header>();
 
         // Read element headers
         _g2.elements.resize(_g2.header.num_entries);
         read_and_convert_gxdat(&fs, _g2.header.num_entries, false, _g2.elements.data());
 
-        // Read element data
-        _g2.data = fs.ReadArray<uint8_t>(_g2.header.total_size);
-
         // Fix entry data offsets
+        auto data = gfx_get_gx_data(*_g2.file, fs.GetPosition(), _g2.header.total_size);
         for (uint32_t i = 0; i < _g2.header.num_entries; i++)
         {
-            _g2.elements[i].offset += (uintptr_t)_g2.data;
+            _g2.elements[i].offset += (uintptr_t)data;
         }
         return true;
     }
     catch (const std::exception&)
     {
+        _g2.file = nullptr;
         _g2.elements.clear();
         _g2.elements.shrink_to_fit();
 
@@ -354,9 +428,9 @@ bool gfx_load_csg()
     try
     {
         auto fileHeader = FileStream(pathHeaderPath, FILE_MODE_OPEN);
-        auto fileData = FileStream(pathDataPath, FILE_MODE_OPEN);
+        _csg.file = std::make_unique<MemoryMappedFile>(pathDataPath);
         size_t fileHeaderSize = fileHeader.GetLength();
-        size_t fileDataSize = fileData.GetLength();
+        size_t fileDataSize = _csg.file->GetLength();
 
         _csg.header.num_entries = (uint32_t)(fileHeaderSize / sizeof(rct_g1_element_32bit));
         _csg.header.total_size = (uint32_t)fileDataSize;
@@ -364,6 +438,7 @@ bool gfx_load_csg()
         if (_csg.header.num_entries < 69917)
         {
             log_warning("Cannot load CSG1.DAT, it has too few entries. Only CSG1.DAT from Loopy Landscapes will work.");
+            _csg.file = nullptr;
             return false;
         }
 
@@ -371,13 +446,11 @@ bool gfx_load_csg()
         _csg.elements.resize(_csg.header.num_entries);
         read_and_convert_gxdat(&fileHeader, _csg.header.num_entries, false, _csg.elements.data());
 
-        // Read element data
-        _csg.data = fileData.ReadArray<uint8_t>(_csg.header.total_size);
-
         // Fix entry data offsets
+        auto data = gfx_get_gx_data(*_csg.file, 0, _csg.header.total_size);
         for (uint32_t i = 0; i < _csg.header.num_entries; i++)
         {
-            _csg.elements[i].offset += (uintptr_t)_csg.data;
+            _csg.elements[i].offset += (uintptr_t)data;
             // RCT1 used zoomed offsets that counted from the beginning of the file, rather than from the current sprite.
             if (_csg.elements[i].flags & G1_FLAG_HAS_ZOOM_SPRITE)
             {
@@ -389,6 +462,7 @@ bool gfx_load_csg()
     }
     catch (const std::exception&)
     {
+        _csg.file = nullptr;
         _csg.elements.clear();
         _csg.elements.shrink_to_fit();
 
@@ -411,6 +485,30 @@ void FASTCALL gfx_bmp_sprite_to_buffer(
     uint32_t dest_line_width = (dest_dpi->width / zoom_amount) + dest_dpi->pitch;
     uint32_t source_line_width = source_image->width * zoom_amount;
 
+    // Unzoomed images are drawn a whole line at a time, by the fastest version the CPU supports.
+    if (zoom_level == 0 && width > 0 && height > 0)
+    {
+        int32_t sourceWrap = source_line_width - width;
+        int32_t destWrap = dest_line_width - width;
+        if (image_type & IMAGE_TYPE_REMAP)
+        {
+            assert(palette_pointer != nullptr);
+            bmp_blit_remap_fn(width, height, source_pointer, dest_pointer, palette_pointer, sourceWrap, destWrap);
+            return;
+        }
+        if (image_type & IMAGE_TYPE_TRANSPARENT)
+        {
+            assert(palette_pointer != nullptr);
+            bmp_blit_glass_fn(width, height, source_pointer, dest_pointer, palette_pointer, sourceWrap, destWrap);
+            return;
+        }
+        if (source_image->flags & G1_FLAG_BMP)
+        {
+            bmp_blit_copy_fn(width, height, source_pointer, dest_pointer, sourceWrap, destWrap);
+            return;
+        }
+    }
+
     // Image uses the palette pointer to remap the colours of the image
     if (image_type & IMAGE_TYPE_REMAP)
     {
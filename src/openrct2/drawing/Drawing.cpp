@@ -18,6 +18,8 @@
 #include "../util/Util.h"
 #include "../world/Water.h"
 
+#include <algorithm>
+
 // HACK These were originally passed back through registers
 int32_t gLastDrawStringX;
 int32_t gLastDrawStringY;
@@ -38,7 +40,7 @@ int32_t gPickupPeepY;
  * rct2: 0x0009ABE0C
  */
 // clang-format off
-uint8_t gPeepPalette[256] = {
+thread_local uint8_t gPeepPalette[256] = {
     0x00, 0xF3, 0xF4, 0xF5, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F,
     0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F,
     0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28, 0x29, 0x2A, 0x2B, 0x2C, 0x2D, 0x2E, 0x2F,
@@ -58,7 +60,7 @@ uint8_t gPeepPalette[256] = {
 };
 
 /** rct2: 0x009ABF0C */
-uint8_t gOtherPalette[256] = {
+thread_local uint8_t gOtherPalette[256] = {
     0x00, 0xF3, 0xF4, 0xF5, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F,
     0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F,
     0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28, 0x29, 0x2A, 0x2B, 0x2C, 0x2D, 0x2E, 0x2F,
@@ -470,22 +472,105 @@ void (*mask_fn)(
     int32_t maskWrap, int32_t colourWrap, int32_t dstWrap)
     = nullptr;
 
+void (*palette_to_rgba_fn)(
+    const uint8_t* RESTRICT src, uint32_t* RESTRICT dst, size_t count, const uint32_t* RESTRICT palette) = nullptr;
+
+void (*palette_to_rgba_lit_fn)(
+    const uint8_t* RESTRICT src, const uint8_t* RESTRICT light, uint32_t* RESTRICT dst, size_t count,
+    const uint32_t* RESTRICT palette, const uint32_t* RESTRICT lightPalette)
+    = nullptr;
+
+// Bitmap sprites may be drawn before mask_init has picked the fastest version.
+void (*bmp_blit_copy_fn)(
+    int32_t width, int32_t height, const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t srcWrap, int32_t dstWrap)
+    = bmp_blit_copy_scalar;
+
+void (*bmp_blit_remap_fn)(
+    int32_t width, int32_t height, const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, const uint8_t* RESTRICT palette,
+    int32_t srcWrap, int32_t dstWrap)
+    = bmp_blit_remap_scalar;
+
+void (*bmp_blit_glass_fn)(
+    int32_t width, int32_t height, const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, const uint8_t* RESTRICT palette,
+    int32_t srcWrap, int32_t dstWrap)
+    = bmp_blit_glass_scalar;
+
 void mask_init()
 {
     if (avx2_available())
     {
         log_verbose("registering AVX2 mask function");
         mask_fn = mask_avx2;
+        bmp_blit_copy_fn = bmp_blit_copy_avx2;
+        bmp_blit_remap_fn = bmp_blit_remap_avx2;
+        bmp_blit_glass_fn = bmp_blit_glass_avx2;
+        palette_to_rgba_fn = palette_to_rgba_avx2;
+        palette_to_rgba_lit_fn = palette_to_rgba_lit_avx2;
     }
     else if (sse41_available())
     {
+        // SSE4.1 has no gather, so looking up colours is no faster than the scalar version.
         log_verbose("registering SSE4.1 mask function");
         mask_fn = mask_sse4_1;
+        bmp_blit_copy_fn = bmp_blit_copy_sse4_1;
+        // Looking up colours with shuffles only pays off with the wider AVX2 registers.
+        bmp_blit_remap_fn = bmp_blit_remap_scalar;
+        bmp_blit_glass_fn = bmp_blit_glass_sse4_1;
+        palette_to_rgba_fn = palette_to_rgba_scalar;
+        palette_to_rgba_lit_fn = palette_to_rgba_lit_sse4_1;
     }
     else
     {
         log_verbose("registering scalar mask function");
         mask_fn = mask_scalar;
+        bmp_blit_copy_fn = bmp_blit_copy_scalar;
+        bmp_blit_remap_fn = bmp_blit_remap_scalar;
+        bmp_blit_glass_fn = bmp_blit_glass_scalar;
+        palette_to_rgba_fn = palette_to_rgba_scalar;
+        palette_to_rgba_lit_fn = palette_to_rgba_lit_scalar;
+    }
+}
+
+void palette_to_rgba_scalar(const uint8_t* RESTRICT src, uint32_t* RESTRICT dst, size_t count, const uint32_t* RESTRICT palette)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        dst[i] = palette[src[i]];
+    }
+}
+
+static uint8_t mix_light(uint32_t a, uint32_t b, uint32_t intensity)
+{
+    intensity = intensity * 6;
+    uint32_t bMul = (b * intensity) >> 8;
+    uint32_t ab = a + bMul;
+    uint8_t result = std::min<uint32_t>(255, ab);
+    return result;
+}
+
+void palette_to_rgba_lit_scalar(
+    const uint8_t* RESTRICT src, const uint8_t* RESTRICT light, uint32_t* RESTRICT dst, size_t count,
+    const uint32_t* RESTRICT palette, const uint32_t* RESTRICT lightPalette)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        uint32_t darkColour = palette[src[i]];
+        uint32_t lightColour = lightPalette[src[i]];
+        uint8_t lightIntensity = light[i];
+
+        uint32_t colour = 0;
+        if (lightIntensity == 0)
+        {
+            colour = darkColour;
+        }
+        else
+        {
+            colour |= mix_light((darkColour >> 0) & 0xFF, (lightColour >> 0) & 0xFF, lightIntensity);
+            colour |= mix_light((darkColour >> 8) & 0xFF, (lightColour >> 8) & 0xFF, lightIntensity) << 8;
+            colour |= mix_light((darkColour >> 16) & 0xFF, (lightColour >> 16) & 0xFF, lightIntensity) << 16;
+            colour |= mix_light((darkColour >> 24) & 0xFF, (lightColour >> 24) & 0xFF, lightIntensity) << 24;
+        }
+        dst[i] = colour;
     }
 }
 
@@ -245,8 +245,9 @@ extern uint8_t gGamePalette[256 * 4];
 extern uint32_t gPaletteEffectFrame;
 extern const FILTER_PALETTE_ID GlassPaletteIds[COLOUR_COUNT];
 extern const uint16_t palette_to_g1_offset[];
-extern uint8_t gPeepPalette[256];
-extern uint8_t gOtherPalette[256];
+// Filled in while drawing remapped sprites, so every thread that draws has its own.
+extern thread_local uint8_t gPeepPalette[256];
+extern thread_local uint8_t gOtherPalette[256];
 extern uint8_t text_palette[];
 extern const translucent_window_palette TranslucentWindowPalettes[COLOUR_COUNT];
 
@@ -370,6 +371,7 @@ void ttf_draw_string(rct_drawpixelinfo* dpi, const_utf8string text, int32_t colo
 void scrolling_text_initialise_bitmaps();
 void scrolling_text_invalidate();
 int32_t scrolling_text_setup(struct paint_session* session, rct_string_id stringId, uint16_t scroll, uint16_t scrollingMode);
+void scrolling_text_release(struct paint_session* session);
 
 rct_size16 FASTCALL gfx_get_sprite_size(uint32_t image_id);
 size_t g1_calculate_data_size(const rct_g1_element* g1);
@@ -389,6 +391,61 @@ extern void (*mask_fn)(
     int32_t width, int32_t height, const uint8_t* RESTRICT maskSrc, const uint8_t* RESTRICT colourSrc, uint8_t* RESTRICT dst,
     int32_t maskWrap, int32_t colourWrap, int32_t dstWrap);
 
+// Converts count palette indices to 32-bit colours.
+void palette_to_rgba_scalar(
+    const uint8_t* RESTRICT src, uint32_t* RESTRICT dst, size_t count, const uint32_t* RESTRICT palette);
+void palette_to_rgba_avx2(const uint8_t* RESTRICT src, uint32_t* RESTRICT dst, size_t count, const uint32_t* RESTRICT palette);
+// As palette_to_rgba, but adds the colour from lightPalette scaled by the intensity of the light at each pixel.
+void palette_to_rgba_lit_scalar(
+    const uint8_t* RESTRICT src, const uint8_t* RESTRICT light, uint32_t* RESTRICT dst, size_t count,
+    const uint32_t* RESTRICT palette, const uint32_t* RESTRICT lightPalette);
+void palette_to_rgba_lit_sse4_1(
+    const uint8_t* RESTRICT src, const uint8_t* RESTRICT light, uint32_t* RESTRICT dst, size_t count,
+    const uint32_t* RESTRICT palette, const uint32_t* RESTRICT lightPalette);
+void palette_to_rgba_lit_avx2(
+    const uint8_t* RESTRICT src, const uint8_t* RESTRICT light, uint32_t* RESTRICT dst, size_t count,
+    const uint32_t* RESTRICT palette, const uint32_t* RESTRICT lightPalette);
+
+// Unzoomed bitmap sprite blits, see gfx_bmp_sprite_to_buffer. Pixels of colour 0 are not drawn.
+void bmp_blit_copy_scalar(
+    int32_t width, int32_t height, const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t srcWrap, int32_t dstWrap);
+void bmp_blit_copy_sse4_1(
+    int32_t width, int32_t height, const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t srcWrap, int32_t dstWrap);
+void bmp_blit_copy_avx2(
+    int32_t width, int32_t height, const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t srcWrap, int32_t dstWrap);
+// Draws the source pixels remapped by the palette.
+void bmp_blit_remap_scalar(
+    int32_t width, int32_t height, const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, const uint8_t* RESTRICT palette,
+    int32_t srcWrap, int32_t dstWrap);
+void bmp_blit_remap_avx2(
+    int32_t width, int32_t height, const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, const uint8_t* RESTRICT palette,
+    int32_t srcWrap, int32_t dstWrap);
+// Remaps the destination pixels that are covered by the source, as used for glass.
+void bmp_blit_glass_scalar(
+    int32_t width, int32_t height, const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, const uint8_t* RESTRICT palette,
+    int32_t srcWrap, int32_t dstWrap);
+void bmp_blit_glass_sse4_1(
+    int32_t width, int32_t height, const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, const uint8_t* RESTRICT palette,
+    int32_t srcWrap, int32_t dstWrap);
+void bmp_blit_glass_avx2(
+    int32_t width, int32_t height, const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, const uint8_t* RESTRICT palette,
+    int32_t srcWrap, int32_t dstWrap);
+
+extern void (*bmp_blit_copy_fn)(
+    int32_t width, int32_t height, const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t srcWrap, int32_t dstWrap);
+extern void (*bmp_blit_remap_fn)(
+    int32_t width, int32_t height, const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, const uint8_t* RESTRICT palette,
+    int32_t srcWrap, int32_t dstWrap);
+extern void (*bmp_blit_glass_fn)(
+    int32_t width, int32_t height, const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, const uint8_t* RESTRICT palette,
+    int32_t srcWrap, int32_t dstWrap);
+
+extern void (*palette_to_rgba_fn)(
+    const uint8_t* RESTRICT src, uint32_t* RESTRICT dst, size_t count, const uint32_t* RESTRICT palette);
+extern void (*palette_to_rgba_lit_fn)(
+    const uint8_t* RESTRICT src, const uint8_t* RESTRICT light, uint32_t* RESTRICT dst, size_t count,
+    const uint32_t* RESTRICT palette, const uint32_t* RESTRICT lightPalette);
+
 #include "NewDrawing.h"
 
 #endif
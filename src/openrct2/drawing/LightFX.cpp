@@ -1069,15 +1069,6 @@ void lightfx_apply_palette_filter(uint8_t i, uint8_t* r, uint8_t* g, uint8_t* b)
     }
 }
 
-static uint8_t mix_light(uint32_t a, uint32_t b, uint32_t intensity)
-{
-    intensity = intensity * 6;
-    uint32_t bMul = (b * intensity) >> 8;
-    uint32_t ab = a + bMul;
-    uint8_t result = std::min<uint32_t>(255, ab);
-    return result;
-}
-
 void lightfx_render_to_texture(
     void* dstPixels, uint32_t dstPitch, uint8_t* bits, uint32_t width, uint32_t height, const uint32_t* palette,
     const uint32_t* lightPalette)
@@ -1097,27 +1088,7 @@ void lightfx_render_to_texture(
     {
         uintptr_t dstOffset = (uintptr_t)(y * dstPitch);
         uint32_t* dst = (uint32_t*)((uintptr_t)dstPixels + dstOffset);
-        for (uint32_t x = 0; x < width; x++)
-        {
-            uint8_t* src = &bits[y * width + x];
-            uint32_t darkColour = palette[*src];
-            uint32_t lightColour = lightPalette[*src];
-            uint8_t lightIntensity = lightBits[y * width + x];
-
-            uint32_t colour = 0;
-            if (lightIntensity == 0)
-            {
-                colour = darkColour;
-            }
-            else
-            {
-                colour |= mix_light((darkColour >> 0) & 0xFF, (lightColour >> 0) & 0xFF, lightIntensity);
-                colour |= mix_light((darkColour >> 8) & 0xFF, (lightColour >> 8) & 0xFF, lightIntensity) << 8;
-                colour |= mix_light((darkColour >> 16) & 0xFF, (lightColour >> 16) & 0xFF, lightIntensity) << 16;
-                colour |= mix_light((darkColour >> 24) & 0xFF, (lightColour >> 24) & 0xFF, lightIntensity) << 24;
-            }
-            *dst++ = colour;
-        }
+        palette_to_rgba_lit_fn(&bits[y * width], &lightBits[y * width], dst, width, palette, lightPalette);
     }
 }
 
@@ -137,6 +137,17 @@ bool drawing_engine_has_dirty_optimisations()
     return result;
 }
 
+bool drawing_engine_can_draw_in_parallel()
+{
+    bool result = false;
+    auto drawingEngine = GetDrawingEngine();
+    if (drawingEngine != nullptr)
+    {
+        result = (drawingEngine->GetFlags() & DEF_PARALLEL_DRAWING);
+    }
+    return result;
+}
+
 void drawing_engine_invalidate_image(uint32_t image)
 {
     auto drawingEngine = GetDrawingEngine();
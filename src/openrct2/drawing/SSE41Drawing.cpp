@@ -13,6 +13,7 @@
 
 #ifdef __SSE4_1__
 
+#    include <cstring>
 #    include <immintrin.h>
 
 void mask_sse4_1(
@@ -56,6 +57,111 @@ void mask_sse4_1(
     }
 }
 
+/**
+ * Splits a palette into the sixteen tables of sixteen colours that palette_lookup_sse4_1 shuffles from.
+ */
+static void palette_load_sse4_1(const uint8_t* palette, __m128i tables[16])
+{
+    for (int32_t i = 0; i < 16; i++)
+    {
+        tables[i] = _mm_loadu_si128((const __m128i*)(palette + i * 16));
+    }
+}
+
+/**
+ * Looks up sixteen colours at once. The low nibble of each index picks the colour from every table and the high nibble
+ * picks the table.
+ */
+static inline __m128i palette_lookup_sse4_1(const __m128i tables[16], __m128i indices)
+{
+    const __m128i nibbleMask = _mm_set1_epi8(0x0F);
+    const __m128i lo = _mm_and_si128(indices, nibbleMask);
+    const __m128i hi = _mm_and_si128(_mm_srli_epi16(indices, 4), nibbleMask);
+    __m128i result = _mm_setzero_si128();
+    for (int32_t i = 0; i < 16; i++)
+    {
+        const __m128i select = _mm_cmpeq_epi8(hi, _mm_set1_epi8((char)i));
+        result = _mm_blendv_epi8(result, _mm_shuffle_epi8(tables[i], lo), select);
+    }
+    return result;
+}
+
+void bmp_blit_copy_sse4_1(
+    int32_t width, int32_t height, const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t srcWrap, int32_t dstWrap)
+{
+    const __m128i zero = {};
+    const int32_t simdWidth = width & ~15;
+    for (int32_t yy = 0; yy < height; yy++)
+    {
+        for (int32_t xx = 0; xx < simdWidth; xx += 16)
+        {
+            const __m128i source = _mm_lddqu_si128((const __m128i*)(src + xx));
+            const __m128i dest = _mm_lddqu_si128((const __m128i*)(dst + xx));
+            _mm_storeu_si128((__m128i*)(dst + xx), _mm_blendv_epi8(source, dest, _mm_cmpeq_epi8(source, zero)));
+        }
+        bmp_blit_copy_scalar(width - simdWidth, 1, src + simdWidth, dst + simdWidth, 0, 0);
+        src += width + srcWrap;
+        dst += width + dstWrap;
+    }
+}
+
+void bmp_blit_glass_sse4_1(
+    int32_t width, int32_t height, const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, const uint8_t* RESTRICT palette,
+    int32_t srcWrap, int32_t dstWrap)
+{
+    __m128i tables[16];
+    palette_load_sse4_1(palette, tables);
+    const __m128i zero = {};
+    const int32_t simdWidth = width & ~15;
+    for (int32_t yy = 0; yy < height; yy++)
+    {
+        for (int32_t xx = 0; xx < simdWidth; xx += 16)
+        {
+            const __m128i source = _mm_lddqu_si128((const __m128i*)(src + xx));
+            const __m128i dest = _mm_lddqu_si128((const __m128i*)(dst + xx));
+            const __m128i remapped = palette_lookup_sse4_1(tables, dest);
+            _mm_storeu_si128((__m128i*)(dst + xx), _mm_blendv_epi8(remapped, dest, _mm_cmpeq_epi8(source, zero)));
+        }
+        bmp_blit_glass_scalar(width - simdWidth, 1, src + simdWidth, dst + simdWidth, palette, 0, 0);
+        src += width + srcWrap;
+        dst += width + dstWrap;
+    }
+}
+
+void palette_to_rgba_lit_sse4_1(
+    const uint8_t* RESTRICT src, const uint8_t* RESTRICT light, uint32_t* RESTRICT dst, size_t count,
+    const uint32_t* RESTRICT palette, const uint32_t* RESTRICT lightPalette)
+{
+    const __m128i zero = {};
+    const __m128i six = _mm_set1_epi16(6);
+    // Copies the intensity of the first two and the last two pixels into the 16-bit channels of each pixel.
+    const __m128i spreadLo = _mm_setr_epi8(0, 1, 0, 1, 0, 1, 0, 1, 4, 5, 4, 5, 4, 5, 4, 5);
+    const __m128i spreadHi = _mm_setr_epi8(8, 9, 8, 9, 8, 9, 8, 9, 12, 13, 12, 13, 12, 13, 12, 13);
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        const __m128i dark = _mm_setr_epi32(
+            palette[src[i]], palette[src[i + 1]], palette[src[i + 2]], palette[src[i + 3]]);
+        const __m128i lit = _mm_setr_epi32(
+            lightPalette[src[i]], lightPalette[src[i + 1]], lightPalette[src[i + 2]], lightPalette[src[i + 3]]);
+        int32_t intensities;
+        std::memcpy(&intensities, light + i, sizeof(intensities));
+        const __m128i intensity = _mm_mullo_epi16(_mm_cvtepu8_epi32(_mm_cvtsi32_si128(intensities)), six);
+
+        // The light colour is unpacked into the high byte of each channel, so the high half of its product with the
+        // intensity is (light * intensity) >> 8. Packing saturates the sum to 255.
+        const __m128i mixLo = _mm_add_epi16(
+            _mm_unpacklo_epi8(dark, zero),
+            _mm_mulhi_epu16(_mm_unpacklo_epi8(zero, lit), _mm_shuffle_epi8(intensity, spreadLo)));
+        const __m128i mixHi = _mm_add_epi16(
+            _mm_unpackhi_epi8(dark, zero),
+            _mm_mulhi_epu16(_mm_unpackhi_epi8(zero, lit), _mm_shuffle_epi8(intensity, spreadHi)));
+        _mm_storeu_si128((__m128i*)(dst + i), _mm_packus_epi16(mixLo, mixHi));
+    }
+    palette_to_rgba_lit_scalar(src + i, light + i, dst + i, count - i, palette, lightPalette);
+}
+
 #else
 
 #    ifdef OPENRCT2_X86
@@ -69,4 +175,24 @@ void mask_sse4_1(
     openrct2_assert(false, "SSE 4.1 function called on a CPU that doesn't support SSE 4.1");
 }
 
+void palette_to_rgba_lit_sse4_1(
+    const uint8_t* RESTRICT src, const uint8_t* RESTRICT light, uint32_t* RESTRICT dst, size_t count,
+    const uint32_t* RESTRICT palette, const uint32_t* RESTRICT lightPalette)
+{
+    openrct2_assert(false, "SSE 4.1 function called on a CPU that doesn't support SSE 4.1");
+}
+
+void bmp_blit_copy_sse4_1(
+    int32_t width, int32_t height, const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t srcWrap, int32_t dstWrap)
+{
+    openrct2_assert(false, "SSE 4.1 function called on a CPU that doesn't support SSE 4.1");
+}
+
+void bmp_blit_glass_sse4_1(
+    int32_t width, int32_t height, const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, const uint8_t* RESTRICT palette,
+    int32_t srcWrap, int32_t dstWrap)
+{
+    openrct2_assert(false, "SSE 4.1 function called on a CPU that doesn't support SSE 4.1");
+}
+
 #endif // __SSE4_1__
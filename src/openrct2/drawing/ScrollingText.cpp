@@ -34,8 +34,12 @@ assert_struct_size(rct_draw_scroll_text, 0xA12);
 #pragma pack(pop)
 
 #define MAX_SCROLLING_TEXT_ENTRIES 32
+static_assert(MAX_SCROLLING_TEXT_ENTRIES <= 32, "paint_session::ScrollingTextEntries has a bit for each entry");
 
 static rct_draw_scroll_text _drawScrollTextList[MAX_SCROLLING_TEXT_ENTRIES];
+// The number of paint sessions using each entry. Several columns of a viewport can be painted at the same time, so an
+// entry is not reused until every session using it has been drawn.
+static uint8_t _drawScrollTextUsers[MAX_SCROLLING_TEXT_ENTRIES];
 static uint8_t _characterBitmaps[FONT_SPRITE_GLYPH_COUNT + SPR_G2_GLYPH_COUNT][8];
 static uint32_t _drawSCrollNextIndex = 0;
 
@@ -133,6 +137,10 @@ static uint8_t* font_sprite_get_codepoint_bitmap(int32_t codepoint)
     }
 }
 
+/**
+ * Returns the image of the entry matching the text, or else the index of the oldest entry not in use by any paint
+ * session, -1 if they all are.
+ */
 static int32_t scrolling_text_get_matching_or_oldest(rct_string_id stringId, uint16_t scroll, uint16_t scrollingMode)
 {
     uint32_t oldestId = 0xFFFFFFFF;
@@ -140,7 +148,7 @@ static int32_t scrolling_text_get_matching_or_oldest(rct_string_id stringId, uin
     for (int32_t i = 0; i < MAX_SCROLLING_TEXT_ENTRIES; i++)
     {
         rct_draw_scroll_text* scrollText = &_drawScrollTextList[i];
-        if (oldestId >= scrollText->id)
+        if (_drawScrollTextUsers[i] == 0 && oldestId >= scrollText->id)
         {
             oldestId = scrollText->id;
             scrollIndex = i;
@@ -1462,6 +1470,16 @@ void scrolling_text_invalidate()
     }
 }
 
+static void scrolling_text_use(paint_session* session, int32_t scrollIndex)
+{
+    uint32_t entryBit = 1u << scrollIndex;
+    if (!(session->ScrollingTextEntries & entryBit))
+    {
+        session->ScrollingTextEntries |= entryBit;
+        _drawScrollTextUsers[scrollIndex]++;
+    }
+}
+
 /**
  *
  *  rct2: 0x006C42D9
@@ -1483,7 +1501,16 @@ int32_t scrolling_text_setup(paint_session* session, rct_string_id stringId, uin
 
     int32_t scrollIndex = scrolling_text_get_matching_or_oldest(stringId, scroll, scrollingMode);
     if (scrollIndex >= SPR_SCROLLING_TEXT_START)
+    {
+        scrolling_text_use(session, scrollIndex - SPR_SCROLLING_TEXT_START);
         return scrollIndex;
+    }
+    if (scrollIndex == -1)
+    {
+        // More scrolling texts are being painted at once than there are entries
+        return SPR_SCROLLING_TEXT_DEFAULT;
+    }
+    scrolling_text_use(session, scrollIndex);
 
     // Setup scrolling text
     uint32_t stringArgs0, stringArgs1;
@@ -1519,6 +1546,25 @@ int32_t scrolling_text_setup(paint_session* session, rct_string_id stringId, uin
     return imageId;
 }
 
+/**
+ * Lets the scrolling text entries used by the session be reused, once it has been drawn.
+ */
+void scrolling_text_release(paint_session* session)
+{
+    if (session->ScrollingTextEntries == 0)
+        return;
+
+    std::lock_guard<std::mutex> lock(gPaintTextMutex);
+    for (int32_t i = 0; i < MAX_SCROLLING_TEXT_ENTRIES; i++)
+    {
+        if (session->ScrollingTextEntries & (1u << i))
+        {
+            _drawScrollTextUsers[i]--;
+        }
+    }
+    session->ScrollingTextEntries = 0;
+}
+
 static void scrolling_text_set_bitmap_for_sprite(
     utf8* text, int32_t scroll, uint8_t* bitmap, const int16_t* scrollPositionOffsets)
 {
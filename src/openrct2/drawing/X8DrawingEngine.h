@@ -124,7 +124,8 @@ namespace OpenRCT2
         {
         private:
             X8DrawingEngine* _engine = nullptr;
-            rct_drawpixelinfo* _dpi = nullptr;
+            // Each thread that draws sets the DPI it draws to, see DEF_PARALLEL_DRAWING.
+            static thread_local rct_drawpixelinfo* _dpi;
 
         public:
             explicit X8DrawingContext(X8DrawingEngine* engine);
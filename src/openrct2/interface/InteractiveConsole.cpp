@@ -14,10 +14,12 @@
 #include "../Game.h"
 #include "../OpenRCT2.h"
 #include "../ReplayManager.h"
+#include "../TickProfiler.h"
 #include "../Version.h"
 #include "../actions/ClimateSetAction.hpp"
 #include "../actions/StaffSetCostumeAction.hpp"
 #include "../config/Config.h"
+#include "../core/File.h"
 #include "../core/Guard.hpp"
 #include "../core/String.hpp"
 #include "../drawing/Drawing.h"
@@ -1194,8 +1196,7 @@ static int32_t cc_remove_park_fences(InteractiveConsole& console, [[maybe_unused
 
 static int32_t cc_show_limits(InteractiveConsole& console, [[maybe_unused]] const arguments_t& argv)
 {
-    map_reorganise_elements();
-    int32_t tileElementCount = gNextFreeTileElement - gTileElements - 1;
+    int32_t tileElementCount = (int32_t)map_get_num_tile_elements();
 
     int32_t rideCount = 0;
     for (int32_t i = 0; i < MAX_RIDES; ++i)
@@ -1231,7 +1232,7 @@ static int32_t cc_show_limits(InteractiveConsole& console, [[maybe_unused]] cons
         }
     }
 
-    console.WriteFormatLine("Sprites: %d/%d", spriteCount, MAX_SPRITES);
+    console.WriteFormatLine("Sprites: %d/%d", spriteCount, (int32_t)sprite_get_capacity());
     console.WriteFormatLine("Map Elements: %d/%d", tileElementCount, MAX_TILE_ELEMENTS);
     console.WriteFormatLine("Banners: %d/%zu", bannerCount, MAX_BANNERS);
     console.WriteFormatLine("Rides: %d/%d", rideCount, MAX_RIDES);
@@ -1492,6 +1493,70 @@ static int32_t cc_replay_normalise(InteractiveConsole& console, const arguments_
     return 0;
 }
 
+static int32_t cc_profiler(InteractiveConsole& console, const arguments_t& argv)
+{
+    using namespace OpenRCT2;
+
+    if (argv.empty())
+    {
+        console.WriteFormatLine(
+            "Tick profiler is %s, %zu ticks recorded.", TickProfiler::IsEnabled() ? "enabled" : "disabled",
+            TickProfiler::GetNumTicks());
+        return 0;
+    }
+
+    if (argv[0] == "start")
+    {
+        TickProfiler::Reset();
+        TickProfiler::SetEnabled(true);
+        console.WriteFormatLine("Tick profiler started.");
+    }
+    else if (argv[0] == "stop")
+    {
+        TickProfiler::SetEnabled(false);
+        console.WriteFormatLine("Tick profiler stopped, %zu ticks recorded.", TickProfiler::GetNumTicks());
+    }
+    else if (argv[0] == "reset")
+    {
+        TickProfiler::Reset();
+        console.WriteFormatLine("Tick profiler history cleared.");
+    }
+    else if (argv[0] == "dump")
+    {
+        auto format = TickProfilerFormat::Csv;
+        if (argv.size() >= 2 && !TickProfiler::TryParseFormat(argv[1], &format))
+        {
+            console.WriteLineError("Unknown format, expected json or csv.");
+            return 1;
+        }
+
+        auto report = TickProfiler::GetReport(format);
+        if (argv.size() >= 3)
+        {
+            try
+            {
+                File::WriteAllBytes(argv[2], report.data(), report.size());
+                console.WriteFormatLine("Tick profile written to %s", argv[2].c_str());
+            }
+            catch (const std::exception& e)
+            {
+                console.WriteLineError(e.what());
+                return 1;
+            }
+        }
+        else
+        {
+            console.WriteLine(report);
+        }
+    }
+    else
+    {
+        console.WriteLineError("Unknown subcommand, expected start, stop, reset or dump.");
+        return 1;
+    }
+    return 0;
+}
+
 #pragma warning(push)
 #pragma warning(disable : 4702) // unreachable code
 static int32_t cc_abort([[maybe_unused]] InteractiveConsole& console, [[maybe_unused]] const arguments_t& argv)
@@ -1594,6 +1659,7 @@ static constexpr const console_command console_command_table[] = {
                                     "load_object <objectfilenodat>" },
     { "object_count", cc_object_count, "Shows the number of objects of each type in the scenario.", "object_count" },
     { "open", cc_open, "Opens the window with the give name.", "open <window>." },
+    { "profiler", cc_profiler, "Records per-stage timings of each game tick.", "profiler [start|stop|reset|dump [json|csv] [file]]" },
     { "quit", cc_close, "Closes the console.", "quit" },
     { "remove_park_fences", cc_remove_park_fences, "Removes all park fences from the surface", "remove_park_fences" },
     { "remove_unused_objects", cc_remove_unused_objects, "Removes all the unused objects from the object selection.", "remove_unused_objects" },
@@ -14,8 +14,10 @@
 #include "../Intro.h"
 #include "../OpenRCT2.h"
 #include "../audio/audio.h"
+#include "../config/Config.h"
 #include "../core/Console.hpp"
 #include "../core/Imaging.h"
+#include "../core/JobPool.h"
 #include "../drawing/Drawing.h"
 #include "../localisation/Localisation.h"
 #include "../platform/platform.h"
@@ -26,9 +28,11 @@
 #include "../world/Surface.h"
 #include "Viewport.h"
 
+#include <algorithm>
 #include <chrono>
 #include <cstdlib>
 #include <memory>
+#include <vector>
 
 using namespace OpenRCT2;
 
@@ -57,6 +61,115 @@ static bool WriteDpiToFile(const std::string_view& path, const rct_drawpixelinfo
     }
 }
 
+// Height of the bands of rows a viewport is rendered in when it is written to a file.
+static constexpr int32_t SCREENSHOT_BAND_HEIGHT = 128;
+
+struct ScreenshotBatch
+{
+    int32_t Top = 0;
+    int32_t Height = 0;
+    std::vector<uint8_t> Pixels;
+};
+
+static void RenderViewportBatch(rct_viewport* viewport, ScreenshotBatch* batch)
+{
+    int32_t width = viewport->width;
+    batch->Pixels.assign((size_t)width * batch->Height, 0);
+
+    auto renderBand = [viewport, batch, width](size_t band) {
+        int32_t top = batch->Top + (int32_t)band * SCREENSHOT_BAND_HEIGHT;
+        int32_t bottom = std::min(top + SCREENSHOT_BAND_HEIGHT, batch->Top + batch->Height);
+
+        rct_drawpixelinfo dpi;
+        dpi.x = 0;
+        dpi.y = top;
+        dpi.width = width;
+        dpi.height = bottom - top;
+        dpi.pitch = 0;
+        dpi.zoom_level = 0;
+        dpi.bits = batch->Pixels.data() + (size_t)(top - batch->Top) * width;
+        viewport_render(&dpi, viewport, 0, top, width, bottom);
+    };
+
+    size_t numBands = (batch->Height + SCREENSHOT_BAND_HEIGHT - 1) / SCREENSHOT_BAND_HEIGHT;
+    if (viewport_can_paint_in_parallel())
+    {
+        JobPool::ParallelFor(0, numBands, renderBand, 1);
+    }
+    else
+    {
+        for (size_t band = 0; band < numBands; band++)
+        {
+            renderBand(band);
+        }
+    }
+}
+
+/**
+ * Renders a viewport straight into a PNG file. The viewport is rendered in batches of bands as the encoder asks
+ * for their rows, so only two batches are held in memory however large the viewport is. When painting in
+ * parallel, the bands of a batch are painted at the same time and the next batch is painted while the current
+ * one is being encoded.
+ */
+static bool WriteViewportToFile(const std::string_view& path, rct_viewport* viewport, const rct_palette& palette)
+{
+    bool parallel = viewport_can_paint_in_parallel();
+    int32_t batchHeight = SCREENSHOT_BAND_HEIGHT * (parallel ? (int32_t)JobPool::GetNumThreads() : 1);
+
+    ScreenshotBatch batches[2];
+    ScreenshotBatch* current = &batches[0];
+    ScreenshotBatch* next = &batches[1];
+    TaskGroup renderGroup;
+
+    auto startBatch = [&](ScreenshotBatch* batch, int32_t top) {
+        batch->Top = top;
+        batch->Height = std::min(batchHeight, viewport->height - top);
+        if (batch->Height <= 0)
+            return;
+
+        if (parallel)
+        {
+            renderGroup.Run([viewport, batch]() { RenderViewportBatch(viewport, batch); });
+        }
+        else
+        {
+            RenderViewportBatch(viewport, batch);
+        }
+    };
+
+    try
+    {
+        startBatch(current, 0);
+        renderGroup.Wait();
+        startBatch(next, current->Top + current->Height);
+
+        Image image;
+        image.Width = viewport->width;
+        image.Height = viewport->height;
+        image.Depth = 8;
+        image.Stride = viewport->width;
+        image.Palette = std::make_unique<rct_palette>(palette);
+        Imaging::WriteToFile(
+            path, image,
+            [&](uint32_t y) {
+                if ((int32_t)y >= current->Top + current->Height)
+                {
+                    renderGroup.Wait();
+                    std::swap(current, next);
+                    startBatch(next, current->Top + current->Height);
+                }
+                return current->Pixels.data() + (size_t)((int32_t)y - current->Top) * viewport->width;
+            },
+            IMAGE_FORMAT::PNG);
+        return true;
+    }
+    catch (const std::exception& e)
+    {
+        log_error("Unable to write png: %s", e.what());
+        return false;
+    }
+}
+
 /**
  *
  *  rct2: 0x006E3AEC
@@ -284,17 +397,6 @@ void screenshot_giant()
     // Ensure sprites appear regardless of rotation
     reset_all_sprite_quadrant_placements();
 
-    rct_drawpixelinfo dpi;
-    dpi.x = 0;
-    dpi.y = 0;
-    dpi.width = resolutionWidth;
-    dpi.height = resolutionHeight;
-    dpi.pitch = 0;
-    dpi.zoom_level = 0;
-    dpi.bits = (uint8_t*)malloc(dpi.width * dpi.height);
-
-    viewport_render(&dpi, &viewport, 0, 0, viewport.width, viewport.height);
-
     // Get a free screenshot path
     char path[MAX_PATH];
     if (screenshot_get_next_path(path, MAX_PATH) == -1)
@@ -307,9 +409,7 @@ void screenshot_giant()
     rct_palette renderedPalette;
     screenshot_get_rendered_palette(&renderedPalette);
 
-    WriteDpiToFile(path, &dpi, renderedPalette);
-
-    free(dpi.bits);
+    WriteViewportToFile(path, &viewport, renderedPalette);
 
     // Show user that screenshot saved successfully
     set_format_arg(0, rct_string_id, STR_STRING);
@@ -368,20 +468,36 @@ static void benchgfx_render_screenshots(const char* inputPath, std::unique_ptr<I
     dpi.pitch = 0;
     dpi.bits = (uint8_t*)malloc(dpi.width * dpi.height);
 
-    auto startTime = std::chrono::high_resolution_clock::now();
-    for (uint32_t i = 0; i < iterationCount; i++)
-    {
-        // Render at various zoom levels
-        dpi.zoom_level = i & 3;
-        viewport_render(&dpi, &viewport, 0, 0, viewport.width, viewport.height);
-    }
-    auto endTime = std::chrono::high_resolution_clock::now();
-    std::chrono::duration<float> duration = endTime - startTime;
     char engine_name[128];
     rct_string_id engine_id = DrawingEngineStringIds[drawing_engine_get_type()];
     format_string(engine_name, sizeof(engine_name), engine_id, nullptr);
-    Console::WriteLine(
-        "Rendering %d times with drawing engine %s took %.2f seconds.", iterationCount, engine_name, duration.count());
+
+    // Render once on a single thread and once with the viewport columns painted in parallel.
+    bool multithreading = gConfigGeneral.multithreading;
+    float durations[2];
+    for (int32_t parallel = 0; parallel < 2; parallel++)
+    {
+        gConfigGeneral.multithreading = parallel != 0;
+        auto startTime = std::chrono::high_resolution_clock::now();
+        for (uint32_t i = 0; i < iterationCount; i++)
+        {
+            // Render at various zoom levels
+            dpi.zoom_level = i & 3;
+            viewport_render(&dpi, &viewport, 0, 0, viewport.width, viewport.height);
+        }
+        auto endTime = std::chrono::high_resolution_clock::now();
+        std::chrono::duration<float> duration = endTime - startTime;
+        durations[parallel] = duration.count();
+        Console::WriteLine(
+            "Rendering %d times with drawing engine %s (%s) took %.2f seconds.", iterationCount, engine_name,
+            parallel ? "multithreaded" : "single threaded", durations[parallel]);
+    }
+    gConfigGeneral.multithreading = multithreading;
+
+    if (durations[1] > 0)
+    {
+        Console::WriteLine("Multithreaded painting speedup: %.2fx", durations[0] / durations[1]);
+    }
 
     free(dpi.bits);
 }
@@ -581,15 +697,6 @@ int32_t cmdline_for_screenshot(const char** argv, int32_t argc, ScreenshotOption
         // Ensure sprites appear regardless of rotation
         reset_all_sprite_quadrant_placements();
 
-        rct_drawpixelinfo dpi;
-        dpi.x = 0;
-        dpi.y = 0;
-        dpi.width = resolutionWidth;
-        dpi.height = resolutionHeight;
-        dpi.pitch = 0;
-        dpi.zoom_level = 0;
-        dpi.bits = (uint8_t*)malloc(dpi.width * dpi.height);
-
         if (options->hide_guests)
         {
             viewport.flags |= VIEWPORT_FLAG_INVISIBLE_PEEPS;
@@ -625,14 +732,11 @@ int32_t cmdline_for_screenshot(const char** argv, int32_t argc, ScreenshotOption
             game_do_command(0, GAME_COMMAND_FLAG_APPLY, CHEAT_REMOVELITTER, 0, GAME_COMMAND_CHEAT, 0, 0);
         }
 
-        viewport_render(&dpi, &viewport, 0, 0, viewport.width, viewport.height);
-
         rct_palette renderedPalette;
         screenshot_get_rendered_palette(&renderedPalette);
 
-        WriteDpiToFile(outputPath, &dpi, renderedPalette);
+        WriteViewportToFile(outputPath, &viewport, renderedPalette);
 
-        free(dpi.bits);
         drawing_engine_dispose();
     }
     return 1;
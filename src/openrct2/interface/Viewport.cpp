@@ -14,7 +14,10 @@
 #include "../Input.h"
 #include "../OpenRCT2.h"
 #include "../config/Config.h"
+#include "../core/JobPool.h"
 #include "../drawing/Drawing.h"
+#include "../drawing/LightFX.h"
+#include "../drawing/NewDrawing.h"
 #include "../paint/Paint.h"
 #include "../peep/Staff.h"
 #include "../ride/Ride.h"
@@ -883,10 +886,8 @@ void viewport_paint(
 
     // Splits the area into 32 pixel columns and renders them
     int16_t start_x = floor2(dpi1.x, 32);
-    if (sessions != nullptr)
-    {
-        sessions->reserve((rightBorder - start_x) / 32);
-    }
+    std::vector<rct_drawpixelinfo> columns;
+    columns.reserve((rightBorder - start_x) / 32 + 1);
     for (int16_t columnx = start_x; columnx < rightBorder; columnx += 32)
     {
         rct_drawpixelinfo dpi2 = dpi1;
@@ -908,10 +909,49 @@ void viewport_paint(
         }
         dpi2.width = paintRight - dpi2.x;
 
-        viewport_paint_column(&dpi2, viewFlags, sessions);
+        columns.push_back(dpi2);
+    }
+
+    // The columns do not overlap, so each one can be painted by a job of its own, with a session of its own.
+    // Recording the sessions for the benchmark relies on the columns being painted in order.
+    if (sessions == nullptr && columns.size() > 1 && viewport_can_paint_in_parallel())
+    {
+        JobPool::ParallelFor(
+            0, columns.size(), [&columns, viewFlags](size_t i) { viewport_paint_column(&columns[i], viewFlags, nullptr); },
+            1);
+    }
+    else
+    {
+        if (sessions != nullptr)
+        {
+            sessions->reserve(columns.size());
+        }
+        for (auto& column : columns)
+        {
+            viewport_paint_column(&column, viewFlags, sessions);
+        }
     }
 }
 
+/**
+ * Painting in parallel is opt-in, and needs a drawing engine that can draw from several threads at once.
+ */
+bool viewport_can_paint_in_parallel()
+{
+    if (!gConfigGeneral.multithreading || !drawing_engine_can_draw_in_parallel())
+    {
+        return false;
+    }
+#ifdef __ENABLE_LIGHTFX__
+    // Lights are collected into global lists while painting.
+    if (lightfx_is_available())
+    {
+        return false;
+    }
+#endif
+    return true;
+}
+
 static void viewport_paint_column(rct_drawpixelinfo* dpi, uint32_t viewFlags, std::vector<paint_session>* sessions)
 {
     if (viewFlags
@@ -946,7 +986,6 @@ static void viewport_paint_column(rct_drawpixelinfo* dpi, uint32_t viewFlags, st
     }
     paint_session_arrange(session);
     paint_draw_structs(session);
-    paint_session_free(session);
 
     if (gConfigGeneral.render_weather_gloom && !gTrackDesignSaveMode && !(viewFlags & VIEWPORT_FLAG_INVISIBLE_SPRITES)
         && !(viewFlags & VIEWPORT_FLAG_HIGHLIGHT_PATH_ISSUES))
@@ -958,6 +997,7 @@ static void viewport_paint_column(rct_drawpixelinfo* dpi, uint32_t viewFlags, st
     {
         paint_draw_money_structs(dpi, session->PSStringHead);
     }
+    paint_session_free(session);
 }
 
 static void viewport_paint_weather_gloom(rct_drawpixelinfo* dpi)
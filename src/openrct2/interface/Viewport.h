@@ -135,6 +135,7 @@ void viewport_render(
 void viewport_paint(
     rct_viewport* viewport, rct_drawpixelinfo* dpi, int16_t left, int16_t top, int16_t right, int16_t bottom,
     std::vector<paint_session>* sessions = nullptr);
+bool viewport_can_paint_in_parallel();
 
 void viewport_adjust_for_map_height(int16_t* x, int16_t* y, int16_t* z);
 
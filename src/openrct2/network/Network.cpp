@@ -30,7 +30,7 @@
 // This string specifies which version of network stream current build uses.
 // It is used for making sure only compatible builds get connected, even within
 // single OpenRCT2 version.
-#define NETWORK_STREAM_VERSION "32"
+#define NETWORK_STREAM_VERSION "35"
 #define NETWORK_STREAM_ID OPENRCT2_VERSION "-" NETWORK_STREAM_VERSION
 
 static rct_peep* _pickup_peep = nullptr;
@@ -63,6 +63,7 @@ static int32_t _pickup_peep_old_x = LOCATION_NULL;
 #    include "NetworkAction.h"
 #    include "NetworkConnection.h"
 #    include "NetworkGroup.h"
+#    include "NetworkIoThread.h"
 #    include "NetworkKey.h"
 #    include "NetworkPacket.h"
 #    include "NetworkPlayer.h"
@@ -72,7 +73,9 @@ static int32_t _pickup_peep_old_x = LOCATION_NULL;
 
 #    include <algorithm>
 #    include <array>
+#    include <atomic>
 #    include <cerrno>
+#    include <cinttypes>
 #    include <cmath>
 #    include <fstream>
 #    include <functional>
@@ -81,6 +84,7 @@ static int32_t _pickup_peep_old_x = LOCATION_NULL;
 #    include <memory>
 #    include <set>
 #    include <string>
+#    include <thread>
 #    include <vector>
 
 #    pragma comment(lib, "Ws2_32.lib")
@@ -96,8 +100,22 @@ enum
 enum
 {
     NETWORK_TICK_FLAG_CHECKSUMS = 1 << 0,
+    NETWORK_TICK_FLAG_FULL_CHECKSUMS = 1 << 1,
 };
 
+// Debug builds of the server also send the full SHA1 sprite checksum along with the fast one, so that clients
+// can verify the fast checksum catches every difference the full one does.
+#    if defined(DEBUG) && DEBUG > 0
+#        define NETWORK_VERIFY_SPRITE_CHECKSUMS
+#    endif
+
+static std::string network_get_sprite_checksum()
+{
+    char buffer[17];
+    snprintf(buffer, sizeof(buffer), "%016" PRIx64, sprite_checksum_fast());
+    return buffer;
+}
+
 static void network_chat_show_connected_message();
 static void network_chat_show_server_greeting();
 static void network_get_keys_directory(utf8* buffer, size_t bufferSize);
@@ -219,7 +237,36 @@ private:
     void SetupDefaultGroups();
 
     bool LoadMap(IStream* stream);
-    bool SaveMap(IStream* stream, const std::vector<const ObjectRepositoryItem*>& objects) const;
+
+    /**
+     * A map that is sent to joining clients. The game state and packed objects are exported on the game thread, but
+     * encoding and compressing the export is done on a thread of its own, so the game loop never waits for it.
+     * Clients that join within the same tick share a snapshot, as long as no game command has run in between.
+     */
+    struct MapSnapshot
+    {
+        uint32_t Tick = 0;
+        std::vector<const ObjectRepositoryItem*> Objects;
+        std::unique_ptr<S6Exporter> Exporter;
+        MemoryStream NetworkData;
+        // The encoded map, empty if the map could not be encoded. Only valid once IsEncoded is set.
+        std::vector<uint8_t> Data;
+        std::atomic<bool> IsEncoded = { false };
+    };
+
+    struct PendingMap
+    {
+        NetworkConnection* Connection;
+        std::shared_ptr<MapSnapshot> Snapshot;
+    };
+
+    bool SaveMap(MapSnapshot& snapshot) const;
+    std::shared_ptr<MapSnapshot> CreateMapSnapshot(
+        const std::vector<const ObjectRepositoryItem*>& objects, bool encodeInBackground);
+    std::shared_ptr<MapSnapshot> GetMapSnapshot(const std::vector<const ObjectRepositoryItem*>& objects);
+    static void EncodeMapSnapshot(MapSnapshot& snapshot);
+    static std::vector<std::unique_ptr<NetworkPacket>> CreateMapPackets(const MapSnapshot& snapshot);
+    void UpdatePendingMaps();
 
     struct GameCommand
     {
@@ -300,9 +347,14 @@ private:
     uint32_t server_srand0 = 0;
     uint32_t server_srand0_tick = 0;
     std::string server_sprite_hash;
+    std::string server_sprite_full_hash;
     uint8_t player_id = 0;
     std::list<std::unique_ptr<NetworkConnection>> client_connection_list;
+    // Declared after the listening socket and the connections it reads from, so it is stopped before they are destroyed.
+    std::unique_ptr<NetworkIoThread> _ioThread;
     std::multiset<GameCommand> game_command_queue;
+    std::shared_ptr<MapSnapshot> _mapSnapshot;
+    std::list<PendingMap> _pendingMaps;
     std::vector<uint8_t> chunk_buffer;
     char _host[128] = {};
     uint16_t _port = 0;
@@ -352,8 +404,6 @@ private:
     void Client_Handle_OBJECTS(NetworkConnection& connection, NetworkPacket& packet);
     void Server_Handle_OBJECTS(NetworkConnection& connection, NetworkPacket& packet);
 
-    uint8_t* save_for_network(size_t& out_size, const std::vector<const ObjectRepositoryItem*>& objects) const;
-
     std::ofstream _chat_log_fs;
     std::ofstream _server_log_fs;
 };
@@ -455,6 +505,8 @@ void Network::Close()
         CloseServerLog();
         CloseConnection();
 
+        _pendingMaps.clear();
+        _mapSnapshot = nullptr;
         client_connection_list.clear();
         game_command_queue.clear();
         player_list.clear();
@@ -475,6 +527,7 @@ void Network::CloseConnection()
     }
     else if (mode == NETWORK_MODE_SERVER)
     {
+        _ioThread.reset();
         _listenSocket.reset();
         _advertiser.reset();
     }
@@ -607,6 +660,15 @@ bool Network::BeginServer(uint16_t port, const char* address)
         return false;
     }
 
+    if (gConfigNetwork.io_thread)
+    {
+        _ioThread = NetworkIoThread::Create(*_listenSocket);
+        if (_ioThread == nullptr)
+        {
+            log_warning("Receiving on a separate thread is not supported on this platform.");
+        }
+    }
+
     ServerName = String::ToStd(gConfigNetwork.server_name);
     ServerDescription = String::ToStd(gConfigNetwork.server_description);
     ServerGreeting = String::ToStd(gConfigNetwork.server_greeting);
@@ -728,6 +790,8 @@ void Network::Flush()
 
 void Network::UpdateServer()
 {
+    UpdatePendingMaps();
+
     auto it = client_connection_list.begin();
     while (it != client_connection_list.end())
     {
@@ -754,10 +818,20 @@ void Network::UpdateServer()
         _advertiser->Update();
     }
 
-    std::unique_ptr<ITcpSocket> tcpSocket = _listenSocket->Accept();
-    if (tcpSocket != nullptr)
+    if (_ioThread != nullptr)
+    {
+        for (auto tcpSocket = _ioThread->Accept(); tcpSocket != nullptr; tcpSocket = _ioThread->Accept())
+        {
+            AddClient(std::move(tcpSocket));
+        }
+    }
+    else
     {
-        AddClient(std::move(tcpSocket));
+        std::unique_ptr<ITcpSocket> tcpSocket = _listenSocket->Accept();
+        if (tcpSocket != nullptr)
+        {
+            AddClient(std::move(tcpSocket));
+        }
     }
 }
 
@@ -934,6 +1008,13 @@ const char* Network::FormatChat(NetworkPlayer* fromplayer, const char* text)
 
 void Network::SendPacketToClients(NetworkPacket& packet, bool front, bool gameCmd)
 {
+    // Compress the packet once for all the clients that accept compressed packets.
+    std::unique_ptr<NetworkPacket> compressed;
+    if (NetworkConnection::ShouldCompress(packet))
+    {
+        compressed = NetworkPacket::Compress(packet);
+    }
+
     for (auto& client_connection : client_connection_list)
     {
         if (gameCmd)
@@ -947,7 +1028,11 @@ void Network::SendPacketToClients(NetworkPacket& packet, bool front, bool gameCm
                 continue;
             }
         }
-        client_connection->QueuePacket(NetworkPacket::Duplicate(packet), front);
+        // The connections queue references to the same data rather than copies of it.
+        const NetworkPacket& source = compressed != nullptr && client_connection->GetCompression() != NETWORK_COMPRESSION_NONE
+            ? *compressed
+            : packet;
+        client_connection->QueuePacket(source, front);
     }
 }
 
@@ -976,9 +1061,14 @@ bool Network::CheckSRAND(uint32_t tick, uint32_t srand0)
         // Check that the server and client sprite hashes match
         if (server_sprite_hash[0] != '\0')
         {
-            rct_sprite_checksum checksum = sprite_checksum();
-            std::string client_sprite_hash = checksum.ToString();
+            std::string client_sprite_hash = network_get_sprite_checksum();
             sprites_mismatch = client_sprite_hash != server_sprite_hash;
+            if (!sprites_mismatch && !server_sprite_full_hash.empty()
+                && sprite_checksum().ToString() != server_sprite_full_hash)
+            {
+                log_error("Tick %u: the sprite checksums match, but the full sprite checksums do not.", tick);
+                sprites_mismatch = true;
+            }
             _network_sync_info = { tick, srand0, server_srand0, tick, client_sprite_hash, server_sprite_hash };
             checksum_tick = true;
         }
@@ -1430,6 +1520,9 @@ void Network::Client_Send_AUTH(const char* name, const char* password, const cha
     assert(sigsize <= (size_t)UINT32_MAX);
     *packet << (uint32_t)sigsize;
     packet->Write((const uint8_t*)sig, sigsize);
+    // The compression methods this client can decompress, the server picks one of them.
+    uint8_t supportedCompression = gConfigNetwork.packet_compression ? (1 << NETWORK_COMPRESSION_ZLIB) : 0;
+    *packet << supportedCompression;
     _serverConnection->AuthStatus = NETWORK_AUTH_REQUESTED;
     _serverConnection->QueuePacket(std::move(packet));
 }
@@ -1485,6 +1578,10 @@ NetworkStats_t Network::GetStats() const
                 stats.bytesReceived[n] += connection->Stats.bytesReceived[n];
                 stats.bytesSent[n] += connection->Stats.bytesSent[n];
             }
+            stats.queuedPackets += connection->Stats.queuedPackets;
+            stats.queuedBytes += connection->Stats.queuedBytes;
+            stats.bytesSavedSent += connection->Stats.bytesSavedSent;
+            stats.bytesSavedReceived += connection->Stats.bytesSavedReceived;
         }
     }
     return stats;
@@ -1503,6 +1600,7 @@ void Network::Server_Send_AUTH(NetworkConnection& connection)
     {
         packet->WriteString(network_get_version().c_str());
     }
+    *packet << (uint8_t)connection.GetCompression();
     connection.QueuePacket(std::move(packet));
     if (connection.AuthStatus != NETWORK_AUTH_OK && connection.AuthStatus != NETWORK_AUTH_REQUIREPASSWORD)
     {
@@ -1512,101 +1610,151 @@ void Network::Server_Send_AUTH(NetworkConnection& connection)
 
 void Network::Server_Send_MAP(NetworkConnection* connection)
 {
-    std::vector<const ObjectRepositoryItem*> objects;
-    if (connection)
-    {
-        objects = connection->RequestedObjects;
-    }
-    else
+    if (connection == nullptr)
     {
         // This will send all custom objects to connected clients
         // TODO: fix it so custom objects negotiation is performed even in this case.
         auto context = GetContext();
         auto& objManager = context->GetObjectManager();
-        objects = objManager.GetPackableObjects();
-    }
-
-    size_t out_size;
-    uint8_t* header = save_for_network(out_size, objects);
-    if (header == nullptr)
-    {
-        if (connection)
+        auto snapshot = CreateMapSnapshot(objManager.GetPackableObjects(), false);
+        for (const auto& packet : CreateMapPackets(*snapshot))
         {
-            connection->SetLastDisconnectReason(STR_MULTIPLAYER_CONNECTION_CLOSED);
-            connection->Socket->Disconnect();
+            SendPacketToClients(*packet);
         }
         return;
     }
-    size_t chunksize = 65000;
-    for (size_t i = 0; i < out_size; i += chunksize)
+
+    // Everything sent to the client from now on has to arrive after the map, so it is held back until the map
+    // has been encoded and queued in front of it.
+    connection->HoldPackets();
+    _pendingMaps.push_back({ connection, GetMapSnapshot(connection->RequestedObjects) });
+}
+
+std::shared_ptr<Network::MapSnapshot> Network::CreateMapSnapshot(
+    const std::vector<const ObjectRepositoryItem*>& objects, bool encodeInBackground)
+{
+    auto snapshot = std::make_shared<MapSnapshot>();
+    snapshot->Tick = gCurrentTicks;
+    snapshot->Objects = objects;
+    if (!SaveMap(*snapshot))
     {
-        size_t datasize = std::min(chunksize, out_size - i);
-        std::unique_ptr<NetworkPacket> packet(NetworkPacket::Allocate());
-        *packet << (uint32_t)NETWORK_COMMAND_MAP << (uint32_t)out_size << (uint32_t)i;
-        packet->Write(&header[i], datasize);
-        if (connection)
-        {
-            connection->QueuePacket(std::move(packet));
-        }
-        else
-        {
-            SendPacketToClients(*packet);
-        }
+        log_warning("Failed to export map.");
+        snapshot->IsEncoded = true;
+    }
+    else if (encodeInBackground)
+    {
+        // A thread of its own rather than a job pool job, so the long encode never holds up jobs the game waits for.
+        // The thread keeps the snapshot alive until it is done, even if every client waiting for it has left.
+        auto thread = std::thread([snapshot]() {
+            EncodeMapSnapshot(*snapshot);
+            snapshot->IsEncoded = true;
+        });
+        thread.detach();
     }
-    free(header);
+    else
+    {
+        EncodeMapSnapshot(*snapshot);
+        snapshot->IsEncoded = true;
+    }
+    _mapSnapshot = snapshot;
+    return snapshot;
 }
 
-uint8_t* Network::save_for_network(size_t& out_size, const std::vector<const ObjectRepositoryItem*>& objects) const
+std::shared_ptr<Network::MapSnapshot> Network::GetMapSnapshot(const std::vector<const ObjectRepositoryItem*>& objects)
+{
+    if (_mapSnapshot != nullptr && _mapSnapshot->Tick == gCurrentTicks && _mapSnapshot->Objects == objects)
+    {
+        return _mapSnapshot;
+    }
+    return CreateMapSnapshot(objects, true);
+}
+
+void Network::EncodeMapSnapshot(MapSnapshot& snapshot)
 {
-    uint8_t* header = nullptr;
-    out_size = 0;
     bool RLEState = gUseRLE;
     gUseRLE = false;
 
     auto ms = MemoryStream();
-    if (!SaveMap(&ms, objects))
+    try
+    {
+        snapshot.Exporter->SaveGame(&ms);
+        ms.Write(snapshot.NetworkData.GetData(), snapshot.NetworkData.GetLength());
+    }
+    catch (const std::exception&)
     {
+        gUseRLE = RLEState;
         log_warning("Failed to export map.");
-        return nullptr;
+        return;
     }
     gUseRLE = RLEState;
+    snapshot.Exporter = nullptr;
 
-    const void* data = ms.GetData();
-    int32_t size = ms.GetLength();
+    const uint8_t* data = (const uint8_t*)ms.GetData();
+    size_t size = (size_t)ms.GetLength();
 
-    uint8_t* compressed = util_zlib_deflate((const uint8_t*)data, size, &out_size);
+    size_t compressedSize;
+    uint8_t* compressed = util_zlib_deflate(data, size, &compressedSize);
     if (compressed != nullptr)
     {
-        header = (uint8_t*)_strdup("open2_sv6_zlib");
-        size_t header_len = strlen((char*)header) + 1; // account for null terminator
-        header = (uint8_t*)realloc(header, header_len + out_size);
-        if (header == nullptr)
-        {
-            log_error("Failed to allocate %u bytes.", header_len + out_size);
-        }
-        else
-        {
-            std::memcpy(&header[header_len], compressed, out_size);
-            out_size += header_len;
-            log_verbose("Sending map of size %u bytes, compressed to %u bytes", size, out_size);
-        }
+        const char* header = "open2_sv6_zlib";
+        size_t header_len = strlen(header) + 1; // account for null terminator
+        snapshot.Data.reserve(header_len + compressedSize);
+        snapshot.Data.insert(snapshot.Data.end(), header, header + header_len);
+        snapshot.Data.insert(snapshot.Data.end(), compressed, compressed + compressedSize);
+        log_verbose("Sending map of size %u bytes, compressed to %u bytes", size, snapshot.Data.size());
         free(compressed);
     }
     else
     {
         log_warning("Failed to compress the data, falling back to non-compressed sv6.");
-        header = (uint8_t*)malloc(size);
-        if (header == nullptr)
+        snapshot.Data.assign(data, data + size);
+    }
+}
+
+std::vector<std::unique_ptr<NetworkPacket>> Network::CreateMapPackets(const MapSnapshot& snapshot)
+{
+    std::vector<std::unique_ptr<NetworkPacket>> packets;
+    const auto& data = snapshot.Data;
+    size_t chunksize = 65000;
+    for (size_t i = 0; i < data.size(); i += chunksize)
+    {
+        size_t datasize = std::min(chunksize, data.size() - i);
+        std::unique_ptr<NetworkPacket> packet(NetworkPacket::Allocate(12 + datasize));
+        *packet << (uint32_t)NETWORK_COMMAND_MAP << (uint32_t)data.size() << (uint32_t)i;
+        packet->Write(&data[i], datasize);
+        packets.push_back(std::move(packet));
+    }
+    return packets;
+}
+
+void Network::UpdatePendingMaps()
+{
+    auto it = _pendingMaps.begin();
+    while (it != _pendingMaps.end())
+    {
+        const auto& snapshot = *it->Snapshot;
+        if (!snapshot.IsEncoded)
         {
-            log_error("Failed to allocate %u bytes.", size);
+            it++;
+            continue;
+        }
+
+        auto& connection = *it->Connection;
+        if (snapshot.Data.empty())
+        {
+            connection.SetLastDisconnectReason(STR_MULTIPLAYER_CONNECTION_CLOSED);
+            connection.Socket->Disconnect();
         }
         else
         {
-            out_size = size;
-            std::memcpy(header, data, size);
+            for (auto& packet : CreateMapPackets(snapshot))
+            {
+                connection.QueuePacketBeforeHeld(std::move(packet));
+            }
         }
+        connection.ReleaseHeldPackets();
+        it = _pendingMaps.erase(it);
     }
-    return header;
 }
 
 void Network::Client_Send_CHAT(const char* text)
@@ -1643,6 +1791,9 @@ void Network::Server_Send_GAMECMD(
     *packet << (uint32_t)NETWORK_COMMAND_GAMECMD << gCurrentTicks << eax << (ebx | GAME_COMMAND_FLAG_NETWORKED) << ecx << edx
             << esi << edi << ebp << playerid << callback;
     SendPacketToClients(*packet, false, true);
+
+    // The command has changed the game state, clients that join from now on need a new map.
+    _mapSnapshot = nullptr;
 }
 
 void Network::Client_Send_GAME_ACTION(const GameAction* action)
@@ -1668,14 +1819,18 @@ void Network::Client_Send_GAME_ACTION(const GameAction* action)
 
 void Network::Server_Send_GAME_ACTION(const GameAction* action)
 {
-    std::unique_ptr<NetworkPacket> packet(NetworkPacket::Allocate());
-
     DataSerialiser stream(true);
     action->Serialise(stream);
 
+    // Command, tick and action type, followed by the action itself
+    std::unique_ptr<NetworkPacket> packet(NetworkPacket::Allocate(12 + (size_t)stream.GetStream().GetLength()));
+
     *packet << (uint32_t)NETWORK_COMMAND_GAME_ACTION << gCurrentTicks << action->GetType() << stream;
 
     SendPacketToClients(*packet);
+
+    // The action has changed the game state, clients that join from now on need a new map.
+    _mapSnapshot = nullptr;
 }
 
 void Network::Server_Send_TICK()
@@ -1700,11 +1855,18 @@ void Network::Server_Send_TICK()
     {
         checksum_counter = 0;
         flags |= NETWORK_TICK_FLAG_CHECKSUMS;
+#    ifdef NETWORK_VERIFY_SPRITE_CHECKSUMS
+        flags |= NETWORK_TICK_FLAG_FULL_CHECKSUMS;
+#    endif
     }
     // Send flags always, so we can understand packet structure on the other end,
     // and allow for some expansion.
     *packet << flags;
     if (flags & NETWORK_TICK_FLAG_CHECKSUMS)
+    {
+        packet->WriteString(network_get_sprite_checksum().c_str());
+    }
+    if (flags & NETWORK_TICK_FLAG_FULL_CHECKSUMS)
     {
         rct_sprite_checksum checksum = sprite_checksum();
         packet->WriteString(checksum.ToString().c_str());
@@ -2067,6 +2229,10 @@ void Network::AddClient(std::unique_ptr<ITcpSocket>&& socket)
     // Store connection
     auto connection = std::make_unique<NetworkConnection>();
     connection->Socket = std::move(socket);
+    if (_ioThread != nullptr)
+    {
+        _ioThread->AddConnection(*connection);
+    }
 
     client_connection_list.push_back(std::move(connection));
 }
@@ -2111,6 +2277,11 @@ void Network::RemoveClient(std::unique_ptr<NetworkConnection>& connection)
             player_list.begin(), player_list.end(),
             [connection_player](std::unique_ptr<NetworkPlayer>& player) { return player.get() == connection_player; }),
         player_list.end());
+    _pendingMaps.remove_if([&connection](const PendingMap& pending) { return pending.Connection == connection.get(); });
+    if (_ioThread != nullptr)
+    {
+        _ioThread->RemoveConnection(*connection);
+    }
     client_connection_list.remove(connection);
     if (gConfigNetwork.pause_server_if_no_clients && game_is_not_paused() && client_connection_list.size() == 0)
     {
@@ -2284,8 +2455,16 @@ void Network::Client_Handle_AUTH(NetworkConnection& connection, NetworkPacket& p
     switch (connection.AuthStatus)
     {
         case NETWORK_AUTH_OK:
+        {
+            uint8_t compression;
+            packet >> compression;
+            if (compression == NETWORK_COMPRESSION_ZLIB)
+            {
+                connection.SetCompression(NETWORK_COMPRESSION_ZLIB);
+            }
             Client_Send_GAMEINFO();
             break;
+        }
         case NETWORK_AUTH_BADNAME:
             connection.SetLastDisconnectReason(STR_MULTIPLAYER_BAD_PLAYER_NAME);
             connection.Socket->Disconnect();
@@ -2453,6 +2632,7 @@ void Network::Server_Handle_AUTH(NetworkConnection& connection, NetworkPacket& p
         const char* pubkey = packet.ReadString();
         uint32_t sigsize;
         packet >> sigsize;
+        uint8_t supportedCompression = 0;
         if (pubkey == nullptr)
         {
             connection.AuthStatus = NETWORK_AUTH_VERIFICATIONFAILURE;
@@ -2466,6 +2646,7 @@ void Network::Server_Handle_AUTH(NetworkConnection& connection, NetworkPacket& p
                 {
                     throw std::runtime_error("Failed to read packet.");
                 }
+                packet >> supportedCompression;
 
                 auto ms = MemoryStream(pubkey, strlen(pubkey));
                 if (!connection.Key.LoadPublic(&ms))
@@ -2542,6 +2723,11 @@ void Network::Server_Handle_AUTH(NetworkConnection& connection, NetworkPacket& p
         {
             log_error("Unknown failure (%d) while authenticating client", connection.AuthStatus);
         }
+        if (connection.AuthStatus == NETWORK_AUTH_OK && gConfigNetwork.packet_compression
+            && (supportedCompression & (1 << NETWORK_COMPRESSION_ZLIB)))
+        {
+            connection.SetCompression(NETWORK_COMPRESSION_ZLIB);
+        }
         Server_Send_AUTH(connection);
     }
 }
@@ -2639,13 +2825,14 @@ bool Network::LoadMap(IStream* stream)
         objManager.LoadObjects(loadResult.RequiredObjects.data(), loadResult.RequiredObjects.size());
         importer->Import();
 
-        sprite_position_tween_reset();
-
         // Read checksum
         [[maybe_unused]] uint32_t checksum = stream->ReadValue<uint32_t>();
 
         // Read other data not in normal save files
         stream->Read(gSpriteSpatialIndex, 0x10001 * sizeof(uint16_t));
+        sprite_read_extended_pool(stream);
+        sprite_spatial_index_sync();
+        sprite_position_tween_reset();
         gGamePaused = stream->ReadValue<uint32_t>();
         _guestGenerationProbability = stream->ReadValue<uint32_t>();
         _suggestedGuestMaximum = stream->ReadValue<uint32_t>();
@@ -2680,19 +2867,23 @@ bool Network::LoadMap(IStream* stream)
     return result;
 }
 
-bool Network::SaveMap(IStream* stream, const std::vector<const ObjectRepositoryItem*>& objects) const
+bool Network::SaveMap(MapSnapshot& snapshot) const
 {
     bool result = false;
     viewport_set_saved_view();
     try
     {
-        auto s6exporter = std::make_unique<S6Exporter>();
-        s6exporter->ExportObjectsList = objects;
-        s6exporter->Export();
-        s6exporter->SaveGame(stream);
+        // Only copy the game state here, it is encoded later by EncodeMapSnapshot
+        snapshot.Exporter = std::make_unique<S6Exporter>();
+        snapshot.Exporter->ExportObjectsList = snapshot.Objects;
+        snapshot.Exporter->ExtendedSpritePoolFollows = true;
+        snapshot.Exporter->Export();
+        snapshot.Exporter->ExportPackedObjects();
 
         // Write other data not in normal save files
+        auto stream = &snapshot.NetworkData;
         stream->Write(gSpriteSpatialIndex, 0x10001 * sizeof(uint16_t));
+        sprite_write_extended_pool(stream);
         stream->WriteValue<uint32_t>(gGamePaused);
         stream->WriteValue<uint32_t>(_guestGenerationProbability);
         stream->WriteValue<uint32_t>(_suggestedGuestMaximum);
@@ -2958,6 +3149,7 @@ void Network::Client_Handle_TICK([[maybe_unused]] NetworkConnection& connection,
         server_srand0 = srand0;
         server_srand0_tick = server_tick;
         server_sprite_hash.resize(0);
+        server_sprite_full_hash.resize(0);
         if (flags & NETWORK_TICK_FLAG_CHECKSUMS)
         {
             const char* text = packet.ReadString();
@@ -2968,6 +3160,14 @@ void Network::Client_Handle_TICK([[maybe_unused]] NetworkConnection& connection,
                 std::memcpy(server_sprite_hash.data(), text, textLen);
             }
         }
+        if (flags & NETWORK_TICK_FLAG_FULL_CHECKSUMS)
+        {
+            const char* text = packet.ReadString();
+            if (text != nullptr)
+            {
+                server_sprite_full_hash = text;
+            }
+        }
     }
     game_commands_processed_this_tick = 0;
 }
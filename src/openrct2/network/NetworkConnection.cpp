@@ -17,7 +17,14 @@
 #    include "TcpSocket.h"
 #    include "network.h"
 
+#    include <algorithm>
+#    include <cstring>
+
 constexpr size_t NETWORK_DISCONNECT_REASON_BUFFER_SIZE = 256;
+// Packets smaller than this are sent as they are, the little they would shrink is not worth compressing them for.
+constexpr size_t NETWORK_COMPRESSION_THRESHOLD = 512;
+// The most bytes gathered for a single send, a connection that is sending a map has far more than this queued.
+constexpr size_t NETWORK_SEND_BATCH_SIZE = 64 * 1024;
 
 NetworkConnection::NetworkConnection()
 {
@@ -31,11 +38,99 @@ NetworkConnection::~NetworkConnection()
 
 int32_t NetworkConnection::ReadPacket()
 {
-    if (InboundPacket.BytesTransferred < sizeof(InboundPacket.Size))
+    int32_t status;
+    if (_receiveOnIoThread)
+    {
+        // Check whether the connection is closed first, all of its packets are in the queue by then.
+        bool receivedAll = _receivedAll.load(std::memory_order_acquire);
+        std::unique_ptr<NetworkPacket> packet;
+        if (_receivedPackets.TryPop(packet))
+        {
+            _numReceivedPackets.fetch_sub(1, std::memory_order_relaxed);
+            InboundPacket = std::move(*packet);
+            status = NETWORK_READPACKET_SUCCESS;
+        }
+        else
+        {
+            status = receivedAll ? NETWORK_READPACKET_DISCONNECTED : NETWORK_READPACKET_NO_DATA;
+        }
+    }
+    else
+    {
+        status = ReceivePacket(InboundPacket);
+    }
+
+    if (status == NETWORK_READPACKET_SUCCESS)
+    {
+        _lastPacketTime = platform_get_ticks();
+
+        RecordPacketStats(InboundPacket, false);
+
+        if (InboundPacket.IsCompressed())
+        {
+            size_t compressedSize = InboundPacket.Size;
+            if (!InboundPacket.Decompress())
+            {
+                log_warning("Received a compressed packet that could not be decompressed.");
+                return NETWORK_READPACKET_DISCONNECTED;
+            }
+            Stats.bytesSavedReceived += InboundPacket.Size - compressedSize;
+        }
+    }
+    return status;
+}
+
+void NetworkConnection::ReceiveOnIoThread()
+{
+    _receiveOnIoThread = true;
+}
+
+bool NetworkConnection::ReceivePackets(size_t maxPackets)
+{
+    try
+    {
+        size_t numPackets = 0;
+        while (numPackets < maxPackets)
+        {
+            switch (ReceivePacket(_ioInboundPacket))
+            {
+                case NETWORK_READPACKET_SUCCESS:
+                    _receivedPackets.Push(std::make_unique<NetworkPacket>(std::move(_ioInboundPacket)));
+                    _numReceivedPackets.fetch_add(1, std::memory_order_relaxed);
+                    _ioInboundPacket = NetworkPacket();
+                    numPackets++;
+                    break;
+                case NETWORK_READPACKET_MORE_DATA:
+                    break;
+                case NETWORK_READPACKET_NO_DATA:
+                    return true;
+                default:
+                    _receivedAll.store(true, std::memory_order_release);
+                    return false;
+            }
+        }
+        return true;
+    }
+    catch (const std::exception& ex)
+    {
+        log_error("Failed to receive from client: %s", ex.what());
+        _receivedAll.store(true, std::memory_order_release);
+        return false;
+    }
+}
+
+size_t NetworkConnection::GetNumReceivedPackets() const
+{
+    return _numReceivedPackets.load(std::memory_order_relaxed);
+}
+
+int32_t NetworkConnection::ReceivePacket(NetworkPacket& packet)
+{
+    if (packet.BytesTransferred < sizeof(packet.Size))
     {
         // read packet size
-        void* buffer = &((char*)&InboundPacket.Size)[InboundPacket.BytesTransferred];
-        size_t bufferLength = sizeof(InboundPacket.Size) - InboundPacket.BytesTransferred;
+        void* buffer = &((char*)&packet.Size)[packet.BytesTransferred];
+        size_t bufferLength = sizeof(packet.Size) - packet.BytesTransferred;
         size_t readBytes;
         NETWORK_READPACKET status = Socket->ReceiveData(buffer, bufferLength, &readBytes);
         if (status != NETWORK_READPACKET_SUCCESS)
@@ -43,24 +138,24 @@ int32_t NetworkConnection::ReadPacket()
             return status;
         }
 
-        InboundPacket.BytesTransferred += readBytes;
-        if (InboundPacket.BytesTransferred == sizeof(InboundPacket.Size))
+        packet.BytesTransferred += readBytes;
+        if (packet.BytesTransferred == sizeof(packet.Size))
         {
-            InboundPacket.Size = Convert::NetworkToHost(InboundPacket.Size);
-            if (InboundPacket.Size == 0) // Can't have a size 0 packet
+            packet.Size = Convert::NetworkToHost(packet.Size);
+            if (packet.Size == 0) // Can't have a size 0 packet
             {
                 return NETWORK_READPACKET_DISCONNECTED;
             }
-            InboundPacket.Data->resize(InboundPacket.Size);
+            packet.Data->resize(packet.Size);
         }
     }
     else
     {
         // read packet data
-        if (InboundPacket.Data->capacity() > 0)
+        if (packet.Data->capacity() > 0)
         {
-            void* buffer = &InboundPacket.GetData()[InboundPacket.BytesTransferred - sizeof(InboundPacket.Size)];
-            size_t bufferLength = sizeof(InboundPacket.Size) + InboundPacket.Size - InboundPacket.BytesTransferred;
+            void* buffer = &packet.GetData()[packet.BytesTransferred - sizeof(packet.Size)];
+            size_t bufferLength = sizeof(packet.Size) + packet.Size - packet.BytesTransferred;
             size_t readBytes;
             NETWORK_READPACKET status = Socket->ReceiveData(buffer, bufferLength, &readBytes);
             if (status != NETWORK_READPACKET_SUCCESS)
@@ -68,75 +163,234 @@ int32_t NetworkConnection::ReadPacket()
                 return status;
             }
 
-            InboundPacket.BytesTransferred += readBytes;
+            packet.BytesTransferred += readBytes;
         }
-        if (InboundPacket.BytesTransferred == sizeof(InboundPacket.Size) + InboundPacket.Size)
+        if (packet.BytesTransferred == sizeof(packet.Size) + packet.Size)
         {
-            _lastPacketTime = platform_get_ticks();
-
-            RecordPacketStats(InboundPacket, false);
-
             return NETWORK_READPACKET_SUCCESS;
         }
     }
     return NETWORK_READPACKET_MORE_DATA;
 }
 
-bool NetworkConnection::SendPacket(NetworkPacket& packet)
+void NetworkConnection::QueuePacket(std::unique_ptr<NetworkPacket> packet, bool front)
 {
-    uint16_t sizen = Convert::HostToNetwork(packet.Size);
-    std::vector<uint8_t> tosend;
-    tosend.reserve(sizeof(sizen) + packet.Size);
-    tosend.insert(tosend.end(), (uint8_t*)&sizen, (uint8_t*)&sizen + sizeof(sizen));
-    tosend.insert(tosend.end(), packet.Data->begin(), packet.Data->end());
+    CompressPacket(packet);
+    QueuePacket(*packet, front);
+}
 
-    const void* buffer = &tosend[packet.BytesTransferred];
-    size_t bufferSize = tosend.size() - packet.BytesTransferred;
-    size_t sent = Socket->SendData(buffer, bufferSize);
-    if (sent > 0)
+void NetworkConnection::QueuePacket(const NetworkPacket& packet, bool front)
+{
+    if (front)
+    {
+        PushPacket(_priorityPackets, packet);
+    }
+    else if (_holdingPackets)
     {
-        packet.BytesTransferred += sent;
+        PushPacket(_heldPackets, packet);
     }
+    else
+    {
+        PushPacket(_outboundPackets, packet);
+    }
+}
 
-    bool sendComplete = packet.BytesTransferred == tosend.size();
-    if (sendComplete)
+void NetworkConnection::PushPacket(OutboundQueue& queue, const NetworkPacket& packet)
+{
+    if (AuthStatus == NETWORK_AUTH_OK || !packet.CommandRequiresAuth())
     {
-        RecordPacketStats(packet, true);
+        if (packet.IsCompressed())
+        {
+            Stats.bytesSavedSent += packet.GetUncompressedSize() - packet.Data->size();
+        }
+        queue.Push(packet);
+        UpdateQueueStats();
     }
-    return sendComplete;
 }
 
-void NetworkConnection::QueuePacket(std::unique_ptr<NetworkPacket> packet, bool front)
+void NetworkConnection::HoldPackets()
+{
+    _holdingPackets = true;
+}
+
+void NetworkConnection::QueuePacketBeforeHeld(std::unique_ptr<NetworkPacket> packet)
+{
+    CompressPacket(packet);
+    PushPacket(_outboundPackets, *packet);
+}
+
+void NetworkConnection::ReleaseHeldPackets()
+{
+    _outboundPackets.Append(_heldPackets);
+    _holdingPackets = false;
+    UpdateQueueStats();
+}
+
+bool NetworkConnection::IsHoldingPackets() const
+{
+    return _holdingPackets;
+}
+
+void NetworkConnection::SendQueuedPackets()
 {
-    if (AuthStatus == NETWORK_AUTH_OK || !packet->CommandRequiresAuth())
+    while (_priorityPackets.GetSize() + _outboundPackets.GetSize() > 0)
     {
-        packet->Size = (uint16_t)packet->Data->size();
-        if (front)
+        // Priority packets are sent after the rest of a packet that has been sent partially, and before any other
+        // packet. Each send takes a batch of the queued packets, the next batch follows if all of it was sent.
+        _sendBuffers.clear();
+        size_t restOfFirstPacket = _outboundPackets.GetRestOfFirstPacket();
+        size_t numBytes = _outboundPackets.GetBuffers(0, restOfFirstPacket, _sendBuffers);
+        numBytes += _priorityPackets.GetBuffers(
+            0, std::min(_priorityPackets.GetSize(), NETWORK_SEND_BATCH_SIZE - std::min(numBytes, NETWORK_SEND_BATCH_SIZE)),
+            _sendBuffers);
+        numBytes += _outboundPackets.GetBuffers(
+            restOfFirstPacket,
+            std::min(
+                _outboundPackets.GetSize() - restOfFirstPacket,
+                NETWORK_SEND_BATCH_SIZE - std::min(numBytes, NETWORK_SEND_BATCH_SIZE)),
+            _sendBuffers);
+
+        size_t sent = Socket->SendData(_sendBuffers.data(), _sendBuffers.size());
+        size_t remaining = sent;
+        remaining -= _outboundPackets.Pop(std::min(remaining, restOfFirstPacket), Stats);
+        remaining -= _priorityPackets.Pop(remaining, Stats);
+        _outboundPackets.Pop(remaining, Stats);
+        UpdateQueueStats();
+        if (sent < numBytes)
         {
-            // If the first packet was already partially sent add new packet to second position
-            if (!_outboundPackets.empty() && _outboundPackets.front()->BytesTransferred > 0)
-            {
-                auto it = _outboundPackets.begin();
-                it++; // Second position
-                _outboundPackets.insert(it, std::move(packet));
-            }
-            else
-            {
-                _outboundPackets.push_front(std::move(packet));
-            }
+            break;
         }
-        else
+    }
+}
+
+void NetworkConnection::UpdateQueueStats()
+{
+    Stats.queuedPackets = _priorityPackets.GetNumPackets() + _outboundPackets.GetNumPackets() + _heldPackets.GetNumPackets();
+    Stats.queuedBytes = _priorityPackets.GetSize() + _outboundPackets.GetSize() + _heldPackets.GetSize();
+}
+
+void NetworkConnection::OutboundQueue::Push(const NetworkPacket& packet)
+{
+    QueuedPacket queuedPacket;
+    queuedPacket.NetworkSize = Convert::HostToNetwork((uint16_t)packet.Data->size());
+    queuedPacket.TrafficGroup = GetTrafficGroup(packet.GetCommand());
+    queuedPacket.Data = packet.Data;
+    _size += queuedPacket.GetLength();
+    _packets.push_back(std::move(queuedPacket));
+}
+
+void NetworkConnection::OutboundQueue::Append(OutboundQueue& other)
+{
+    for (auto& packet : other._packets)
+    {
+        _packets.push_back(std::move(packet));
+    }
+    _size += other._size;
+    other._packets.clear();
+    other._size = 0;
+}
+
+/**
+ * Adds the part of the given bytes that lies within the range, skip is the number of bytes before the range starts.
+ */
+static void AddSendBuffer(const void* data, size_t size, size_t& skip, size_t& length, std::vector<SocketBuffer>& buffers)
+{
+    if (skip >= size)
+    {
+        skip -= size;
+        return;
+    }
+    size_t part = std::min(size - skip, length);
+    if (part > 0)
+    {
+        buffers.push_back({ (const uint8_t*)data + skip, part });
+    }
+    skip = 0;
+    length -= part;
+}
+
+size_t NetworkConnection::OutboundQueue::GetBuffers(size_t offset, size_t length, std::vector<SocketBuffer>& buffers) const
+{
+    length = std::min(length, _size - std::min(offset, _size));
+    size_t total = length;
+    size_t skip = _firstPacketSent + offset;
+    for (auto it = _packets.begin(); it != _packets.end() && length > 0; it++)
+    {
+        // The size is sent from the queued packet itself, the deque never moves its elements.
+        AddSendBuffer(&it->NetworkSize, sizeof(it->NetworkSize), skip, length, buffers);
+        AddSendBuffer(it->Data->data(), it->Data->size(), skip, length, buffers);
+    }
+    return total;
+}
+
+size_t NetworkConnection::OutboundQueue::Pop(size_t length, NetworkStats_t& stats)
+{
+    length = std::min(length, _size);
+    size_t remaining = length;
+    while (remaining > 0)
+    {
+        const auto& packet = _packets.front();
+        size_t packetLength = packet.GetLength();
+        size_t packetSent = std::min(remaining, packetLength - _firstPacketSent);
+        _firstPacketSent += packetSent;
+        remaining -= packetSent;
+        if (_firstPacketSent == packetLength)
         {
-            _outboundPackets.push_back(std::move(packet));
+            stats.bytesSent[packet.TrafficGroup] += packetLength;
+            stats.bytesSent[NETWORK_STATISTICS_GROUP_TOTAL] += packetLength;
+            _packets.pop_front();
+            _firstPacketSent = 0;
         }
     }
+    _size -= length;
+    return length;
 }
 
-void NetworkConnection::SendQueuedPackets()
+size_t NetworkConnection::OutboundQueue::GetSize() const
+{
+    return _size;
+}
+
+size_t NetworkConnection::OutboundQueue::GetNumPackets() const
+{
+    return _packets.size();
+}
+
+size_t NetworkConnection::OutboundQueue::GetRestOfFirstPacket() const
+{
+    return _firstPacketSent == 0 ? 0 : _packets.front().GetLength() - _firstPacketSent;
+}
+
+void NetworkConnection::SetCompression(NETWORK_COMPRESSION compression)
+{
+    _compression = compression;
+}
+
+NETWORK_COMPRESSION NetworkConnection::GetCompression() const
 {
-    while (!_outboundPackets.empty() && SendPacket(*_outboundPackets.front()))
+    return _compression;
+}
+
+bool NetworkConnection::ShouldCompress(const NetworkPacket& packet)
+{
+    // Map data is compressed as a whole before it is split into packets.
+    return packet.Data->size() >= NETWORK_COMPRESSION_THRESHOLD && !packet.IsCompressed()
+        && packet.GetCommand() != NETWORK_COMMAND_MAP;
+}
+
+void NetworkConnection::CompressPacket(std::unique_ptr<NetworkPacket>& packet)
+{
+    if (_compression == NETWORK_COMPRESSION_NONE)
     {
-        _outboundPackets.remove(_outboundPackets.front());
+        return;
+    }
+    if (ShouldCompress(*packet))
+    {
+        auto compressed = NetworkPacket::Compress(*packet);
+        if (compressed != nullptr)
+        {
+            packet = std::move(compressed);
+        }
     }
 }
 
@@ -184,21 +438,24 @@ void NetworkConnection::SetLastDisconnectReason(const rct_string_id string_id, v
     SetLastDisconnectReason(buffer);
 }
 
-void NetworkConnection::RecordPacketStats(const NetworkPacket& packet, bool sending)
+uint32_t NetworkConnection::GetTrafficGroup(int32_t command)
 {
-    uint32_t packetSize = (uint32_t)packet.BytesTransferred;
-    uint32_t trafficGroup = NETWORK_STATISTICS_GROUP_BASE;
-
-    switch (packet.GetCommand())
+    switch (command)
     {
         case NETWORK_COMMAND_GAMECMD:
         case NETWORK_COMMAND_GAME_ACTION:
-            trafficGroup = NETWORK_STATISTICS_GROUP_COMMANDS;
-            break;
+            return NETWORK_STATISTICS_GROUP_COMMANDS;
         case NETWORK_COMMAND_MAP:
-            trafficGroup = NETWORK_STATISTICS_GROUP_MAPDATA;
-            break;
+            return NETWORK_STATISTICS_GROUP_MAPDATA;
+        default:
+            return NETWORK_STATISTICS_GROUP_BASE;
     }
+}
+
+void NetworkConnection::RecordPacketStats(const NetworkPacket& packet, bool sending)
+{
+    uint32_t packetSize = (uint32_t)packet.BytesTransferred;
+    uint32_t trafficGroup = GetTrafficGroup(packet.GetCommand());
 
     if (sending)
     {
@@ -11,12 +11,14 @@
 
 #ifndef DISABLE_NETWORK
 #    include "../common.h"
+#    include "../core/SpscQueue.h"
 #    include "NetworkKey.h"
 #    include "NetworkPacket.h"
 #    include "NetworkTypes.h"
 #    include "TcpSocket.h"
 
-#    include <list>
+#    include <atomic>
+#    include <deque>
 #    include <memory>
 #    include <vector>
 
@@ -40,8 +42,49 @@ public:
     ~NetworkConnection();
 
     int32_t ReadPacket();
+
+    /**
+     * Makes ReadPacket take the packets received by ReceivePackets rather than reading from the socket itself.
+     */
+    void ReceiveOnIoThread();
+    /**
+     * Reads what the socket has received and queues the complete packets for ReadPacket, without blocking. Stops after
+     * maxPackets packets, leaving the rest in the socket. Together with GetNumReceivedPackets, this is all that may be
+     * called from the I/O thread. Returns false once the connection is closed.
+     */
+    bool ReceivePackets(size_t maxPackets);
+    /**
+     * The number of packets queued by ReceivePackets that ReadPacket has not taken yet.
+     */
+    size_t GetNumReceivedPackets() const;
     void QueuePacket(std::unique_ptr<NetworkPacket> packet, bool front = false);
+    /**
+     * Queues a packet whose data is shared with other connections. It is sent as it is, so it must already be
+     * compressed if this connection should receive it compressed, and its data must not be written to any more.
+     */
+    void QueuePacket(const NetworkPacket& packet, bool front = false);
     void SendQueuedPackets();
+
+    /**
+     * Holds back the packets queued from now on, other than the ones queued to the front, until
+     * ReleaseHeldPackets is called. Packets queued with QueuePacketBeforeHeld in the meantime are sent before them.
+     */
+    void HoldPackets();
+    void QueuePacketBeforeHeld(std::unique_ptr<NetworkPacket> packet);
+    void ReleaseHeldPackets();
+    bool IsHoldingPackets() const;
+
+    /**
+     * Sets the compression both sides have agreed on, packets that are worth compressing are compressed from now on.
+     * Compressed packets are always accepted.
+     */
+    void SetCompression(NETWORK_COMPRESSION compression);
+    NETWORK_COMPRESSION GetCompression() const;
+    /**
+     * Whether the packet is large enough, and not compressed already, for compressing it to pay off.
+     */
+    static bool ShouldCompress(const NetworkPacket& packet);
+
     void ResetLastPacketTime();
     bool ReceivedPacketRecently();
 
@@ -50,12 +93,66 @@ public:
     void SetLastDisconnectReason(const rct_string_id string_id, void* args = nullptr);
 
 private:
-    std::list<std::unique_ptr<NetworkPacket>> _outboundPackets;
+    /**
+     * Packets waiting to be sent. Only the framing of each packet, its size in network byte order, is kept per
+     * connection, the data is referenced rather than copied so a packet sent to every client is only stored once.
+     * Any number of queued packets can be handed to the socket in a single gathered send.
+     */
+    class OutboundQueue
+    {
+    public:
+        void Push(const NetworkPacket& packet);
+        // Moves every packet of the other queue, which must not have been sent partially, to the back of this one.
+        void Append(OutboundQueue& other);
+        // Adds the buffers holding the given range of queued bytes and returns the number of bytes they hold.
+        size_t GetBuffers(size_t offset, size_t length, std::vector<SocketBuffer>& buffers) const;
+        size_t Pop(size_t length, NetworkStats_t& stats);
+        size_t GetSize() const;
+        size_t GetNumPackets() const;
+        // The number of bytes that have to be sent before the next packet starts.
+        size_t GetRestOfFirstPacket() const;
+
+    private:
+        struct QueuedPacket
+        {
+            uint16_t NetworkSize;
+            uint32_t TrafficGroup;
+            std::shared_ptr<const std::vector<uint8_t>> Data;
+
+            size_t GetLength() const
+            {
+                return sizeof(NetworkSize) + Data->size();
+            }
+        };
+
+        std::deque<QueuedPacket> _packets;
+        size_t _size = 0;
+        size_t _firstPacketSent = 0;
+    };
+
+    OutboundQueue _outboundPackets;
+    // Packets queued to the front, these are sent as soon as the packet being sent has been sent completely.
+    OutboundQueue _priorityPackets;
+    OutboundQueue _heldPackets;
+    bool _holdingPackets = false;
+    std::vector<SocketBuffer> _sendBuffers;
+    NETWORK_COMPRESSION _compression = NETWORK_COMPRESSION_NONE;
+    bool _receiveOnIoThread = false;
+    // The packet being read on the I/O thread, and the complete packets waiting to be processed.
+    NetworkPacket _ioInboundPacket;
+    SpscQueue<std::unique_ptr<NetworkPacket>> _receivedPackets;
+    std::atomic<size_t> _numReceivedPackets = { 0 };
+    // Set by the I/O thread once it has queued the last packet of a closed connection.
+    std::atomic<bool> _receivedAll = { false };
     uint32_t _lastPacketTime = 0;
     utf8* _lastDisconnectReason = nullptr;
 
+    int32_t ReceivePacket(NetworkPacket& packet);
+    void CompressPacket(std::unique_ptr<NetworkPacket>& packet);
+    void PushPacket(OutboundQueue& queue, const NetworkPacket& packet);
     void RecordPacketStats(const NetworkPacket& packet, bool sending);
-    bool SendPacket(NetworkPacket& packet);
+    void UpdateQueueStats();
+    static uint32_t GetTrafficGroup(int32_t command);
 };
 
 #endif // DISABLE_NETWORK
@@ -0,0 +1,149 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#ifndef DISABLE_NETWORK
+
+#    include "NetworkIoThread.h"
+
+#    include "NetworkConnection.h"
+
+#    include <algorithm>
+
+// The number of readable sockets handled per wait.
+constexpr size_t NETWORK_IO_MAX_EVENTS = 64;
+// The number of packets read from a socket per wait. Sockets stay readable until they are read completely, so the
+// rest is read after the other sockets have had their turn.
+constexpr size_t NETWORK_IO_MAX_PACKETS_PER_READ = 32;
+// The number of received packets a connection can have waiting for the game thread before its socket is no longer
+// read. It is read again once half of them have been processed.
+constexpr size_t NETWORK_IO_MAX_RECEIVED_PACKETS = 1024;
+// How often the I/O thread checks whether paused connections can be read again, in milliseconds.
+constexpr int32_t NETWORK_IO_RESUME_INTERVAL = 10;
+
+std::unique_ptr<NetworkIoThread> NetworkIoThread::Create(ITcpSocket& listenSocket)
+{
+    auto poller = CreateSocketPoller();
+    if (poller == nullptr)
+    {
+        return nullptr;
+    }
+    return std::make_unique<NetworkIoThread>(listenSocket, std::move(poller));
+}
+
+NetworkIoThread::NetworkIoThread(ITcpSocket& listenSocket, std::unique_ptr<ISocketPoller> poller)
+    : _listenSocket(listenSocket)
+    , _poller(std::move(poller))
+{
+    _poller->Add(_listenSocket, &_listenSocket);
+    _thread = std::thread([this]() { Run(); });
+}
+
+NetworkIoThread::~NetworkIoThread()
+{
+    _stop = true;
+    _poller->Interrupt();
+    _thread.join();
+}
+
+std::unique_ptr<ITcpSocket> NetworkIoThread::Accept()
+{
+    std::unique_ptr<ITcpSocket> socket;
+    _acceptedSockets.TryPop(socket);
+    return socket;
+}
+
+void NetworkIoThread::AddConnection(NetworkConnection& connection)
+{
+    // If the socket cannot be watched, ReadPacket keeps reading from it on the game thread.
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_poller->Add(*connection.Socket, &connection))
+    {
+        connection.ReceiveOnIoThread();
+        _connections.insert(&connection);
+    }
+}
+
+void NetworkIoThread::RemoveConnection(NetworkConnection& connection)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_connections.erase(&connection) != 0 && _pausedConnections.erase(&connection) == 0)
+    {
+        _poller->Remove(*connection.Socket);
+    }
+}
+
+void NetworkIoThread::Run()
+{
+    void* readySockets[NETWORK_IO_MAX_EVENTS];
+    while (!_stop)
+    {
+        int32_t timeout = _pausedConnections.empty() ? -1 : NETWORK_IO_RESUME_INTERVAL;
+        size_t numReadySockets = _poller->Wait(readySockets, NETWORK_IO_MAX_EVENTS, timeout);
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        ResumeConnections();
+        for (size_t i = 0; i < numReadySockets; i++)
+        {
+            if (readySockets[i] == &_listenSocket)
+            {
+                for (auto socket = _listenSocket.Accept(); socket != nullptr; socket = _listenSocket.Accept())
+                {
+                    _acceptedSockets.Push(std::move(socket));
+                }
+                continue;
+            }
+
+            // The connection may have been removed after the wait returned, in which case it is not read.
+            auto connection = static_cast<NetworkConnection*>(readySockets[i]);
+            if (_connections.count(connection) == 0)
+            {
+                continue;
+            }
+
+            size_t numReceivedPackets = connection->GetNumReceivedPackets();
+            size_t maxPackets = std::min(NETWORK_IO_MAX_PACKETS_PER_READ, NETWORK_IO_MAX_RECEIVED_PACKETS - numReceivedPackets);
+            if (!connection->ReceivePackets(maxPackets))
+            {
+                // The game thread removes the connection once it has processed all of its packets.
+                _poller->Remove(*connection->Socket);
+                _connections.erase(connection);
+            }
+            else if (connection->GetNumReceivedPackets() >= NETWORK_IO_MAX_RECEIVED_PACKETS)
+            {
+                _poller->Remove(*connection->Socket);
+                _pausedConnections.insert(connection);
+            }
+        }
+    }
+}
+
+/**
+ * Watches the sockets of the paused connections again once the game thread has processed enough of their packets.
+ */
+void NetworkIoThread::ResumeConnections()
+{
+    for (auto it = _pausedConnections.begin(); it != _pausedConnections.end();)
+    {
+        auto connection = *it;
+        if (connection->GetNumReceivedPackets() > NETWORK_IO_MAX_RECEIVED_PACKETS / 2)
+        {
+            it++;
+            continue;
+        }
+
+        it = _pausedConnections.erase(it);
+        if (!_poller->Add(*connection->Socket, connection))
+        {
+            // Nothing more is received, the connection times out on the game thread.
+            _connections.erase(connection);
+        }
+    }
+}
+
+#endif // DISABLE_NETWORK
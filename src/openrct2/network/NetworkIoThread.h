@@ -0,0 +1,73 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#ifndef DISABLE_NETWORK
+#    include "../common.h"
+#    include "../core/SpscQueue.h"
+#    include "TcpSocket.h"
+
+#    include <atomic>
+#    include <memory>
+#    include <mutex>
+#    include <thread>
+#    include <unordered_set>
+
+class NetworkConnection;
+
+/**
+ * Receives data for the server on a thread of its own, which sleeps until a socket becomes readable instead of
+ * every socket being polled each tick. New clients are accepted and complete packets are read on that thread,
+ * the game thread picks them up with Accept and NetworkConnection::ReadPacket without ever waiting for it.
+ */
+class NetworkIoThread final
+{
+private:
+    ITcpSocket& _listenSocket;
+    std::unique_ptr<ISocketPoller> _poller;
+    SpscQueue<std::unique_ptr<ITcpSocket>> _acceptedSockets;
+
+    // Held by the I/O thread while it reads, so connections are never removed while they are being read.
+    std::mutex _mutex;
+    std::unordered_set<NetworkConnection*> _connections;
+    // Connections whose received packets are piling up, their sockets are not watched until the game thread has
+    // caught up with them.
+    std::unordered_set<NetworkConnection*> _pausedConnections;
+
+    std::atomic<bool> _stop = { false };
+    std::thread _thread;
+
+public:
+    /**
+     * Starts the I/O thread for the given listening socket, or returns nullptr if there is no socket poller for this
+     * platform. The listening socket must outlive the I/O thread.
+     */
+    static std::unique_ptr<NetworkIoThread> Create(ITcpSocket& listenSocket);
+
+    NetworkIoThread(ITcpSocket& listenSocket, std::unique_ptr<ISocketPoller> poller);
+    ~NetworkIoThread();
+
+    /**
+     * Returns the next client that has connected, or nullptr if there is none.
+     */
+    std::unique_ptr<ITcpSocket> Accept();
+
+    void AddConnection(NetworkConnection& connection);
+    /**
+     * Stops reading for the connection, it can be destroyed once this returns.
+     */
+    void RemoveConnection(NetworkConnection& connection);
+
+private:
+    void Run();
+    void ResumeConnections();
+};
+
+#endif // DISABLE_NETWORK
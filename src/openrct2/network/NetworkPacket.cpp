@@ -13,16 +13,44 @@
 
 #    include "NetworkTypes.h"
 
+#    include <cstring>
 #    include <memory>
+#    include <zlib.h>
 
-std::unique_ptr<NetworkPacket> NetworkPacket::Allocate()
+std::unique_ptr<NetworkPacket> NetworkPacket::Allocate(size_t capacity)
 {
-    return std::make_unique<NetworkPacket>();
+    auto packet = std::make_unique<NetworkPacket>();
+    packet->Data->reserve(capacity);
+    return packet;
 }
 
-std::unique_ptr<NetworkPacket> NetworkPacket::Duplicate(NetworkPacket& packet)
+std::unique_ptr<NetworkPacket> NetworkPacket::Compress(const NetworkPacket& packet)
 {
-    return std::make_unique<NetworkPacket>(packet);
+    // Compressed packets consist of the command, the size of the rest of the data and the compressed rest of the data.
+    const auto& data = *packet.Data;
+    if (data.size() <= sizeof(uint32_t))
+    {
+        return nullptr;
+    }
+    const uint8_t* payload = data.data() + sizeof(uint32_t);
+    uLong payloadSize = (uLong)(data.size() - sizeof(uint32_t));
+    uLongf compressedSize = compressBound(payloadSize);
+
+    auto compressed = Allocate(sizeof(uint32_t) + sizeof(uint16_t) + compressedSize);
+    *compressed << (uint32_t)(packet.GetCommand() | NETWORK_COMMAND_FLAG_COMPRESSED) << (uint16_t)payloadSize;
+    size_t headerSize = compressed->Data->size();
+    compressed->Data->resize(headerSize + compressedSize);
+    if (compress2(compressed->Data->data() + headerSize, &compressedSize, payload, payloadSize, Z_BEST_SPEED) != Z_OK)
+    {
+        return nullptr;
+    }
+    if (headerSize + compressedSize >= data.size())
+    {
+        return nullptr;
+    }
+    compressed->Data->resize(headerSize + compressedSize);
+    compressed->Size = (uint16_t)compressed->Data->size();
+    return compressed;
 }
 
 uint8_t* NetworkPacket::GetData()
@@ -34,7 +62,7 @@ int32_t NetworkPacket::GetCommand() const
 {
     if (Data->size() >= sizeof(uint32_t))
     {
-        return ByteSwapBE(*(uint32_t*)(&(*Data)[0]));
+        return ByteSwapBE(*(uint32_t*)(&(*Data)[0])) & ~NETWORK_COMMAND_FLAG_COMPRESSED;
     }
     else
     {
@@ -42,6 +70,47 @@ int32_t NetworkPacket::GetCommand() const
     }
 }
 
+bool NetworkPacket::IsCompressed() const
+{
+    return Data->size() >= sizeof(uint32_t) && (ByteSwapBE(*(uint32_t*)(&(*Data)[0])) & NETWORK_COMMAND_FLAG_COMPRESSED);
+}
+
+size_t NetworkPacket::GetUncompressedSize() const
+{
+    if (!IsCompressed() || Data->size() < sizeof(uint32_t) + sizeof(uint16_t))
+    {
+        return Data->size();
+    }
+    uint16_t payloadSize;
+    std::memcpy(&payloadSize, &(*Data)[sizeof(uint32_t)], sizeof(payloadSize));
+    return sizeof(uint32_t) + ByteSwapBE(payloadSize);
+}
+
+bool NetworkPacket::Decompress()
+{
+    size_t size = GetUncompressedSize();
+    size_t headerSize = sizeof(uint32_t) + sizeof(uint16_t);
+    if (Size < headerSize || size > UINT16_MAX)
+    {
+        return false;
+    }
+
+    auto data = std::make_shared<std::vector<uint8_t>>(size);
+    uLongf payloadSize = (uLongf)(size - sizeof(uint32_t));
+    if (uncompress(data->data() + sizeof(uint32_t), &payloadSize, GetData() + headerSize, (uLong)(Size - headerSize)) != Z_OK
+        || payloadSize != size - sizeof(uint32_t))
+    {
+        return false;
+    }
+    uint32_t command = ByteSwapBE((uint32_t)GetCommand());
+    std::memcpy(data->data(), &command, sizeof(command));
+
+    Data = std::move(data);
+    Size = (uint16_t)size;
+    BytesRead = 0;
+    return true;
+}
+
 void NetworkPacket::Clear()
 {
     BytesTransferred = 0;
@@ -49,7 +118,7 @@ void NetworkPacket::Clear()
     Data->clear();
 }
 
-bool NetworkPacket::CommandRequiresAuth()
+bool NetworkPacket::CommandRequiresAuth() const
 {
     switch (GetCommand())
     {
@@ -66,7 +135,9 @@ bool NetworkPacket::CommandRequiresAuth()
 
 void NetworkPacket::Write(const uint8_t* bytes, size_t size)
 {
-    Data->insert(Data->end(), bytes, bytes + size);
+    size_t offset = Data->size();
+    Data->resize(offset + size);
+    std::memcpy(Data->data() + offset, bytes, size);
 }
 
 void NetworkPacket::WriteString(const utf8* string)
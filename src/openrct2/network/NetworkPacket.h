@@ -24,14 +24,31 @@ public:
     size_t BytesTransferred = 0;
     size_t BytesRead = 0;
 
-    static std::unique_ptr<NetworkPacket> Allocate();
-    static std::unique_ptr<NetworkPacket> Duplicate(NetworkPacket& packet);
+    /**
+     * Creates an empty packet with room for capacity bytes, so it can be written without reallocating.
+     */
+    static std::unique_ptr<NetworkPacket> Allocate(size_t capacity = 64);
+    /**
+     * Creates a packet with the same command and the rest of the data compressed with zlib, or returns nullptr if
+     * compressing the packet does not make it smaller.
+     */
+    static std::unique_ptr<NetworkPacket> Compress(const NetworkPacket& packet);
 
     uint8_t* GetData();
+    // The command of the packet, whether it is compressed or not.
     int32_t GetCommand() const;
 
+    bool IsCompressed() const;
+    // The size of the data once decompressed.
+    size_t GetUncompressedSize() const;
+    /**
+     * Replaces the data of a compressed packet that has been received with the decompressed data.
+     * Returns false if the data is not valid.
+     */
+    bool Decompress();
+
     void Clear();
-    bool CommandRequiresAuth();
+    bool CommandRequiresAuth() const;
 
     const uint8_t* Read(size_t size);
     const utf8* ReadString();
@@ -58,8 +75,7 @@ public:
     template<typename T> NetworkPacket& operator<<(T value)
     {
         T swapped = ByteSwapBE(value);
-        uint8_t* bytes = (uint8_t*)&swapped;
-        Data->insert(Data->end(), bytes, bytes + sizeof(value));
+        Write((const uint8_t*)&swapped, sizeof(swapped));
         return *this;
     }
 
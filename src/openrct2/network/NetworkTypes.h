@@ -69,6 +69,15 @@ enum NETWORK_COMMAND
     NETWORK_COMMAND_INVALID = -1
 };
 
+// Set in the command of a packet when the rest of the packet has been compressed.
+constexpr uint32_t NETWORK_COMMAND_FLAG_COMPRESSED = 1u << 31;
+
+enum NETWORK_COMPRESSION
+{
+    NETWORK_COMPRESSION_NONE,
+    NETWORK_COMPRESSION_ZLIB,
+};
+
 // Structure is used for networking specific fields with meaning,
 // this structure can be used in combination with DataSerialiser
 // to provide extra details with template specialization.
@@ -109,4 +118,10 @@ struct NetworkStats_t
 {
     uint64_t bytesReceived[NETWORK_STATISTICS_GROUP_MAX];
     uint64_t bytesSent[NETWORK_STATISTICS_GROUP_MAX];
+    // Packets, and the bytes of those packets, that are queued but have not been sent completely yet
+    uint64_t queuedPackets;
+    uint64_t queuedBytes;
+    // Bytes that did not have to be transferred because packets were compressed
+    uint64_t bytesSavedSent;
+    uint64_t bytesSavedReceived;
 };
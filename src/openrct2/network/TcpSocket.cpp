@@ -9,6 +9,7 @@
 
 #ifndef DISABLE_NETWORK
 
+#    include <algorithm>
 #    include <chrono>
 #    include <cmath>
 #    include <cstring>
@@ -42,6 +43,7 @@
     #include <netinet/tcp.h>
     #include <netinet/in.h>
     #include <sys/socket.h>
+    #include <sys/uio.h>
     #include <fcntl.h>
     #include "../common.h"
     using SOCKET = int32_t;
@@ -51,6 +53,9 @@
     #define closesocket close
     #define ioctlsocket ioctl
     #if defined(__linux__)
+        #include <sys/epoll.h>
+        #include <sys/eventfd.h>
+        #include <unistd.h>
         #define FLAG_NO_PIPE MSG_NOSIGNAL
     #else
         #define FLAG_NO_PIPE 0
@@ -62,6 +67,11 @@
 
 constexpr auto CONNECT_TIMEOUT = std::chrono::milliseconds(3000);
 
+// The number of buffers handed to the system in a single call, well below the IOV_MAX of any platform.
+constexpr size_t MAX_SEND_BUFFERS = 64;
+// The number of readable sockets a poller takes from the system at once.
+constexpr size_t MAX_POLL_EVENTS = 64;
+
 #    ifdef _WIN32
 static bool _wsaInitialised = false;
 #    endif
@@ -79,6 +89,8 @@ public:
 
 class TcpSocket final : public ITcpSocket
 {
+    friend class EpollSocketPoller;
+
 private:
     SOCKET_STATUS _status = SOCKET_STATUS_CLOSED;
     uint16_t _listeningPort = 0;
@@ -371,6 +383,60 @@ public:
         return totalSent;
     }
 
+    size_t SendData(const SocketBuffer* buffers, size_t count) override
+    {
+        if (_status != SOCKET_STATUS_CONNECTED)
+        {
+            throw std::runtime_error("Socket not connected.");
+        }
+
+        size_t totalSent = 0;
+        while (count > 0)
+        {
+            size_t numBuffers = std::min(count, MAX_SEND_BUFFERS);
+            size_t batchSize = 0;
+#    ifdef _WIN32
+            WSABUF wsaBuffers[MAX_SEND_BUFFERS];
+            for (size_t i = 0; i < numBuffers; i++)
+            {
+                wsaBuffers[i].buf = (CHAR*)buffers[i].Data;
+                wsaBuffers[i].len = (ULONG)buffers[i].Size;
+                batchSize += buffers[i].Size;
+            }
+            DWORD sentBytes = 0;
+            if (WSASend(_socket, wsaBuffers, (DWORD)numBuffers, &sentBytes, 0, nullptr, nullptr) == SOCKET_ERROR)
+            {
+                return totalSent;
+            }
+#    else
+            iovec iov[MAX_SEND_BUFFERS];
+            for (size_t i = 0; i < numBuffers; i++)
+            {
+                iov[i].iov_base = (void*)buffers[i].Data;
+                iov[i].iov_len = buffers[i].Size;
+                batchSize += buffers[i].Size;
+            }
+            msghdr message = {};
+            message.msg_iov = iov;
+            message.msg_iovlen = numBuffers;
+            ssize_t sentBytes = sendmsg(_socket, &message, FLAG_NO_PIPE);
+            if (sentBytes == SOCKET_ERROR)
+            {
+                return totalSent;
+            }
+#    endif
+            totalSent += (size_t)sentBytes;
+            if ((size_t)sentBytes < batchSize)
+            {
+                // The send buffer of the socket is full, the caller tries again with the rest later.
+                break;
+            }
+            buffers += numBuffers;
+            count -= numBuffers;
+        }
+        return totalSent;
+    }
+
     NETWORK_READPACKET ReceiveData(void* buffer, size_t size, size_t* sizeReceived) override
     {
         if (_status != SOCKET_STATUS_CONNECTED)
@@ -496,11 +562,127 @@ private:
     }
 };
 
+#    ifdef __linux__
+class EpollSocketPoller final : public ISocketPoller
+{
+private:
+    int32_t _epoll = -1;
+    // Written to by Interrupt to wake up Wait.
+    int32_t _interruptEvent = -1;
+
+public:
+    EpollSocketPoller()
+    {
+        _epoll = epoll_create1(EPOLL_CLOEXEC);
+        if (_epoll == -1)
+        {
+            throw SocketException("Unable to create epoll instance: " + std::to_string(errno));
+        }
+        _interruptEvent = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+        if (_interruptEvent == -1)
+        {
+            close(_epoll);
+            throw SocketException("Unable to create event: " + std::to_string(errno));
+        }
+
+        epoll_event event = {};
+        event.events = EPOLLIN;
+        event.data.ptr = nullptr;
+        epoll_ctl(_epoll, EPOLL_CTL_ADD, _interruptEvent, &event);
+    }
+
+    ~EpollSocketPoller() override
+    {
+        close(_interruptEvent);
+        close(_epoll);
+    }
+
+    bool Add(ITcpSocket& socket, void* userData) override
+    {
+        epoll_event event = {};
+        event.events = EPOLLIN | EPOLLRDHUP;
+        event.data.ptr = userData;
+        if (epoll_ctl(_epoll, EPOLL_CTL_ADD, GetHandle(socket), &event) != 0)
+        {
+            log_error("Unable to watch socket: %d", errno);
+            return false;
+        }
+        return true;
+    }
+
+    void Remove(ITcpSocket& socket) override
+    {
+        epoll_ctl(_epoll, EPOLL_CTL_DEL, GetHandle(socket), nullptr);
+    }
+
+    size_t Wait(void** userData, size_t maxCount, int32_t timeoutMs) override
+    {
+        epoll_event events[MAX_POLL_EVENTS];
+        int32_t numEvents;
+        do
+        {
+            numEvents = epoll_wait(_epoll, events, (int32_t)std::min(maxCount, MAX_POLL_EVENTS), timeoutMs);
+        } while (numEvents == -1 && errno == EINTR);
+
+        size_t count = 0;
+        for (int32_t i = 0; i < numEvents; i++)
+        {
+            if (events[i].data.ptr == nullptr)
+            {
+                uint64_t value;
+                if (read(_interruptEvent, &value, sizeof(value)) == sizeof(value))
+                {
+                    // The sockets that are readable as well are reported again by the next wait.
+                    return 0;
+                }
+            }
+            else
+            {
+                userData[count++] = events[i].data.ptr;
+            }
+        }
+        return count;
+    }
+
+    void Interrupt() override
+    {
+        uint64_t value = 1;
+        if (write(_interruptEvent, &value, sizeof(value)) != sizeof(value))
+        {
+            log_error("Unable to interrupt socket poller: %d", errno);
+        }
+    }
+
+private:
+    static SOCKET GetHandle(ITcpSocket& socket)
+    {
+        return static_cast<TcpSocket&>(socket)._socket;
+    }
+};
+#    endif // __linux__
+
 std::unique_ptr<ITcpSocket> CreateTcpSocket()
 {
     return std::make_unique<TcpSocket>();
 }
 
+std::unique_ptr<ISocketPoller> CreateSocketPoller()
+{
+#    ifdef __linux__
+    try
+    {
+        return std::make_unique<EpollSocketPoller>();
+    }
+    catch (const std::exception& ex)
+    {
+        log_error("%s", ex.what());
+        return nullptr;
+    }
+#    else
+    return nullptr;
+#    endif
+}
+
 bool InitialiseWSA()
 {
 #    ifdef _WIN32
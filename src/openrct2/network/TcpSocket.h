@@ -30,6 +30,12 @@ enum NETWORK_READPACKET
     NETWORK_READPACKET_DISCONNECTED
 };
 
+struct SocketBuffer
+{
+    const void* Data;
+    size_t Size;
+};
+
 /**
  * Represents a TCP socket / connection or listener.
  */
@@ -52,13 +58,47 @@ public:
     virtual void ConnectAsync(const char* address, uint16_t port) abstract;
 
     virtual size_t SendData(const void* buffer, size_t size) abstract;
+    /**
+     * Sends the buffers one after another with as few system calls as possible, without copying them together.
+     * Returns the total number of bytes sent, which is less than their total size if the socket would block.
+     */
+    virtual size_t SendData(const SocketBuffer* buffers, size_t count) abstract;
     virtual NETWORK_READPACKET ReceiveData(void* buffer, size_t size, size_t* sizeReceived) abstract;
 
     virtual void Disconnect() abstract;
     virtual void Close() abstract;
 };
 
+/**
+ * Waits for any number of sockets to become readable, so they do not have to be polled one by one.
+ */
+interface ISocketPoller
+{
+public:
+    virtual ~ISocketPoller()
+    {
+    }
+
+    /**
+     * Starts watching the socket, Wait returns userData whenever it has data to read or has been closed.
+     */
+    virtual bool Add(ITcpSocket& socket, void* userData) abstract;
+    virtual void Remove(ITcpSocket& socket) abstract;
+    /**
+     * Blocks until at least one socket is readable, Interrupt is called or timeoutMs has passed (-1 to wait without a
+     * timeout), filling userData with the sockets that are readable. Returns the number of readable sockets, which is
+     * 0 if the wait was interrupted or timed out.
+     */
+    virtual size_t Wait(void** userData, size_t maxCount, int32_t timeoutMs) abstract;
+    virtual void Interrupt() abstract;
+};
+
 std::unique_ptr<ITcpSocket> CreateTcpSocket();
+/**
+ * Creates a socket poller, or returns nullptr if there is no readiness API for it on this platform (only epoll is
+ * supported at the moment).
+ */
+std::unique_ptr<ISocketPoller> CreateSocketPoller();
 
 bool InitialiseWSA();
 void DisposeWSA();
@@ -18,6 +18,9 @@
 #include "tile_element/Paint.TileElement.h"
 
 #include <algorithm>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 // Globals for paint clipping
 uint8_t gClipHeight = 128; // Default to middle value
@@ -25,7 +28,13 @@ LocationXY8 gClipSelectionA = { 0, 0 };
 LocationXY8 gClipSelectionB = { MAXIMUM_MAP_SIZE_TECHNICAL - 1, MAXIMUM_MAP_SIZE_TECHNICAL - 1 };
 
 paint_session gPaintSession;
-static bool _paintSessionInUse;
+std::mutex gPaintTextMutex;
+
+// Sessions are large, so they are kept around for reuse. Several columns of a viewport can be painted
+// at the same time, each with a session of its own.
+static std::mutex _paintSessionPoolMutex;
+static std::vector<std::unique_ptr<paint_session>> _paintSessionPool;
+static std::vector<paint_session*> _freePaintSessions;
 
 static constexpr const uint8_t BoundBoxDebugColours[] = {
     0,   // NONE
@@ -73,6 +82,7 @@ static void paint_session_init(paint_session* session, rct_drawpixelinfo* dpi, u
     session->WoodenSupportsPrependTo = nullptr;
     session->CurrentlyDrawnItem = nullptr;
     session->SurfaceElement = nullptr;
+    session->ScrollingTextEntries = 0;
 }
 
 static void paint_session_add_ps_to_quadrant(paint_session* session, paint_struct* ps, int32_t positionHash)
@@ -732,18 +742,28 @@ static void draw_pixel_info_crop_by_zoom(rct_drawpixelinfo* dpi)
 
 paint_session* paint_session_alloc(rct_drawpixelinfo* dpi, uint32_t viewFlags)
 {
-    // Currently limited to just one session at a time
-    assert(!_paintSessionInUse);
-    _paintSessionInUse = true;
-    paint_session* session = &gPaintSession;
+    paint_session* session;
+    {
+        std::lock_guard<std::mutex> lock(_paintSessionPoolMutex);
+        if (_freePaintSessions.empty())
+        {
+            _paintSessionPool.push_back(std::make_unique<paint_session>());
+            _freePaintSessions.push_back(_paintSessionPool.back().get());
+        }
+        session = _freePaintSessions.back();
+        _freePaintSessions.pop_back();
+    }
 
     paint_session_init(session, dpi, viewFlags);
     return session;
 }
 
-void paint_session_free([[maybe_unused]] paint_session* session)
+void paint_session_free(paint_session* session)
 {
-    _paintSessionInUse = false;
+    scrolling_text_release(session);
+
+    std::lock_guard<std::mutex> lock(_paintSessionPoolMutex);
+    _freePaintSessions.push_back(session);
 }
 
 /**
@@ -1178,6 +1198,7 @@ void paint_draw_money_structs(rct_drawpixelinfo* dpi, paint_string_struct* ps)
     rct_drawpixelinfo dpi2 = *dpi;
     draw_pixel_info_crop_by_zoom(&dpi2);
 
+    std::lock_guard<std::mutex> lock(gPaintTextMutex);
     do
     {
         utf8 buffer[256];
@@ -14,6 +14,8 @@
 #include "../interface/Colour.h"
 #include "../world/Location.hpp"
 
+#include <mutex>
+
 struct TileElement;
 
 #pragma pack(push, 1)
@@ -172,10 +174,19 @@ struct paint_session
     uint8_t Unk141E9DB;
     uint16_t WaterHeight;
     uint32_t TrackColours[4];
+    // A bit for each scrolling text entry the session uses, they are kept until the session has been drawn.
+    uint32_t ScrollingTextEntries;
 };
 
 extern paint_session gPaintSession;
 
+/**
+ * Painting text (banners, signs, entrance names) goes through the global string formatting and font
+ * state and the scrolling text cache. Columns of a viewport can be painted on several threads at once,
+ * so any painter that formats or measures text has to hold this mutex while doing so.
+ */
+extern std::mutex gPaintTextMutex;
+
 // Globals for paint clipping
 extern uint8_t gClipHeight;
 extern LocationXY8 gClipSelectionA;
@@ -224,6 +235,9 @@ void paint_floating_money_effect(
     paint_session* session, money32 amount, rct_string_id string_id, int16_t y, int16_t z, int8_t y_offsets[], int16_t offset_x,
     uint32_t rotation);
 
+/**
+ * Takes a session from the pool, sessions can be allocated and freed by several threads at once.
+ */
 paint_session* paint_session_alloc(rct_drawpixelinfo* dpi, uint32_t viewFlags);
 void paint_session_free(paint_session* session);
 void paint_session_generate(paint_session* session);
@@ -34,8 +34,8 @@ void sprite_paint_setup(paint_session* session, const uint16_t x, const uint16_t
         return;
     }
 
-    uint16_t sprite_idx = sprite_get_first_in_quadrant(x, y);
-    if (sprite_idx == SPRITE_INDEX_NULL)
+    const auto& quadrant = sprite_get_quadrant(x, y);
+    if (quadrant.empty())
     {
         return;
     }
@@ -48,42 +48,41 @@ void sprite_paint_setup(paint_session* session, const uint16_t x, const uint16_t
 
     const bool highlightPathIssues = (session->ViewFlags & VIEWPORT_FLAG_HIGHLIGHT_PATH_ISSUES);
 
-    for (const rct_sprite* spr = get_sprite(sprite_idx); sprite_idx != SPRITE_INDEX_NULL;
-         sprite_idx = spr->generic.next_in_quadrant)
+    for (const auto& entry : quadrant)
     {
-        spr = get_sprite(sprite_idx);
-
-        if (highlightPathIssues)
-        {
-            if (spr->generic.sprite_identifier == SPRITE_IDENTIFIER_PEEP)
-            {
-                rct_peep* peep = (rct_peep*)spr;
-                if (!(peep->type == PEEP_TYPE_STAFF && peep->staff_type == STAFF_TYPE_HANDYMAN))
-                {
-                    continue;
-                }
-            }
-            else if (spr->generic.sprite_identifier != SPRITE_IDENTIFIER_LITTER)
-            {
-                continue;
-            }
-        }
-
         // Only paint sprites that are below the clip height and inside the clip selection.
         // Here converting from land/path/etc height scale to pixel height scale.
         // Note: peeps/scenery on slopes will be above the base
         // height of the slope element, and consequently clipped.
         if ((session->ViewFlags & VIEWPORT_FLAG_CLIP_VIEW))
         {
-            if (spr->generic.z > (gClipHeight * 8))
+            if (entry.z > (gClipHeight * 8))
             {
                 continue;
             }
-            if (spr->generic.x / 32 < gClipSelectionA.x || spr->generic.x / 32 > gClipSelectionB.x)
+            if (entry.x / 32 < gClipSelectionA.x || entry.x / 32 > gClipSelectionB.x)
             {
                 continue;
             }
-            if (spr->generic.y / 32 < gClipSelectionA.y || spr->generic.y / 32 > gClipSelectionB.y)
+            if (entry.y / 32 < gClipSelectionA.y || entry.y / 32 > gClipSelectionB.y)
+            {
+                continue;
+            }
+        }
+
+        const rct_sprite* spr = get_sprite(entry.sprite_index);
+
+        if (highlightPathIssues)
+        {
+            if (spr->generic.sprite_identifier == SPRITE_IDENTIFIER_PEEP)
+            {
+                rct_peep* peep = (rct_peep*)spr;
+                if (!(peep->type == PEEP_TYPE_STAFF && peep->staff_type == STAFF_TYPE_HANDYMAN))
+                {
+                    continue;
+                }
+            }
+            else if (spr->generic.sprite_identifier != SPRITE_IDENTIFIER_LITTER)
             {
                 continue;
             }
@@ -92,6 +92,7 @@ void banner_paint(paint_session* session, uint8_t direction, int32_t height, con
 
     scrollingMode += direction;
 
+    std::lock_guard<std::mutex> lock(gPaintTextMutex);
     set_format_arg(0, uint32_t, 0);
     set_format_arg(4, uint32_t, 0);
 
@@ -22,7 +22,7 @@
 #include "../Supports.h"
 #include "Paint.TileElement.h"
 
-static uint32_t _unk9E32BC;
+static thread_local uint32_t _unk9E32BC;
 
 /**
  *
@@ -159,6 +159,7 @@ static void ride_entrance_exit_paint(paint_session* session, uint8_t direction,
     if (!is_exit && !(tile_element->flags & TILE_ELEMENT_FLAG_GHOST) && tile_element->AsEntrance()->GetRideIndex() != 0xFF
         && stationObj->ScrollingMode != 0xFF)
     {
+        std::lock_guard<std::mutex> lock(gPaintTextMutex);
         set_format_arg(0, rct_string_id, STR_RIDE_ENTRANCE_NAME);
         set_format_arg(4, uint32_t, 0);
 
@@ -267,6 +268,7 @@ static void park_entrance_paint(paint_session* session, uint8_t direction, int32
                 break;
 
             {
+                std::lock_guard<std::mutex> lock(gPaintTextMutex);
                 set_format_arg(0, uint32_t, 0);
                 set_format_arg(4, uint32_t, 0);
 
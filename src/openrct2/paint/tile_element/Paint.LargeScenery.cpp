@@ -301,6 +301,7 @@ void large_scenery_paint(paint_session* session, uint8_t direction, uint16_t hei
         }
         // 6B8331:
         // Draw sign text:
+        std::lock_guard<std::mutex> lock(gPaintTextMutex);
         set_format_arg(0, uint32_t, 0);
         set_format_arg(4, uint32_t, 0);
         int32_t textColour = tileElement->AsLargeScenery()->GetSecondaryColour();
@@ -413,6 +414,7 @@ void large_scenery_paint(paint_session* session, uint8_t direction, uint16_t hei
         return;
     }
     // Draw scrolling text:
+    std::lock_guard<std::mutex> lock(gPaintTextMutex);
     set_format_arg(0, uint32_t, 0);
     set_format_arg(4, uint32_t, 0);
     uint8_t textColour = tileElement->AsLargeScenery()->GetSecondaryColour();
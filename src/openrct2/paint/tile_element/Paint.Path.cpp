@@ -447,6 +447,7 @@ static void sub_6A4101(
             uint16_t scrollingMode = railingEntry->scrolling_mode;
             scrollingMode += direction;
 
+            std::lock_guard<std::mutex> lock(gPaintTextMutex);
             set_format_arg(0, uint32_t, 0);
             set_format_arg(4, uint32_t, 0);
 
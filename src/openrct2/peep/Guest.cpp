@@ -5374,10 +5374,12 @@ void rct_peep::UpdateWalking()
         return;
 
     // Check if there is a peep watching (and if there is place for us)
-    uint16_t sprite_id = sprite_get_first_in_quadrant(x, y);
-    for (rct_sprite* sprite; sprite_id != SPRITE_INDEX_NULL; sprite_id = sprite->generic.next_in_quadrant)
+    for (const auto& entry : sprite_get_quadrant(x, y))
     {
-        sprite = get_sprite(sprite_id);
+        if (z != entry.z)
+            continue;
+
+        rct_sprite* sprite = get_sprite(entry.sprite_index);
 
         if (sprite->generic.linked_list_type_offset != SPRITE_LIST_PEEP * 2)
             continue;
@@ -5385,9 +5387,6 @@ void rct_peep::UpdateWalking()
         if (sprite->peep.state != PEEP_STATE_WATCHING)
             continue;
 
-        if (z != sprite->peep.z)
-            continue;
-
         if ((sprite->peep.var_37 & 0x3) != chosen_edge)
             continue;
 
@@ -5973,13 +5972,15 @@ bool rct_peep::UpdateWalkingFindBench()
     for (; !(edges & (1 << chosen_edge));)
         chosen_edge = (chosen_edge + 1) & 0x3;
 
-    uint16_t sprite_id = sprite_get_first_in_quadrant(x, y);
     uint8_t free_edge = 3;
 
     // Check if there is no peep sitting in chosen_edge
-    for (rct_sprite* sprite; sprite_id != SPRITE_INDEX_NULL; sprite_id = sprite->generic.next_in_quadrant)
+    for (const auto& entry : sprite_get_quadrant(x, y))
     {
-        sprite = get_sprite(sprite_id);
+        if (z != entry.z)
+            continue;
+
+        rct_sprite* sprite = get_sprite(entry.sprite_index);
 
         if (sprite->generic.linked_list_type_offset != SPRITE_LIST_PEEP * 2)
             continue;
@@ -5987,9 +5988,6 @@ bool rct_peep::UpdateWalkingFindBench()
         if (sprite->peep.state != PEEP_STATE_SITTING)
             continue;
 
-        if (z != sprite->peep.z)
-            continue;
-
         if ((sprite->peep.var_37 & 0x3) != chosen_edge)
             continue;
 
@@ -6164,15 +6162,15 @@ static void peep_update_walking_break_scenery(rct_peep* peep)
     if (edges == 0xF)
         return;
 
-    uint16_t sprite_id = sprite_get_first_in_quadrant(peep->x, peep->y);
-
     // Check if a peep is already sitting on the bench. If so, do not vandalise it.
-    for (rct_sprite* sprite; sprite_id != SPRITE_INDEX_NULL; sprite_id = sprite->generic.next_in_quadrant)
+    for (const auto& entry : sprite_get_quadrant(peep->x, peep->y))
     {
-        sprite = get_sprite(sprite_id);
+        if (peep->z != entry.z)
+            continue;
+
+        rct_sprite* sprite = get_sprite(entry.sprite_index);
 
-        if ((sprite->generic.linked_list_type_offset != SPRITE_LIST_PEEP * 2) || (sprite->peep.state != PEEP_STATE_SITTING)
-            || (peep->z != sprite->peep.z))
+        if ((sprite->generic.linked_list_type_offset != SPRITE_LIST_PEEP * 2) || (sprite->peep.state != PEEP_STATE_SITTING))
         {
             continue;
         }
@@ -7,6 +7,8 @@
  * OpenRCT2 is licensed under the GNU General Public License version 3.
  *****************************************************************************/
 
+#include "../config/Config.h"
+#include "../core/JobPool.h"
 #include "../ride/Station.h"
 #include "../ride/Track.h"
 #include "../scenario/Scenario.h"
@@ -15,13 +17,19 @@
 #include "../world/Footpath.h"
 #include "Peep.h"
 
+#include <algorithm>
+#include <bitset>
 #include <cstring>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
-static bool _peepPathFindIsStaff;
-static int8_t _peepPathFindNumJunctions;
-static int8_t _peepPathFindMaxJunctions;
-static int32_t _peepPathFindTilesChecked;
-static uint8_t _peepPathFindFewestNumSteps;
+// The search state is thread local so that guest_path_finding_precompute_all can search on the job pool.
+static thread_local bool _peepPathFindIsStaff;
+static thread_local int8_t _peepPathFindNumJunctions;
+static thread_local int8_t _peepPathFindMaxJunctions;
+static thread_local int32_t _peepPathFindTilesChecked;
+static thread_local uint8_t _peepPathFindFewestNumSteps;
 
 static int32_t guest_surface_path_finding(rct_peep* peep);
 
@@ -29,12 +37,144 @@ static int32_t guest_surface_path_finding(rct_peep* peep);
  * The magic number 16 is the largest value returned by
  * peep_pathfind_get_max_number_junctions() which should eventually
  * be declared properly. */
-static struct
+static thread_local struct
 {
     TileCoordsXYZ location;
     uint8_t direction;
 } _peepPathFindHistory[16];
 
+// The map is split into square regions of (1 << PATH_FIND_CACHE_REGION_SHIFT) tiles for invalidating the cache.
+static constexpr int32_t PATH_FIND_CACHE_REGION_SHIFT = 4;
+static constexpr int32_t PATH_FIND_CACHE_REGIONS_PER_AXIS = MAXIMUM_MAP_SIZE_TECHNICAL >> PATH_FIND_CACHE_REGION_SHIFT;
+static constexpr size_t PATH_FIND_CACHE_NUM_REGIONS = PATH_FIND_CACHE_REGIONS_PER_AXIS * PATH_FIND_CACHE_REGIONS_PER_AXIS;
+// The cache is emptied when it reaches this many entries.
+static constexpr size_t PATH_FIND_CACHE_MAX_ENTRIES = 8192;
+
+using PathFindCacheRegions = std::bitset<PATH_FIND_CACHE_NUM_REGIONS>;
+
+/**
+ * Every input of a single heuristic search other than the map and the guest's junction history.
+ */
+struct PathFindCacheKey
+{
+    TileCoordsXYZ Location;
+    TileCoordsXYZ Goal;
+    int32_t TilesChecked;
+    int8_t MaxJunctions;
+    uint8_t Direction;
+    ride_id_t QueueRideIndex;
+    bool IgnoreForeignQueues;
+
+    bool operator==(const PathFindCacheKey& other) const
+    {
+        return Location == other.Location && Goal == other.Goal && TilesChecked == other.TilesChecked
+            && MaxJunctions == other.MaxJunctions && Direction == other.Direction && QueueRideIndex == other.QueueRideIndex
+            && IgnoreForeignQueues == other.IgnoreForeignQueues;
+    }
+};
+
+struct PathFindCacheKeyHash
+{
+    size_t operator()(const PathFindCacheKey& key) const
+    {
+        uint64_t hash = key.Location.x;
+        hash = hash * 31 + key.Location.y;
+        hash = hash * 31 + key.Location.z;
+        hash = hash * 31 + key.Goal.x;
+        hash = hash * 31 + key.Goal.y;
+        hash = hash * 31 + key.Goal.z;
+        hash = hash * 31 + key.TilesChecked;
+        hash = hash * 31 + key.MaxJunctions;
+        hash = hash * 31 + key.Direction;
+        hash = hash * 31 + key.QueueRideIndex;
+        hash = hash * 31 + key.IgnoreForeignQueues;
+        return static_cast<size_t>(hash ^ (hash >> 32));
+    }
+};
+
+/**
+ * The result of a heuristic search, along with the parts of the map it read (Regions) and the
+ * thin junctions it passed through (Junctions), where the search consults the guest's junction
+ * history. The result is valid for any guest whose history contains none of those junctions.
+ */
+struct PathFindCacheEntry
+{
+    uint16_t Score;
+    uint8_t Steps;
+    PathFindCacheRegions Regions;
+    std::vector<TileCoordsXYZ> Junctions;
+};
+
+using PathFindCacheInsert = std::pair<PathFindCacheKey, PathFindCacheEntry>;
+
+/**
+ * Heuristic search results kept across ticks, so that guests heading for the same goal through the
+ * same junction do not repeat the same search. Results are exact rather than approximated, so
+ * pathfinding (and with it replays and multiplayer) behaves the same with or without the cache.
+ */
+static std::unordered_map<PathFindCacheKey, PathFindCacheEntry, PathFindCacheKeyHash> _pathFindCache;
+// Regions that changed since the cache was last checked for stale entries.
+static PathFindCacheRegions _pathFindCacheDirtyRegions;
+static thread_local PathFindCacheEntry _pathFindCacheScratch;
+static thread_local PathFindCacheEntry* _pathFindCacheRecording = nullptr;
+
+/**
+ * The heuristic search results of a guest that were computed ahead of its update, along with
+ * every input of the search other than the map. A result is only used if all of these still match.
+ */
+struct GuestPathFindPrecomputed
+{
+    uint32_t Generation;
+    TileCoordsXYZ Location;
+    TileCoordsXYZ Goal;
+    ride_id_t QueueRideIndex;
+    int8_t MaxJunctions;
+    int32_t TilesChecked;
+    rct12_xyzd8 History[4];
+    uint8_t Edges;
+    uint16_t Scores[4];
+    uint8_t Steps[4];
+    // Searches that missed the cache, added to it once all guests have been precomputed.
+    std::vector<PathFindCacheInsert> CacheInserts;
+};
+
+// Ticks with fewer candidate guests than this are not worth handing to the job pool.
+static constexpr size_t GUEST_PATH_FIND_PRECOMPUTE_MIN_GUESTS = 64;
+static constexpr size_t GUEST_PATH_FIND_PRECOMPUTE_BATCH_SIZE = 16;
+
+static std::vector<rct_peep*> _guestPathFindCandidates;
+// Indexed by sprite index.
+static std::vector<GuestPathFindPrecomputed> _guestPathFindPrecomputed;
+static uint32_t _guestPathFindGeneration = 1;
+static thread_local GuestPathFindPrecomputed* _guestPathFindRecording = nullptr;
+
+static int32_t peep_pathfind_cache_get_region(int32_t x, int32_t y)
+{
+    if (x < 0 || y < 0 || x >= MAXIMUM_MAP_SIZE_TECHNICAL || y >= MAXIMUM_MAP_SIZE_TECHNICAL)
+        return -1;
+    return (y >> PATH_FIND_CACHE_REGION_SHIFT) * PATH_FIND_CACHE_REGIONS_PER_AXIS + (x >> PATH_FIND_CACHE_REGION_SHIFT);
+}
+
+static void peep_pathfind_cache_record_tile(TileCoordsXYZ loc)
+{
+    if (_pathFindCacheRecording != nullptr)
+    {
+        int32_t region = peep_pathfind_cache_get_region(loc.x, loc.y);
+        if (region != -1)
+        {
+            _pathFindCacheRecording->Regions.set(region);
+        }
+    }
+}
+
+static void peep_pathfind_cache_record_junction(TileCoordsXYZ loc)
+{
+    if (_pathFindCacheRecording != nullptr)
+    {
+        _pathFindCacheRecording->Junctions.push_back(loc);
+    }
+}
+
 enum
 {
     PATH_SEARCH_DEAD_END,
@@ -593,6 +733,7 @@ static void peep_pathfind_heuristic_search(
            && !staff_can_ignore_wide_flag(peep, loc.x * 32, loc.y * 32, loc.z, currentTileElement));
 
     loc += TileDirectionDelta[test_edge];
+    peep_pathfind_cache_record_tile(loc);
 
     ++counter;
     _peepPathFindTilesChecked--;
@@ -966,6 +1107,7 @@ static void peep_pathfind_heuristic_search(
                 /* The current search path is passing through a thin
                  * junction on this map element. Only 'thin' junctions
                  * are counted towards the junction search limit. */
+                peep_pathfind_cache_record_junction(loc);
 
                 /* First check if going through the junction would be
                  * a loop.  If so, the current search path ends here.
@@ -1150,6 +1292,171 @@ static void peep_pathfind_heuristic_search(
     }
 }
 
+static bool peep_pathfind_precomputed_matches(
+    const GuestPathFindPrecomputed& entry, TileCoordsXYZ loc, const rct_peep* peep, int32_t tilesChecked)
+{
+    return entry.Location == loc && entry.Goal == gPeepPathFindGoalPosition
+        && entry.QueueRideIndex == gPeepPathFindQueueRideIndex && entry.MaxJunctions == _peepPathFindMaxJunctions
+        && entry.TilesChecked == tilesChecked
+        && std::memcmp(entry.History, peep->pathfind_history, sizeof(entry.History)) == 0;
+}
+
+/**
+ * Gets the result of the heuristic search for the given edge if it was computed by
+ * guest_path_finding_precompute_all with exactly the same inputs.
+ */
+static bool peep_pathfind_get_precomputed(
+    TileCoordsXYZ loc, const rct_peep* peep, int32_t test_edge, int32_t tilesChecked, uint16_t* score, uint8_t* endSteps)
+{
+    if (_guestPathFindRecording != nullptr || _peepPathFindIsStaff || !gPeepPathFindIgnoreForeignQueues)
+        return false;
+    if (peep->sprite_index >= _guestPathFindPrecomputed.size())
+        return false;
+
+    const auto& entry = _guestPathFindPrecomputed[peep->sprite_index];
+    if (entry.Generation != _guestPathFindGeneration || !(entry.Edges & (1 << test_edge)))
+        return false;
+    if (!peep_pathfind_precomputed_matches(entry, loc, peep, tilesChecked))
+        return false;
+
+    *score = entry.Scores[test_edge];
+    *endSteps = entry.Steps[test_edge];
+    return true;
+}
+
+static void peep_pathfind_set_precomputed(
+    TileCoordsXYZ loc, const rct_peep* peep, int32_t test_edge, int32_t tilesChecked, uint16_t score, uint8_t endSteps)
+{
+    auto entry = _guestPathFindRecording;
+    if (entry == nullptr)
+        return;
+
+    if (entry->Edges == 0)
+    {
+        entry->Location = loc;
+        entry->Goal = gPeepPathFindGoalPosition;
+        entry->QueueRideIndex = gPeepPathFindQueueRideIndex;
+        entry->MaxJunctions = _peepPathFindMaxJunctions;
+        entry->TilesChecked = tilesChecked;
+        std::memcpy(entry->History, peep->pathfind_history, sizeof(entry->History));
+    }
+    entry->Edges |= 1 << test_edge;
+    entry->Scores[test_edge] = score;
+    entry->Steps[test_edge] = endSteps;
+}
+
+static PathFindCacheKey peep_pathfind_cache_get_key(TileCoordsXYZ loc, int32_t test_edge, int32_t tilesChecked)
+{
+    PathFindCacheKey key;
+    key.Location = loc;
+    key.Goal = gPeepPathFindGoalPosition;
+    key.TilesChecked = tilesChecked;
+    key.MaxJunctions = _peepPathFindMaxJunctions;
+    key.Direction = test_edge;
+    key.QueueRideIndex = gPeepPathFindQueueRideIndex;
+    key.IgnoreForeignQueues = gPeepPathFindIgnoreForeignQueues;
+    return key;
+}
+
+/**
+ * Whether the peep remembers one of the thin junctions the search passed through, in which case
+ * its history would have changed the course of the search.
+ */
+static bool peep_pathfind_cache_uses_history(const PathFindCacheEntry& entry, const rct_peep* peep)
+{
+    for (const auto& pathfindHistory : peep->pathfind_history)
+    {
+        for (const auto& junction : entry.Junctions)
+        {
+            if (pathfindHistory.x == junction.x && pathfindHistory.y == junction.y && pathfindHistory.z == junction.z)
+                return true;
+        }
+    }
+    return false;
+}
+
+static void peep_pathfind_cache_remove_stale()
+{
+    if (_pathFindCacheDirtyRegions.none())
+        return;
+
+    for (auto it = _pathFindCache.begin(); it != _pathFindCache.end();)
+    {
+        if ((it->second.Regions & _pathFindCacheDirtyRegions).any())
+        {
+            it = _pathFindCache.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+    _pathFindCacheDirtyRegions.reset();
+}
+
+static void peep_pathfind_cache_insert(const PathFindCacheKey& key, const PathFindCacheEntry& entry)
+{
+    if (_pathFindCache.size() >= PATH_FIND_CACHE_MAX_ENTRIES)
+    {
+        _pathFindCache.clear();
+    }
+    _pathFindCache[key] = entry;
+}
+
+static bool peep_pathfind_cache_get(const PathFindCacheKey& key, const rct_peep* peep, uint16_t* score, uint8_t* endSteps)
+{
+    if (_peepPathFindIsStaff)
+        return false;
+
+    // While guests are precomputed on the job pool the cache is only read, stale entries were removed beforehand.
+    if (_guestPathFindRecording == nullptr)
+    {
+        peep_pathfind_cache_remove_stale();
+    }
+
+    auto it = _pathFindCache.find(key);
+    if (it == _pathFindCache.end() || peep_pathfind_cache_uses_history(it->second, peep))
+        return false;
+
+    *score = it->second.Score;
+    *endSteps = it->second.Steps;
+    return true;
+}
+
+static void peep_pathfind_cache_begin_search(TileCoordsXYZ loc)
+{
+    if (_peepPathFindIsStaff)
+        return;
+
+    _pathFindCacheScratch.Regions.reset();
+    _pathFindCacheScratch.Junctions.clear();
+    _pathFindCacheRecording = &_pathFindCacheScratch;
+    peep_pathfind_cache_record_tile(loc);
+}
+
+static void peep_pathfind_cache_end_search(const PathFindCacheKey& key, const rct_peep* peep, uint16_t score, uint8_t endSteps)
+{
+    auto entry = _pathFindCacheRecording;
+    if (entry == nullptr)
+        return;
+
+    _pathFindCacheRecording = nullptr;
+    // The result only holds for guests that share the relevant part of this guest's history, so it is not kept.
+    if (peep_pathfind_cache_uses_history(*entry, peep))
+        return;
+
+    entry->Score = score;
+    entry->Steps = endSteps;
+    if (_guestPathFindRecording != nullptr)
+    {
+        _guestPathFindRecording->CacheInserts.emplace_back(key, *entry);
+    }
+    else
+    {
+        peep_pathfind_cache_insert(key, *entry);
+    }
+}
+
 /**
  * Returns:
  *   -1   - no direction chosen
@@ -1354,23 +1661,10 @@ int32_t peep_pathfind_choose_direction(TileCoordsXYZ loc, rct_peep* peep)
                 height += 0x2;
             }
 
-            _peepPathFindFewestNumSteps = 255;
             /* Divide the maxTilesChecked global search limit
              * between the remaining edges to ensure the search
              * covers all of the remaining edges. */
-            _peepPathFindTilesChecked = maxTilesChecked / numEdges;
-            _peepPathFindNumJunctions = _peepPathFindMaxJunctions;
-
-            // Initialise _peepPathFindHistory.
-            std::memset(_peepPathFindHistory, 0xFF, sizeof(_peepPathFindHistory));
-
-            /* The pathfinding will only use elements
-             * 1.._peepPathFindMaxJunctions, so the starting point
-             * is placed in element 0 */
-            _peepPathFindHistory[0].location.x = (uint8_t)(loc.x);
-            _peepPathFindHistory[0].location.y = (uint8_t)(loc.y);
-            _peepPathFindHistory[0].location.z = loc.z;
-            _peepPathFindHistory[0].direction = 0xF;
+            int32_t tilesChecked = maxTilesChecked / numEdges;
 
             uint16_t score = 0xFFFF;
             /* Variable endXYZ contains the end location of the
@@ -1393,25 +1687,51 @@ int32_t peep_pathfind_choose_direction(TileCoordsXYZ loc, rct_peep* peep)
             TileCoordsXYZ endJunctionList[16];
             uint8_t endDirectionList[16] = { 0 };
 
-            bool inPatrolArea = false;
-            if (peep->type == PEEP_TYPE_STAFF && peep->staff_type == STAFF_TYPE_MECHANIC)
+            if (!peep_pathfind_get_precomputed(loc, peep, test_edge, tilesChecked, &score, &endSteps))
             {
-                /* Mechanics are the only staff type that
-                 * pathfind to a destination. Determine if the
-                 * mechanic is in their patrol area. */
-                inPatrolArea = staff_is_location_in_patrol(peep, peep->next_x, peep->next_y);
-            }
+                auto cacheKey = peep_pathfind_cache_get_key(loc, test_edge, tilesChecked);
+                if (!peep_pathfind_cache_get(cacheKey, peep, &score, &endSteps))
+                {
+                    _peepPathFindFewestNumSteps = 255;
+                    _peepPathFindTilesChecked = tilesChecked;
+                    _peepPathFindNumJunctions = _peepPathFindMaxJunctions;
+
+                    // Initialise _peepPathFindHistory.
+                    std::memset(_peepPathFindHistory, 0xFF, sizeof(_peepPathFindHistory));
+
+                    /* The pathfinding will only use elements
+                     * 1.._peepPathFindMaxJunctions, so the starting point
+                     * is placed in element 0 */
+                    _peepPathFindHistory[0].location.x = (uint8_t)(loc.x);
+                    _peepPathFindHistory[0].location.y = (uint8_t)(loc.y);
+                    _peepPathFindHistory[0].location.z = loc.z;
+                    _peepPathFindHistory[0].direction = 0xF;
+
+                    bool inPatrolArea = false;
+                    if (peep->type == PEEP_TYPE_STAFF && peep->staff_type == STAFF_TYPE_MECHANIC)
+                    {
+                        /* Mechanics are the only staff type that
+                         * pathfind to a destination. Determine if the
+                         * mechanic is in their patrol area. */
+                        inPatrolArea = staff_is_location_in_patrol(peep, peep->next_x, peep->next_y);
+                    }
 
 #if defined(DEBUG_LEVEL_2) && DEBUG_LEVEL_2
-            if (gPathFindDebug)
-            {
-                log_verbose("Pathfind searching in direction: %d from %d,%d,%d", test_edge, x >> 5, y >> 5, z);
-            }
+                    if (gPathFindDebug)
+                    {
+                        log_verbose("Pathfind searching in direction: %d from %d,%d,%d", test_edge, x >> 5, y >> 5, z);
+                    }
 #endif // defined(DEBUG_LEVEL_2) && DEBUG_LEVEL_2
 
-            peep_pathfind_heuristic_search(
-                { loc.x, loc.y, height }, peep, first_tile_element, inPatrolArea, 0, &score, test_edge, &endJunctions,
-                endJunctionList, endDirectionList, &endXYZ, &endSteps);
+                    peep_pathfind_cache_begin_search(loc);
+                    peep_pathfind_heuristic_search(
+                        { loc.x, loc.y, height }, peep, first_tile_element, inPatrolArea, 0, &score, test_edge, &endJunctions,
+                        endJunctionList, endDirectionList, &endXYZ, &endSteps);
+                    peep_pathfind_cache_end_search(cacheKey, peep, score, endSteps);
+                }
+
+                peep_pathfind_set_precomputed(loc, peep, test_edge, tilesChecked, score, endSteps);
+            }
 
 #if defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
             if (gPathFindDebug)
@@ -1842,6 +2162,93 @@ static void get_ride_queue_end(TileCoordsXYZ& loc)
     loc.z = tileElement->base_height;
 }
 
+/**
+ * Gets the goal of a guest heading for the given (open) ride: the end of the queue of the
+ * ride's nearest entrance, or the entrance itself if it has no queue.
+ */
+static TileCoordsXYZ guest_path_find_ride_goal(const rct_peep* peep, ride_id_t rideIndex)
+{
+    Ride* ride = get_ride(rideIndex);
+    TileCoordsXYZ loc;
+
+    /* Find the ride's closest entrance station to the peep.
+     * At the same time, count how many entrance stations there are and
+     * which stations are entrance stations. */
+    uint16_t closestDist = 0xFFFF;
+    uint8_t closestStationNum = 0;
+
+    int32_t numEntranceStations = 0;
+    uint8_t entranceStations = 0;
+
+    for (uint8_t stationNum = 0; stationNum < MAX_STATIONS; ++stationNum)
+    {
+        // Skip if stationNum has no entrance (so presumably an exit only station)
+        if (ride_get_entrance_location(rideIndex, stationNum).isNull())
+            continue;
+
+        numEntranceStations++;
+        entranceStations |= (1 << stationNum);
+
+        TileCoordsXYZD entranceLocation = ride_get_entrance_location(rideIndex, stationNum);
+
+        int16_t stationX = (int16_t)(entranceLocation.x * 32);
+        int16_t stationY = (int16_t)(entranceLocation.y * 32);
+        uint16_t dist = abs(stationX - peep->next_x) + abs(stationY - peep->next_y);
+
+        if (dist < closestDist)
+        {
+            closestDist = dist;
+            closestStationNum = stationNum;
+            continue;
+        }
+    }
+
+    // Ride has no stations with an entrance, so head to station 0.
+    if (numEntranceStations == 0)
+        closestStationNum = 0;
+
+    /* If a ride has multiple entrance stations and is set to sync with
+     * adjacent stations, cycle through the entrance stations (based on
+     * number of rides the peep has been on) so the peep will try the
+     * different sections of the ride.
+     * In this case, the ride's various entrance stations will typically,
+     * though not necessarily, be adjacent to one another and consequently
+     * not too far for the peep to walk when cycling between them.
+     * Note: the same choice of station must made while the peep navigates
+     * to the station. Consequently a random station selection here is not
+     * appropriate. */
+    if (numEntranceStations > 1 && (ride->depart_flags & RIDE_DEPART_SYNCHRONISE_WITH_ADJACENT_STATIONS))
+    {
+        int32_t select = peep->no_of_rides % numEntranceStations;
+        while (select > 0)
+        {
+            closestStationNum = bitscanforward(entranceStations);
+            entranceStations &= ~(1 << closestStationNum);
+            select--;
+        }
+        closestStationNum = bitscanforward(entranceStations);
+    }
+
+    if (numEntranceStations == 0)
+    {
+        // closestStationNum is always 0 here.
+        LocationXY8 entranceXY = ride->stations[closestStationNum].Start;
+        loc.x = entranceXY.x;
+        loc.y = entranceXY.y;
+        loc.z = ride->stations[closestStationNum].Height;
+    }
+    else
+    {
+        TileCoordsXYZD entranceXYZD = ride_get_entrance_location(rideIndex, closestStationNum);
+        loc.x = entranceXYZD.x;
+        loc.y = entranceXYZD.y;
+        loc.z = entranceXYZD.z;
+    }
+
+    get_ride_queue_end(loc);
+    return loc;
+}
+
 /**
  *
  *  rct2: 0x00694C35
@@ -2050,84 +2457,7 @@ int32_t guest_path_finding(rct_peep* peep)
 
     // The ride is open.
     gPeepPathFindQueueRideIndex = rideIndex;
-
-    /* Find the ride's closest entrance station to the peep.
-     * At the same time, count how many entrance stations there are and
-     * which stations are entrance stations. */
-    uint16_t closestDist = 0xFFFF;
-    uint8_t closestStationNum = 0;
-
-    int32_t numEntranceStations = 0;
-    uint8_t entranceStations = 0;
-
-    for (uint8_t stationNum = 0; stationNum < MAX_STATIONS; ++stationNum)
-    {
-        // Skip if stationNum has no entrance (so presumably an exit only station)
-        if (ride_get_entrance_location(rideIndex, stationNum).isNull())
-            continue;
-
-        numEntranceStations++;
-        entranceStations |= (1 << stationNum);
-
-        TileCoordsXYZD entranceLocation = ride_get_entrance_location(rideIndex, stationNum);
-
-        int16_t stationX = (int16_t)(entranceLocation.x * 32);
-        int16_t stationY = (int16_t)(entranceLocation.y * 32);
-        uint16_t dist = abs(stationX - peep->next_x) + abs(stationY - peep->next_y);
-
-        if (dist < closestDist)
-        {
-            closestDist = dist;
-            closestStationNum = stationNum;
-            continue;
-        }
-    }
-
-    // Ride has no stations with an entrance, so head to station 0.
-    if (numEntranceStations == 0)
-        closestStationNum = 0;
-
-    /* If a ride has multiple entrance stations and is set to sync with
-     * adjacent stations, cycle through the entrance stations (based on
-     * number of rides the peep has been on) so the peep will try the
-     * different sections of the ride.
-     * In this case, the ride's various entrance stations will typically,
-     * though not necessarily, be adjacent to one another and consequently
-     * not too far for the peep to walk when cycling between them.
-     * Note: the same choice of station must made while the peep navigates
-     * to the station. Consequently a random station selection here is not
-     * appropriate. */
-    if (numEntranceStations > 1 && (ride->depart_flags & RIDE_DEPART_SYNCHRONISE_WITH_ADJACENT_STATIONS))
-    {
-        int32_t select = peep->no_of_rides % numEntranceStations;
-        while (select > 0)
-        {
-            closestStationNum = bitscanforward(entranceStations);
-            entranceStations &= ~(1 << closestStationNum);
-            select--;
-        }
-        closestStationNum = bitscanforward(entranceStations);
-    }
-
-    if (numEntranceStations == 0)
-    {
-        // closestStationNum is always 0 here.
-        LocationXY8 entranceXY = ride->stations[closestStationNum].Start;
-        loc.x = entranceXY.x;
-        loc.y = entranceXY.y;
-        loc.z = ride->stations[closestStationNum].Height;
-    }
-    else
-    {
-        TileCoordsXYZD entranceXYZD = ride_get_entrance_location(rideIndex, closestStationNum);
-        loc.x = entranceXYZD.x;
-        loc.y = entranceXYZD.y;
-        loc.z = entranceXYZD.z;
-    }
-
-    get_ride_queue_end(loc);
-
-    gPeepPathFindGoalPosition = loc;
+    gPeepPathFindGoalPosition = guest_path_find_ride_goal(peep, rideIndex);
     gPeepPathFindIgnoreForeignQueues = true;
 
     direction = peep_pathfind_choose_direction({ peep->next_x / 32, peep->next_y / 32, peep->next_z }, peep);
@@ -2161,3 +2491,134 @@ int32_t guest_path_finding(rct_peep* peep)
 #endif // defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
     return peep_move_one_tile(direction, peep);
 }
+
+/**
+ * Whether the guest is likely to run the heuristic search towards a ride during its next update,
+ * i.e. it is walking inside the park towards an open ride and has reached its current destination.
+ */
+static bool guest_path_finding_can_precompute(const rct_peep* peep)
+{
+    if (peep->state != PEEP_STATE_WALKING || peep->outside_of_park != 0)
+        return false;
+    // PEEP_FLAGS_2 makes peep_pathfind_get_max_number_junctions draw a random number.
+    if (peep->peep_flags & (PEEP_FLAGS_LEAVING_PARK | PEEP_FLAGS_2))
+        return false;
+    if (peep->action != PEEP_ACTION_NONE_1 && peep->action != PEEP_ACTION_NONE_2)
+        return false;
+    if (peep->guest_heading_to_ride_id == RIDE_ID_NULL || get_ride(peep->guest_heading_to_ride_id)->status != RIDE_STATUS_OPEN)
+        return false;
+    if (peep->GetNextIsSurface())
+        return false;
+
+    int32_t distance = abs(peep->x - peep->destination_x) + abs(peep->y - peep->destination_y);
+    return distance <= peep->destination_tolerance;
+}
+
+static void guest_path_finding_precompute(const rct_peep* peep)
+{
+    ride_id_t rideIndex = peep->guest_heading_to_ride_id;
+    gPeepPathFindQueueRideIndex = rideIndex;
+    gPeepPathFindGoalPosition = guest_path_find_ride_goal(peep, rideIndex);
+    gPeepPathFindIgnoreForeignQueues = true;
+
+    auto& entry = _guestPathFindPrecomputed[peep->sprite_index];
+    entry.Edges = 0;
+    entry.CacheInserts.clear();
+
+    // Choosing a direction updates the pathfind goal and history, so choose it for a copy of the guest.
+    rct_peep copy = *peep;
+    _guestPathFindRecording = &entry;
+    peep_pathfind_choose_direction({ copy.next_x / 32, copy.next_y / 32, copy.next_z }, &copy);
+    _guestPathFindRecording = nullptr;
+
+    if (entry.Edges != 0)
+    {
+        entry.Generation = _guestPathFindGeneration;
+    }
+}
+
+/**
+ * Runs the heuristic search for all the guests that are about to choose a direction towards a ride,
+ * in parallel on the job pool. The search only reads the map, so the results are recorded with their
+ * inputs and peep_pathfind_choose_direction uses them when the guest's update asks the same question.
+ * Anything that draws random numbers or changes the game state is still done by the serial update,
+ * so the outcome is identical with or without precomputing.
+ */
+void guest_path_finding_precompute_all()
+{
+    guest_path_finding_clear_precomputed();
+    if (!gConfigGeneral.multithreading)
+        return;
+
+    uint16_t spriteIndex;
+    rct_peep* peep;
+
+    _guestPathFindCandidates.clear();
+    FOR_ALL_GUESTS (spriteIndex, peep)
+    {
+        if (guest_path_finding_can_precompute(peep))
+        {
+            _guestPathFindCandidates.push_back(peep);
+        }
+    }
+    if (_guestPathFindCandidates.size() < GUEST_PATH_FIND_PRECOMPUTE_MIN_GUESTS)
+        return;
+
+    if (_guestPathFindPrecomputed.size() < sprite_get_capacity())
+    {
+        _guestPathFindPrecomputed.resize(sprite_get_capacity());
+    }
+
+    peep_pathfind_cache_remove_stale();
+    JobPool::ParallelFor(
+        0, _guestPathFindCandidates.size(),
+        [](size_t i) { guest_path_finding_precompute(_guestPathFindCandidates[i]); },
+        GUEST_PATH_FIND_PRECOMPUTE_BATCH_SIZE);
+
+    for (auto candidate : _guestPathFindCandidates)
+    {
+        auto& entry = _guestPathFindPrecomputed[candidate->sprite_index];
+        for (const auto& insert : entry.CacheInserts)
+        {
+            peep_pathfind_cache_insert(insert.first, insert.second);
+        }
+        entry.CacheInserts.clear();
+    }
+}
+
+/**
+ * Discards the results of guest_path_finding_precompute_all, they are only valid until the map changes.
+ */
+void guest_path_finding_clear_precomputed()
+{
+    _guestPathFindGeneration++;
+}
+
+/**
+ * Discards the cached search results that may depend on the map around the given tile (in world
+ * coordinates). Must be called whenever anything the search reads changes, i.e. footpaths, banners,
+ * entrances and tracks. Removing such an element with tile_element_remove already does so.
+ */
+void peep_pathfind_cache_invalidate(int32_t x, int32_t y)
+{
+    // The search also reads the tiles next to the ones it visits.
+    int32_t tileX = x >> 5;
+    int32_t tileY = y >> 5;
+    for (int32_t offsetY = -1; offsetY <= 1; offsetY++)
+    {
+        for (int32_t offsetX = -1; offsetX <= 1; offsetX++)
+        {
+            int32_t region = peep_pathfind_cache_get_region(tileX + offsetX, tileY + offsetY);
+            if (region != -1)
+            {
+                _pathFindCacheDirtyRegions.set(region);
+            }
+        }
+    }
+}
+
+void peep_pathfind_cache_clear()
+{
+    _pathFindCache.clear();
+    _pathFindCacheDirtyRegions.reset();
+}
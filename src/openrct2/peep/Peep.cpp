@@ -68,9 +68,9 @@ uint32_t gNextGuestNumber;
 
 uint8_t gPeepWarningThrottle[16];
 
-TileCoordsXYZ gPeepPathFindGoalPosition;
-bool gPeepPathFindIgnoreForeignQueues;
-ride_id_t gPeepPathFindQueueRideIndex;
+thread_local TileCoordsXYZ gPeepPathFindGoalPosition;
+thread_local bool gPeepPathFindIgnoreForeignQueues;
+thread_local ride_id_t gPeepPathFindQueueRideIndex;
 // uint32_t gPeepPathFindAltStationNum;
 
 static uint8_t _unk_F1AEF0;
@@ -428,6 +428,10 @@ void peep_update_all()
     if (gScreenFlags & (SCREEN_FLAGS_SCENARIO_EDITOR | SCREEN_FLAGS_TRACK_DESIGNER | SCREEN_FLAGS_TRACK_MANAGER))
         return;
 
+    // Search ahead for the guests that are about to choose a direction; the results are only
+    // used by the updates below if the guest still asks the same question.
+    guest_path_finding_precompute_all();
+
     spriteIndex = gSpriteListHead[SPRITE_LIST_PEEP];
     i = 0;
     while (spriteIndex != SPRITE_INDEX_NULL)
@@ -450,6 +454,8 @@ void peep_update_all()
 
         i++;
     }
+
+    guest_path_finding_clear_precomputed();
 }
 
 /**
@@ -836,7 +842,7 @@ bool rct_peep::Place(TileCoordsXYZ location, bool apply)
 
 bool peep_pickup_command(uint32_t peepnum, int32_t x, int32_t y, int32_t z, int32_t action, bool apply)
 {
-    if (peepnum >= MAX_SPRITES)
+    if (peepnum >= sprite_get_capacity())
     {
         log_error("Failed to pick up peep for sprite %d", peepnum);
         return false;
@@ -2770,27 +2776,24 @@ static void peep_footpath_move_forward(rct_peep* peep, int16_t x, int16_t y, Til
     uint16_t crowded = 0;
     uint8_t litter_count = 0;
     uint8_t sick_count = 0;
-    uint16_t sprite_id = sprite_get_first_in_quadrant(x, y);
-    for (rct_sprite* sprite; sprite_id != SPRITE_INDEX_NULL; sprite_id = sprite->generic.next_in_quadrant)
+    for (const auto& entry : sprite_get_quadrant(x, y))
     {
-        sprite = get_sprite(sprite_id);
+        if (abs(entry.z - peep->next_z * 8) > 16)
+            continue;
+
+        rct_sprite* sprite = get_sprite(entry.sprite_index);
         if (sprite->generic.sprite_identifier == SPRITE_IDENTIFIER_PEEP)
         {
             rct_peep* other_peep = (rct_peep*)sprite;
             if (other_peep->state != PEEP_STATE_WALKING)
                 continue;
 
-            if (abs(other_peep->z - peep->next_z * 8) > 16)
-                continue;
             crowded++;
             continue;
         }
         else if (sprite->generic.sprite_identifier == SPRITE_IDENTIFIER_LITTER)
         {
             rct_litter* litter = (rct_litter*)sprite;
-            if (abs(litter->z - peep->next_z * 8) > 16)
-                continue;
-
             litter_count++;
             if (litter->type != LITTER_TYPE_SICK && litter->type != LITTER_TYPE_SICK_ALT)
                 continue;
@@ -3312,25 +3315,19 @@ static void peep_apply_easter_egg_to_nearby_guests(rct_peep* peep, easter_egg_fu
     if (!peep_has_valid_xy(peep))
         return;
 
-    uint16_t spriteIndex = sprite_get_first_in_quadrant(peep->x, peep->y);
-    if (spriteIndex == SPRITE_INDEX_NULL)
-        return;
-
-    rct_peep* otherPeep = GET_PEEP(spriteIndex);
-    for (; spriteIndex != SPRITE_INDEX_NULL; spriteIndex = otherPeep->next_in_quadrant)
+    for (const auto& entry : sprite_get_quadrant(peep->x, peep->y))
     {
-        otherPeep = GET_PEEP(spriteIndex);
+        int32_t zDiff = abs(entry.z - peep->z);
+        if (zDiff > 32)
+            continue;
 
+        rct_peep* otherPeep = GET_PEEP(entry.sprite_index);
         if (otherPeep->sprite_identifier != SPRITE_IDENTIFIER_PEEP)
             continue;
 
         if (otherPeep->type != PEEP_TYPE_GUEST)
             continue;
 
-        int32_t zDiff = abs(otherPeep->z - peep->z);
-        if (zDiff > 32)
-            continue;
-
         easter_egg(peep, otherPeep);
     }
 }
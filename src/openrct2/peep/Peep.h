@@ -939,9 +939,10 @@ extern uint32_t gNextGuestNumber;
 
 extern uint8_t gPeepWarningThrottle[16];
 
-extern TileCoordsXYZ gPeepPathFindGoalPosition;
-extern bool gPeepPathFindIgnoreForeignQueues;
-extern ride_id_t gPeepPathFindQueueRideIndex;
+// Thread local so that the parallel guest pathfinding pass can search with its own goal.
+extern thread_local TileCoordsXYZ gPeepPathFindGoalPosition;
+extern thread_local bool gPeepPathFindIgnoreForeignQueues;
+extern thread_local ride_id_t gPeepPathFindQueueRideIndex;
 
 rct_peep* try_get_guest(uint16_t spriteIndex);
 int32_t peep_get_staff_count();
@@ -991,6 +992,10 @@ void peep_reset_pathfind_goal(rct_peep* peep);
 
 bool is_valid_path_z_and_direction(TileElement* tileElement, int32_t currentZ, int32_t currentDirection);
 int32_t guest_path_finding(rct_peep* peep);
+void guest_path_finding_precompute_all();
+void guest_path_finding_clear_precomputed();
+void peep_pathfind_cache_invalidate(int32_t x, int32_t y);
+void peep_pathfind_cache_clear();
 
 #if defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
 #    define PATHFIND_DEBUG                                                                                                     \
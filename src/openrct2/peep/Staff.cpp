@@ -374,7 +374,7 @@ void game_command_set_staff_patrol(
         int32_t x = *eax;
         int32_t y = *ecx;
         uint16_t sprite_id = *edx;
-        if (sprite_id >= MAX_SPRITES)
+        if (sprite_id >= sprite_get_capacity())
         {
             *ebx = MONEY32_UNDEFINED;
             log_warning("Invalid sprite id %u", sprite_id);
@@ -429,7 +429,7 @@ void game_command_fire_staff_member(
     {
         window_close_by_class(WC_FIRE_PROMPT);
         uint16_t sprite_id = *edx;
-        if (sprite_id >= MAX_SPRITES)
+        if (sprite_id >= sprite_get_capacity())
         {
             log_warning("Invalid game command, sprite_id = %u", sprite_id);
             *ebx = MONEY32_UNDEFINED;
@@ -2199,18 +2199,16 @@ static int32_t peep_update_patrolling_find_sweeping(rct_peep* peep)
     if (!(peep->staff_orders & STAFF_ORDERS_SWEEPING))
         return 0;
 
-    uint16_t sprite_id = sprite_get_first_in_quadrant(peep->x, peep->y);
-
-    for (rct_sprite* sprite = nullptr; sprite_id != SPRITE_INDEX_NULL; sprite_id = sprite->generic.next_in_quadrant)
+    for (const auto& entry : sprite_get_quadrant(peep->x, peep->y))
     {
-        sprite = get_sprite(sprite_id);
+        uint16_t z_diff = abs(peep->z - entry.z);
 
-        if (sprite->generic.linked_list_type_offset != SPRITE_LIST_LITTER * 2)
+        if (z_diff >= 16)
             continue;
 
-        uint16_t z_diff = abs(peep->z - sprite->litter.z);
+        rct_sprite* sprite = get_sprite(entry.sprite_index);
 
-        if (z_diff >= 16)
+        if (sprite->generic.linked_list_type_offset != SPRITE_LIST_LITTER * 2)
             continue;
 
         peep->SetState(PEEP_STATE_SWEEPING);
@@ -17,6 +17,7 @@
 #    include <cstring>
 #    include <ctime>
 #    include <pwd.h>
+#    include <sys/resource.h>
 
 namespace Platform
 {
@@ -96,6 +97,22 @@ namespace Platform
         }
         return isSupported;
     }
+
+    uint64_t GetPeakResidentMemory()
+    {
+        struct rusage usage;
+        if (getrusage(RUSAGE_SELF, &usage) != 0)
+        {
+            return 0;
+        }
+#    if defined(__APPLE__) && defined(__MACH__)
+        // macOS reports ru_maxrss in bytes
+        return (uint64_t)usage.ru_maxrss;
+#    else
+        // Linux and BSD report ru_maxrss in kilobytes
+        return (uint64_t)usage.ru_maxrss * 1024;
+#    endif
+    }
 } // namespace Platform
 
 #endif
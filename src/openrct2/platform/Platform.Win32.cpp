@@ -15,6 +15,7 @@
 // Then the rest
 #    include <datetimeapi.h>
 #    include <memory>
+#    include <psapi.h>
 #    include <shlobj.h>
 #    undef GetEnvironmentVariable
 
@@ -277,6 +278,16 @@ namespace Platform
         return isSupported;
     }
 
+    uint64_t GetPeakResidentMemory()
+    {
+        PROCESS_MEMORY_COUNTERS counters = {};
+        if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+        {
+            return counters.PeakWorkingSetSize;
+        }
+        return 0;
+    }
+
 #    ifdef __USE_SHGETKNOWNFOLDERPATH__
     static std::string WIN32_GetKnownFolderPath(REFKNOWNFOLDERID rfid)
     {
@@ -46,4 +46,9 @@ namespace Platform
 #endif
 
     bool IsColourTerminalSupported();
+
+    /**
+     * Gets the peak resident memory of the current process in bytes, or 0 if unavailable.
+     */
+    uint64_t GetPeakResidentMemory();
 } // namespace Platform
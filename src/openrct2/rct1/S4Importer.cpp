@@ -1350,7 +1350,7 @@ private:
                 ImportPeep(peep, srcPeep);
             }
         }
-        for (size_t i = 0; i < MAX_SPRITES; i++)
+        for (size_t i = 0; i < sprite_get_capacity(); i++)
         {
             rct_sprite* sprite = get_sprite(i);
             if (sprite->generic.sprite_identifier == SPRITE_IDENTIFIER_VEHICLE)
@@ -1802,13 +1802,13 @@ private:
     void ImportMapAnimations()
     {
         // This is sketchy, ideally we should try to re-create them
-        rct_map_animation* s4Animations = _s4.map_animations;
-        for (size_t i = 0; i < RCT1_MAX_ANIMATED_OBJECTS; i++)
+        size_t numAnimations = std::min<size_t>(_s4.num_map_animations, RCT1_MAX_ANIMATED_OBJECTS);
+        std::vector<rct_map_animation> animations(_s4.map_animations, _s4.map_animations + numAnimations);
+        for (auto& animation : animations)
         {
-            gAnimatedObjects[i] = s4Animations[i];
-            gAnimatedObjects[i].baseZ /= 2;
+            animation.baseZ /= 2;
         }
-        gNumMapAnimations = _s4.num_map_animations;
+        map_animation_load(animations);
     }
 
     void ImportFinance()
@@ -1992,10 +1992,11 @@ private:
     {
         gMapBaseZ = 7;
 
-        for (uint32_t index = 0, dstOffset = 0; index < RCT1_MAX_TILE_ELEMENTS; index++)
+        std::vector<TileElement> tileElements(RCT1_MAX_TILE_ELEMENTS);
+        for (uint32_t index = 0; index < RCT1_MAX_TILE_ELEMENTS; index++)
         {
             auto src = &_s4.tile_elements[index];
-            auto dst = &gTileElements[index + dstOffset];
+            auto dst = &tileElements[index];
             if (src->base_height == 0xFF)
             {
                 std::memcpy(dst, src, sizeof(*src));
@@ -2006,7 +2007,7 @@ private:
             }
         }
 
-        ClearExtraTileEntries();
+        ClearExtraTileEntries(tileElements);
         FixWalls();
         FixEntrancePositions();
     }
@@ -2662,21 +2663,23 @@ private:
         gSavedViewRotation = _s4.view_rotation;
     }
 
-    void ClearExtraTileEntries()
+    /**
+     * Lays out the RCT1 tiles for the larger map, with blank tiles for the part the RCT1 map does not cover.
+     */
+    void ClearExtraTileEntries(const std::vector<TileElement>& rct1TileElements)
     {
-        // Reset the map tile pointers
-        std::fill(std::begin(gTileElementTilePointers), std::end(gTileElementTilePointers), nullptr);
+        TileElement blankTile;
+        blankTile.ClearAs(TILE_ELEMENT_TYPE_SURFACE);
+        blankTile.flags = TILE_ELEMENT_FLAG_LAST_TILE;
+        blankTile.AsSurface()->SetSlope(TILE_ELEMENT_SLOPE_FLAT);
+        blankTile.AsSurface()->SetSurfaceStyle(TERRAIN_GRASS);
+        blankTile.AsSurface()->SetEdgeStyle(TERRAIN_EDGE_ROCK);
+        blankTile.AsSurface()->SetGrassLength(GRASS_LENGTH_CLEAR_0);
+        blankTile.AsSurface()->SetOwnership(OWNERSHIP_UNOWNED);
 
-        // Get the first free map element
-        TileElement* nextFreeTileElement = gTileElements;
-        for (size_t i = 0; i < RCT1_MAX_MAP_SIZE * RCT1_MAX_MAP_SIZE; i++)
-        {
-            while (!(nextFreeTileElement++)->IsLastForTile())
-                ;
-        }
-
-        TileElement* tileElement = gTileElements;
-        TileElement** tilePointer = gTileElementTilePointers;
+        std::vector<TileElement> tileElements;
+        tileElements.reserve(rct1TileElements.size() + MAX_TILE_TILE_ELEMENT_POINTERS);
+        auto tileElement = rct1TileElements.begin();
 
         // 128 rows of map data from RCT1 map
         for (int32_t x = 0; x < RCT1_MAX_MAP_SIZE; x++)
@@ -2684,39 +2687,21 @@ private:
             // Assign the first half of this row
             for (int32_t y = 0; y < RCT1_MAX_MAP_SIZE; y++)
             {
-                *tilePointer++ = tileElement;
-                while (!(tileElement++)->IsLastForTile())
-                    ;
+                do
+                {
+                    tileElements.push_back(*tileElement);
+                } while (!(tileElement++)->IsLastForTile());
             }
 
             // Fill the rest of the row with blank tiles
-            for (int32_t y = 0; y < RCT1_MAX_MAP_SIZE; y++)
-            {
-                nextFreeTileElement->ClearAs(TILE_ELEMENT_TYPE_SURFACE);
-                nextFreeTileElement->flags = TILE_ELEMENT_FLAG_LAST_TILE;
-                nextFreeTileElement->AsSurface()->SetSlope(TILE_ELEMENT_SLOPE_FLAT);
-                nextFreeTileElement->AsSurface()->SetSurfaceStyle(TERRAIN_GRASS);
-                nextFreeTileElement->AsSurface()->SetEdgeStyle(TERRAIN_EDGE_ROCK);
-                nextFreeTileElement->AsSurface()->SetGrassLength(GRASS_LENGTH_CLEAR_0);
-                nextFreeTileElement->AsSurface()->SetOwnership(OWNERSHIP_UNOWNED);
-                *tilePointer++ = nextFreeTileElement++;
-            }
+            tileElements.insert(tileElements.end(), MAXIMUM_MAP_SIZE_TECHNICAL - RCT1_MAX_MAP_SIZE, blankTile);
         }
 
         // 128 extra rows left to fill with blank tiles
-        for (int32_t y = 0; y < 128 * 256; y++)
-        {
-            nextFreeTileElement->ClearAs(TILE_ELEMENT_TYPE_SURFACE);
-            nextFreeTileElement->flags = TILE_ELEMENT_FLAG_LAST_TILE;
-            nextFreeTileElement->AsSurface()->SetSlope(TILE_ELEMENT_SLOPE_FLAT);
-            nextFreeTileElement->AsSurface()->SetSurfaceStyle(TERRAIN_GRASS);
-            nextFreeTileElement->AsSurface()->SetEdgeStyle(TERRAIN_EDGE_ROCK);
-            nextFreeTileElement->AsSurface()->SetGrassLength(GRASS_LENGTH_CLEAR_0);
-            nextFreeTileElement->AsSurface()->SetOwnership(OWNERSHIP_UNOWNED);
-            *tilePointer++ = nextFreeTileElement++;
-        }
+        tileElements.insert(
+            tileElements.end(), (MAXIMUM_MAP_SIZE_TECHNICAL - RCT1_MAX_MAP_SIZE) * MAXIMUM_MAP_SIZE_TECHNICAL, blankTile);
 
-        gNextFreeTileElement = nextFreeTileElement;
+        map_load_tile_elements(tileElements);
     }
 
     void FixWalls()
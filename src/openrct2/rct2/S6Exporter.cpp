@@ -16,6 +16,7 @@
 #include "../config/Config.h"
 #include "../core/FileStream.hpp"
 #include "../core/IStream.hpp"
+#include "../core/MemoryStream.h"
 #include "../core/String.hpp"
 #include "../interface/Viewport.h"
 #include "../interface/Window.h"
@@ -53,6 +54,7 @@
 S6Exporter::S6Exporter()
 {
     RemoveTracklessRides = false;
+    ExtendedSpritePoolFollows = false;
     std::memset(&_s6, 0x00, sizeof(_s6));
 }
 
@@ -99,7 +101,11 @@ void S6Exporter::Save(IStream* stream, bool isScenario)
     }
 
     // 2: Write packed objects
-    if (_s6.header.num_packed_objects > 0)
+    if (_hasPackedObjects)
+    {
+        stream->Write(_packedObjects.data(), _packedObjects.size());
+    }
+    else if (_s6.header.num_packed_objects > 0)
     {
         auto& objRepo = OpenRCT2::GetContext()->GetObjectRepository();
         objRepo.WritePackedObjects(stream, ExportObjectsList);
@@ -146,6 +152,19 @@ void S6Exporter::Save(IStream* stream, bool isScenario)
     stream->WriteValue(checksum);
 }
 
+void S6Exporter::ExportPackedObjects()
+{
+    auto ms = MemoryStream();
+    if (!ExportObjectsList.empty())
+    {
+        auto& objRepo = OpenRCT2::GetContext()->GetObjectRepository();
+        objRepo.WritePackedObjects(&ms, ExportObjectsList);
+    }
+    auto data = (const uint8_t*)ms.GetData();
+    _packedObjects.assign(data, data + ms.GetLength());
+    _hasPackedObjects = true;
+}
+
 void S6Exporter::Export()
 {
     int32_t spatial_cycle = check_for_spatial_index_cycles(false);
@@ -193,24 +212,9 @@ void S6Exporter::Export()
     _s6.scenario_srand_0 = state.s0;
     _s6.scenario_srand_1 = state.s1;
 
-    std::memcpy(_s6.tile_elements, gTileElements, sizeof(_s6.tile_elements));
+    ExportTileElements();
 
     _s6.next_free_tile_element_pointer_index = gNextFreeTileElementPointerIndex;
-    // Sprites needs to be reset before they get used.
-    // Might as well reset them in here to zero out the space and improve
-    // compression ratios. Especially useful for multiplayer servers that
-    // use zlib on the sent stream.
-    sprite_clear_all_unused();
-    for (int32_t i = 0; i < RCT2_MAX_SPRITES; i++)
-    {
-        std::memcpy(&_s6.sprites[i], get_sprite(i), sizeof(rct_sprite));
-    }
-
-    for (int32_t i = 0; i < NUM_SPRITE_LISTS; i++)
-    {
-        _s6.sprite_lists_head[i] = gSpriteListHead[i];
-        _s6.sprite_lists_count[i] = gSpriteListCount[i];
-    }
     _s6.park_name = gParkName;
     // pad_013573D6
     _s6.park_name_args = gParkNameArgs;
@@ -368,8 +372,9 @@ void S6Exporter::Export()
     _s6.saved_view_y = gSavedViewY;
     _s6.saved_view_zoom = gSavedViewZoom;
     _s6.saved_view_rotation = gSavedViewRotation;
-    std::memcpy(_s6.map_animations, gAnimatedObjects, sizeof(_s6.map_animations));
-    _s6.num_map_animations = gNumMapAnimations;
+    auto animations = map_animation_get_all();
+    std::copy(animations.begin(), animations.end(), _s6.map_animations);
+    _s6.num_map_animations = (uint16_t)animations.size();
     // pad_0138B582
 
     _s6.ride_ratings_calc_data = gRideRatingsCalcData;
@@ -412,6 +417,9 @@ void S6Exporter::Export()
         std::memcpy(dst->Text, src->Text, sizeof(dst->Text));
     }
 
+    // Needs to be done after the rides and news items, as those may refer to sprites that get moved
+    ExportSprites();
+
     // pad_13CE730
     // rct1_scenario_flags
     _s6.wide_path_tile_loop_x = gWidePathTileLoopX;
@@ -429,6 +437,311 @@ void S6Exporter::Export()
     game_convert_strings_to_rct2(&_s6);
 }
 
+void S6Exporter::ExportSprites()
+{
+    // Sprites needs to be reset before they get used.
+    // Might as well reset them in here to zero out the space and improve
+    // compression ratios. Especially useful for multiplayer servers that
+    // use zlib on the sent stream.
+    sprite_clear_all_unused();
+
+    if (sprite_get_capacity() > RCT2_MAX_SPRITES)
+    {
+        ExportSpritesDowngraded();
+        return;
+    }
+
+    for (int32_t i = 0; i < RCT2_MAX_SPRITES; i++)
+    {
+        std::memcpy(&_s6.sprites[i], get_sprite(i), sizeof(rct_sprite));
+    }
+
+    for (int32_t i = 0; i < NUM_SPRITE_LISTS; i++)
+    {
+        _s6.sprite_lists_head[i] = gSpriteListHead[i];
+        _s6.sprite_lists_count[i] = gSpriteListCount[i];
+    }
+}
+
+/**
+ * Guests that are not referenced by a ride, vehicle or another peep and can be left out of a save without a trace.
+ */
+static bool sprite_can_be_dropped(const rct_sprite* sprite)
+{
+    switch (sprite->generic.sprite_identifier)
+    {
+        case SPRITE_IDENTIFIER_LITTER:
+        case SPRITE_IDENTIFIER_MISC:
+            return true;
+        case SPRITE_IDENTIFIER_PEEP:
+            if (sprite->peep.type != PEEP_TYPE_GUEST)
+                return false;
+            switch (sprite->peep.state)
+            {
+                case PEEP_STATE_WALKING:
+                case PEEP_STATE_SITTING:
+                case PEEP_STATE_WATCHING:
+                case PEEP_STATE_USING_BIN:
+                    return true;
+                default:
+                    return false;
+            }
+        default:
+            return false;
+    }
+}
+
+/**
+ * Fits a grown sprite pool into the RCT2_MAX_SPRITES slots of an S6 file. Sprites beyond the limit are
+ * moved into free slots and every reference to them is updated. If there are not enough free slots,
+ * litter, misc sprites and then guests that are just walking around are left out, highest index first.
+ *
+ * If the extended sprite pool follows, the sprite array only has to load without errors before it is
+ * replaced by the pool. References from rides, news items and the guest counts are left as they are,
+ * as they have to match the pool rather than the sprite array.
+ */
+void S6Exporter::ExportSpritesDowngraded()
+{
+    size_t capacity = sprite_get_capacity();
+
+    std::vector<uint16_t> freeSlots;
+    size_t numHighSprites = 0;
+    for (size_t i = 0; i < capacity; i++)
+    {
+        bool isNull = get_sprite(i)->generic.sprite_identifier == SPRITE_IDENTIFIER_NULL;
+        if (i < RCT2_MAX_SPRITES && isNull)
+        {
+            freeSlots.push_back((uint16_t)i);
+        }
+        else if (i >= RCT2_MAX_SPRITES && !isNull)
+        {
+            numHighSprites++;
+        }
+    }
+
+    // Choose which sprites to leave out, dropping sprites that do not fit first
+    std::vector<bool> dropped(capacity, false);
+    size_t numToDrop = numHighSprites > freeSlots.size() ? numHighSprites - freeSlots.size() : 0;
+    if (numToDrop > 0)
+    {
+        log_warning("Sprite pool does not fit in an S6 file, leaving out %u sprites", (uint32_t)numToDrop);
+    }
+    for (int32_t pass = 0; pass < 3 && numToDrop > 0; pass++)
+    {
+        for (size_t i = capacity; i-- > 0 && numToDrop > 0;)
+        {
+            const rct_sprite* sprite = get_sprite(i);
+            if (dropped[i] || !sprite_can_be_dropped(sprite))
+                continue;
+
+            uint8_t identifier = sprite->generic.sprite_identifier;
+            if ((pass == 0 && identifier == SPRITE_IDENTIFIER_LITTER) || (pass == 1 && identifier == SPRITE_IDENTIFIER_MISC)
+                || (pass == 2 && identifier == SPRITE_IDENTIFIER_PEEP))
+            {
+                dropped[i] = true;
+                numToDrop--;
+                if (identifier == SPRITE_IDENTIFIER_PEEP && !ExtendedSpritePoolFollows)
+                {
+                    if (sprite->peep.outside_of_park == 0)
+                        _s6.guests_in_park--;
+                    else
+                        _s6.guests_heading_for_park--;
+                }
+            }
+        }
+    }
+    if (numToDrop > 0)
+    {
+        // Only vehicles, staff and guests on rides are left, these can not be saved.
+        log_error("Unable to fit %u sprites in an S6 file", (uint32_t)numToDrop);
+    }
+
+    // Map every sprite to its index in the file. Dropped low sprites free up their slot for high sprites.
+    std::vector<uint16_t> indexMap(capacity, SPRITE_INDEX_NULL);
+    for (size_t i = 0; i < RCT2_MAX_SPRITES; i++)
+    {
+        if (dropped[i])
+        {
+            freeSlots.push_back((uint16_t)i);
+        }
+        else
+        {
+            indexMap[i] = (uint16_t)i;
+        }
+    }
+    size_t nextFreeSlot = 0;
+    for (size_t i = RCT2_MAX_SPRITES; i < capacity; i++)
+    {
+        if (get_sprite(i)->generic.sprite_identifier == SPRITE_IDENTIFIER_NULL || dropped[i])
+            continue;
+
+        if (nextFreeSlot < freeSlots.size())
+        {
+            indexMap[i] = freeSlots[nextFreeSlot++];
+        }
+    }
+    auto remap = [&indexMap](uint16_t spriteIndex) -> uint16_t {
+        return spriteIndex < indexMap.size() ? indexMap[spriteIndex] : SPRITE_INDEX_NULL;
+    };
+
+    // Copy the sprites into their new slots, every slot that is not used ends up as a null sprite
+    std::vector<bool> used(RCT2_MAX_SPRITES, false);
+    for (size_t i = 0; i < capacity; i++)
+    {
+        uint16_t newIndex = indexMap[i];
+        if (newIndex == SPRITE_INDEX_NULL || get_sprite(i)->generic.sprite_identifier == SPRITE_IDENTIFIER_NULL)
+            continue;
+
+        rct_sprite* dst = &_s6.sprites[newIndex];
+        std::memcpy(dst, get_sprite(i), sizeof(rct_sprite));
+        dst->generic.sprite_index = newIndex;
+        used[newIndex] = true;
+
+        if (dst->generic.sprite_identifier == SPRITE_IDENTIFIER_VEHICLE)
+        {
+            rct_vehicle* vehicle = &dst->vehicle;
+            vehicle->next_vehicle_on_train = remap(vehicle->next_vehicle_on_train);
+            vehicle->prev_vehicle_on_ride = remap(vehicle->prev_vehicle_on_ride);
+            vehicle->next_vehicle_on_ride = remap(vehicle->next_vehicle_on_ride);
+            for (auto& peepIndex : vehicle->peep)
+            {
+                peepIndex = remap(peepIndex);
+            }
+        }
+        else if (dst->generic.sprite_identifier == SPRITE_IDENTIFIER_PEEP && dst->peep.type == PEEP_TYPE_GUEST)
+        {
+            dst->peep.next_in_queue = remap(dst->peep.next_in_queue);
+        }
+    }
+    for (size_t i = 0; i < RCT2_MAX_SPRITES; i++)
+    {
+        if (!used[i])
+        {
+            rct_sprite* dst = &_s6.sprites[i];
+            std::memset(dst, 0, sizeof(rct_sprite));
+            dst->generic.sprite_identifier = SPRITE_IDENTIFIER_NULL;
+            dst->generic.linked_list_type_offset = SPRITE_LIST_NULL * 2;
+            dst->generic.sprite_index = (uint16_t)i;
+            dst->generic.x = LOCATION_NULL;
+            dst->generic.y = LOCATION_NULL;
+        }
+    }
+
+    // Rebuild the sprite lists in their original order, dropping sprites that did not make it.
+    // The free list keeps the order of the free slots that are left, followed by the slots of dropped sprites.
+    std::vector<bool> linked(RCT2_MAX_SPRITES, false);
+    for (int32_t list = 0; list < NUM_SPRITE_LISTS; list++)
+    {
+        uint16_t tail = SPRITE_INDEX_NULL;
+        uint16_t count = 0;
+        _s6.sprite_lists_head[list] = SPRITE_INDEX_NULL;
+        auto append = [&](uint16_t newIndex) {
+            rct_sprite_generic* sprite = &_s6.sprites[newIndex].generic;
+            sprite->previous = tail;
+            sprite->next = SPRITE_INDEX_NULL;
+            if (tail == SPRITE_INDEX_NULL)
+                _s6.sprite_lists_head[list] = newIndex;
+            else
+                _s6.sprites[tail].generic.next = newIndex;
+            tail = newIndex;
+            linked[newIndex] = true;
+            count++;
+        };
+
+        for (uint16_t i = gSpriteListHead[list]; i != SPRITE_INDEX_NULL; i = get_sprite(i)->generic.next)
+        {
+            uint16_t newIndex = remap(i);
+            if (newIndex == SPRITE_INDEX_NULL || linked[newIndex])
+                continue;
+
+            if ((list == SPRITE_LIST_NULL) != used[newIndex])
+            {
+                append(newIndex);
+            }
+        }
+        if (list == SPRITE_LIST_NULL)
+        {
+            for (size_t i = 0; i < RCT2_MAX_SPRITES; i++)
+            {
+                if (!used[i] && !linked[i])
+                {
+                    append((uint16_t)i);
+                }
+            }
+        }
+        _s6.sprite_lists_count[list] = count;
+    }
+
+    // Relink the spatial index lists the same way, they are rebuilt on load but should not contain stale indices
+    for (auto& sprite : _s6.sprites)
+    {
+        sprite.generic.next_in_quadrant = SPRITE_INDEX_NULL;
+    }
+    for (uint16_t head : gSpriteSpatialIndex)
+    {
+        uint16_t tail = SPRITE_INDEX_NULL;
+        for (uint16_t i = head; i != SPRITE_INDEX_NULL; i = get_sprite(i)->generic.next_in_quadrant)
+        {
+            uint16_t newIndex = remap(i);
+            if (newIndex == SPRITE_INDEX_NULL || !used[newIndex])
+                continue;
+
+            if (tail != SPRITE_INDEX_NULL)
+                _s6.sprites[tail].generic.next_in_quadrant = newIndex;
+            tail = newIndex;
+        }
+    }
+
+    if (ExtendedSpritePoolFollows)
+    {
+        return;
+    }
+
+    // Fix up the references to sprites from outside the sprite array
+    for (auto& ride : _s6.rides)
+    {
+        if (ride.type == RIDE_TYPE_NULL)
+            continue;
+
+        for (auto& vehicle : ride.vehicles)
+        {
+            vehicle = remap(vehicle);
+        }
+        for (auto& lastPeep : ride.last_peep_in_queue)
+        {
+            lastPeep = remap(lastPeep);
+        }
+        ride.race_winner = remap(ride.race_winner);
+        ride.mechanic = remap(ride.mechanic);
+        ride.cable_lift = remap(ride.cable_lift);
+        if (ride.cable_lift != SPRITE_INDEX_NULL)
+        {
+            rct_vehicle* cableLift = &_s6.sprites[ride.cable_lift].vehicle;
+            cableLift->cable_lift_target = remap(cableLift->cable_lift_target);
+        }
+    }
+    for (auto& newsItem : _s6.news_items)
+    {
+        if (newsItem.Type == NEWS_ITEM_PEEP || newsItem.Type == NEWS_ITEM_PEEP_ON_RIDE)
+        {
+            newsItem.Assoc = remap(newsItem.Assoc);
+        }
+    }
+}
+
+void S6Exporter::ExportTileElements()
+{
+    auto tileElements = map_get_tile_elements();
+    size_t numElements = tileElements.size();
+    if (numElements > RCT2_MAX_TILE_ELEMENTS)
+    {
+        log_error("Unable to fit %u tile elements in an S6 file", (uint32_t)numElements);
+        numElements = RCT2_MAX_TILE_ELEMENTS;
+    }
+    std::memcpy(_s6.tile_elements, tileElements.data(), numElements * sizeof(TileElement));
+    std::memset(&_s6.tile_elements[numElements], 0, (RCT2_MAX_TILE_ELEMENTS - numElements) * sizeof(RCT12TileElement));
+}
+
 void S6Exporter::ExportPeepSpawns()
 {
     for (size_t i = 0; i < RCT12_MAX_PEEP_SPAWNS; i++)
@@ -25,6 +25,9 @@ class S6Exporter final
 {
 public:
     bool RemoveTracklessRides;
+    // Set when sprite_write_extended_pool is written after the S6 data, which restores the exact sprite pool.
+    // Sprites are still fitted into the S6 sprite array, but references to them from outside of it are kept.
+    bool ExtendedSpritePoolFollows;
     std::vector<const ObjectRepositoryItem*> ExportObjectsList;
 
     S6Exporter();
@@ -34,11 +37,18 @@ public:
     void SaveScenario(const utf8* path);
     void SaveScenario(IStream* stream);
     void Export();
+    /**
+     * Packs the custom objects of ExportObjectsList straight away, so saving no longer reads from the object
+     * repository and can be done on another thread.
+     */
+    void ExportPackedObjects();
     void ExportRides();
     void ExportRide(rct2_ride* dst, const Ride* src);
 
 private:
     rct_s6_data _s6{};
+    std::vector<uint8_t> _packedObjects;
+    bool _hasPackedObjects = false;
 
     void Save(IStream* stream, bool isScenario);
     static uint32_t GetLoanHash(money32 initialCash, money32 bankLoan, uint32_t maxBankLoan);
@@ -47,4 +57,7 @@ private:
     void ExportResearchedSceneryItems();
     void ExportResearchList();
     void ExportPeepSpawns();
+    void ExportTileElements();
+    void ExportSprites();
+    void ExportSpritesDowngraded();
 };
@@ -214,6 +214,8 @@ public:
         ImportTileElements();
 
         gNextFreeTileElementPointerIndex = _s6.next_free_tile_element_pointer_index;
+        // Any sprites beyond what the file holds are released, the pool grows again when it runs out.
+        sprite_set_capacity(RCT2_MAX_SPRITES);
         for (int32_t i = 0; i < RCT2_MAX_SPRITES; i++)
         {
             std::memcpy(get_sprite(i), &_s6.sprites[i], sizeof(rct_sprite));
@@ -225,7 +227,7 @@ public:
             gSpriteListCount[i] = _s6.sprite_lists_count[i];
         }
         // This list contains the number of free slots. Increase it according to our own sprite limit.
-        gSpriteListCount[SPRITE_LIST_NULL] += (MAX_SPRITES - RCT2_MAX_SPRITES);
+        gSpriteListCount[SPRITE_LIST_NULL] += (uint16_t)(sprite_get_capacity() - RCT2_MAX_SPRITES);
 
         gParkName = _s6.park_name;
         // pad_013573D6
@@ -401,11 +403,8 @@ public:
         gSavedViewZoom = _s6.saved_view_zoom;
         gSavedViewRotation = _s6.saved_view_rotation;
 
-        for (size_t i = 0; i < RCT2_MAX_ANIMATED_OBJECTS; i++)
-        {
-            gAnimatedObjects[i] = _s6.map_animations[i];
-        }
-        gNumMapAnimations = _s6.num_map_animations;
+        size_t numAnimations = std::min<size_t>(_s6.num_map_animations, RCT2_MAX_ANIMATED_OBJECTS);
+        map_animation_load(std::vector<rct_map_animation>(_s6.map_animations, _s6.map_animations + numAnimations));
         // pad_0138B582
 
         gRideRatingsCalcData = _s6.ride_ratings_calc_data;
@@ -467,7 +466,6 @@ public:
 
         // Fix and set dynamic variables
         map_strip_ghost_flag_from_elements();
-        map_update_tile_pointers();
         game_convert_strings_to_utf8();
         map_count_remaining_land_rights();
         determine_ride_entrance_and_exit_locations();
@@ -862,10 +860,11 @@ public:
 
     void ImportTileElements()
     {
+        std::vector<TileElement> tileElements(RCT2_MAX_TILE_ELEMENTS);
         for (uint32_t index = 0; index < RCT2_MAX_TILE_ELEMENTS; index++)
         {
             auto src = &_s6.tile_elements[index];
-            auto dst = &gTileElements[index];
+            auto dst = &tileElements[index];
             if (src->base_height == 0xFF)
             {
                 std::memcpy(dst, src, sizeof(*src));
@@ -882,6 +881,7 @@ public:
                     ImportTileElement(dst, src);
             }
         }
+        map_load_tile_elements(tileElements);
     }
     void ImportTileElement(TileElement* dst, const RCT12TileElement* src)
     {
@@ -8806,6 +8806,7 @@ void ride_clear_leftover_entrances(ride_id_t rideIndex)
             && it.element->AsEntrance()->GetEntranceType() != ENTRANCE_TYPE_PARK_ENTRANCE
             && it.element->AsEntrance()->GetRideIndex() == rideIndex)
         {
+            peep_pathfind_cache_invalidate(it.x * 32, it.y * 32);
             tile_element_remove(it.element);
             tile_element_iterator_restart_for_tile(&it);
         }
@@ -60,3 +60,4 @@ extern rct_ride_rating_calc_data gRideRatingsCalcData;
 
 void ride_ratings_update_ride(ride_id_t rideIndex);
 void ride_ratings_update_all();
+void ride_ratings_calculate_all();
@@ -1793,6 +1793,7 @@ static money32 track_remove(
         {
             footpath_remove_edges_at(x, y, tileElement);
         }
+        peep_pathfind_cache_invalidate(x, y);
         tile_element_remove(tileElement);
         sub_6CB945(rideIndex);
         if (!(flags & GAME_COMMAND_FLAG_GHOST))
@@ -46,9 +46,7 @@
 
 struct map_backup
 {
-    TileElement tile_elements[MAX_TILE_ELEMENTS];
-    TileElement* tile_pointers[MAX_TILE_TILE_ELEMENT_POINTERS];
-    TileElement* next_free_tile_element;
+    std::vector<TileElement> tile_elements;
     uint16_t map_size_units;
     uint16_t map_size_units_minus_2;
     uint16_t map_size;
@@ -2290,12 +2288,10 @@ void track_design_draw_preview(rct_track_td6* td6, uint8_t* pixels)
  */
 static map_backup* track_design_preview_backup_map()
 {
-    map_backup* backup = (map_backup*)malloc(sizeof(map_backup));
+    map_backup* backup = new map_backup();
     if (backup != nullptr)
     {
-        std::memcpy(backup->tile_elements, gTileElements, sizeof(backup->tile_elements));
-        std::memcpy(backup->tile_pointers, gTileElementTilePointers, sizeof(backup->tile_pointers));
-        backup->next_free_tile_element = gNextFreeTileElement;
+        backup->tile_elements = map_get_tile_elements();
         backup->map_size_units = gMapSizeUnits;
         backup->map_size_units_minus_2 = gMapSizeMinus2;
         backup->map_size = gMapSize;
@@ -2310,15 +2306,13 @@ static map_backup* track_design_preview_backup_map()
  */
 static void track_design_preview_restore_map(map_backup* backup)
 {
-    std::memcpy(gTileElements, backup->tile_elements, sizeof(backup->tile_elements));
-    std::memcpy(gTileElementTilePointers, backup->tile_pointers, sizeof(backup->tile_pointers));
-    gNextFreeTileElement = backup->next_free_tile_element;
+    map_load_tile_elements(backup->tile_elements);
     gMapSizeUnits = backup->map_size_units;
     gMapSizeMinus2 = backup->map_size_units_minus_2;
     gMapSize = backup->map_size;
     gCurrentRotation = backup->current_rotation;
 
-    free(backup);
+    delete backup;
 }
 
 /**
@@ -2333,9 +2327,10 @@ static void track_design_preview_clear_map()
     gMapSizeMinus2 = (264 * 32) - 2;
     gMapSize = 256;
 
-    for (int32_t i = 0; i < MAX_TILE_TILE_ELEMENT_POINTERS; i++)
+    std::vector<TileElement> tileElements(MAX_TILE_TILE_ELEMENT_POINTERS);
+    for (auto& element : tileElements)
     {
-        TileElement* tile_element = &gTileElements[i];
+        TileElement* tile_element = &element;
         tile_element->ClearAs(TILE_ELEMENT_TYPE_SURFACE);
         tile_element->flags = TILE_ELEMENT_FLAG_LAST_TILE;
         tile_element->AsSurface()->SetSlope(TILE_ELEMENT_SLOPE_FLAT);
@@ -2346,7 +2341,7 @@ static void track_design_preview_clear_map()
         tile_element->AsSurface()->SetOwnership(OWNERSHIP_OWNED);
         tile_element->AsSurface()->SetParkFences(0);
     }
-    map_update_tile_pointers();
+    map_load_tile_elements(tileElements);
 }
 
 bool track_design_are_entrance_and_exit_placed()
@@ -6453,27 +6453,24 @@ bool vehicle_update_dodgems_collision(rct_vehicle* vehicle, int16_t x, int16_t y
         location.x += xy_offset.x;
         location.y += xy_offset.y;
 
-        uint16_t spriteIdx = sprite_get_first_in_quadrant(location.x * 32, location.y * 32);
-        while (spriteIdx != SPRITE_INDEX_NULL)
+        for (const auto& entry : sprite_get_quadrant(location.x * 32, location.y * 32))
         {
-            rct_vehicle* vehicle2 = GET_VEHICLE(spriteIdx);
-            spriteIdx = vehicle2->next_in_quadrant;
-
-            if (vehicle2 == vehicle)
+            int32_t distX = abs(x - entry.x);
+            if (distX > 32768)
                 continue;
 
-            if (vehicle2->sprite_identifier != SPRITE_IDENTIFIER_VEHICLE)
+            int32_t distY = abs(y - entry.y);
+            if (distY > 32768)
                 continue;
 
-            if (vehicle2->ride != rideIndex)
+            rct_vehicle* vehicle2 = GET_VEHICLE(entry.sprite_index);
+            if (vehicle2 == vehicle)
                 continue;
 
-            int32_t distX = abs(x - vehicle2->x);
-            if (distX > 32768)
+            if (vehicle2->sprite_identifier != SPRITE_IDENTIFIER_VEHICLE)
                 continue;
 
-            int32_t distY = abs(y - vehicle2->y);
-            if (distY > 32768)
+            if (vehicle2->ride != rideIndex)
                 continue;
 
             int32_t ecx = (vehicle->var_44 + vehicle2->var_44) / 2;
@@ -7685,9 +7682,14 @@ static bool vehicle_update_motion_collision_detection(
         location.x += xy_offset.x;
         location.y += xy_offset.y;
 
-        collideId = sprite_get_first_in_quadrant(location.x * 32, location.y * 32);
-        for (; collideId != SPRITE_INDEX_NULL; collideId = collideVehicle->next_in_quadrant)
+        for (const auto& entry : sprite_get_quadrant(location.x * 32, location.y * 32))
         {
+            int32_t z_diff = abs(entry.z - z);
+
+            if (z_diff > 16)
+                continue;
+
+            collideId = entry.sprite_index;
             collideVehicle = GET_VEHICLE(collideId);
             if (collideVehicle == vehicle)
                 continue;
@@ -7695,11 +7697,6 @@ static bool vehicle_update_motion_collision_detection(
             if (collideVehicle->sprite_identifier != SPRITE_IDENTIFIER_VEHICLE)
                 continue;
 
-            int32_t z_diff = abs(collideVehicle->z - z);
-
-            if (z_diff > 16)
-                continue;
-
             if (collideVehicle->ride_subtype == RIDE_TYPE_NULL)
                 continue;
 
@@ -157,6 +157,11 @@ protected:
         }
     }
 
+    void UpdateLastModified(scenario_index_entry& item, uint64_t lastModified) const override
+    {
+        item.timestamp = lastModified;
+    }
+
     void Serialise(IStream* stream, const scenario_index_entry& item) const override
     {
         stream->Write(item.path, sizeof(item.path));
@@ -42,7 +42,8 @@ enum
     FILE_TYPE_SC4 = (2 << 2)
 };
 
-extern bool gUseRLE;
+// Per thread, so that maps can be encoded for the network in the background.
+extern thread_local bool gUseRLE;
 
 uint32_t sawyercoding_calculate_checksum(const uint8_t* buffer, size_t length);
 size_t sawyercoding_write_chunk_buffer(uint8_t* dst_file, const uint8_t* src_buffer, sawyercoding_chunk_header chunkHeader);
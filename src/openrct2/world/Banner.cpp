@@ -17,6 +17,7 @@
 #include "../localisation/Localisation.h"
 #include "../management/Finance.h"
 #include "../network/network.h"
+#include "../peep/Peep.h"
 #include "../ride/Ride.h"
 #include "../ride/Track.h"
 #include "../windows/Intent.h"
@@ -107,6 +108,7 @@ static money32 BannerRemove(int16_t x, int16_t y, uint8_t baseHeight, uint8_t di
 
         tile_element_remove_banner_entry((TileElement*)tileElement);
         map_invalidate_tile_zoom1(x, y, z, z + 32);
+        peep_pathfind_cache_invalidate(x, y);
         tileElement->Remove();
     }
 
@@ -305,6 +307,7 @@ static money32 BannerSetStyle(BannerIndex bannerIndex, uint8_t colour, uint8_t t
         allowedEdges &= ~(1 << tileElement->AsBanner()->GetPosition());
     }
     tileElement->AsBanner()->SetAllowedEdges(allowedEdges);
+    peep_pathfind_cache_invalidate(banner->x * 32, banner->y * 32);
 
     int32_t colourCodepoint = FORMAT_COLOUR_CODE_START + banner->text_colour;
 
@@ -44,6 +44,7 @@ static void ParkEntranceRemoveSegment(int32_t x, int32_t y, int32_t z)
     }
 
     map_invalidate_tile(x, y, tileElement->base_height * 8, tileElement->clearance_height * 8);
+    peep_pathfind_cache_invalidate(x, y);
     tileElement->Remove();
     update_park_fences({ x, y });
 }
@@ -422,6 +422,7 @@ static money32 footpath_element_update(
             tileElement->AsPath()->SetIsQueue(false);
         tileElement->AsPath()->SetAddition(pathItemType);
         tileElement->flags &= ~TILE_ELEMENT_FLAG_BROKEN;
+        peep_pathfind_cache_invalidate(x, y);
 
         loc_6A6620(flags, x, y, tileElement);
     }
@@ -997,21 +998,24 @@ void footpath_bridge_get_info_from_pos(
  */
 void footpath_remove_litter(int32_t x, int32_t y, int32_t z)
 {
-    uint16_t spriteIndex = sprite_get_first_in_quadrant(x, y);
-    while (spriteIndex != SPRITE_INDEX_NULL)
+    // Removing a sprite shifts the next one into its slot, so only advance past sprites that are kept.
+    const auto& quadrant = sprite_get_quadrant(x, y);
+    size_t i = 0;
+    while (i < quadrant.size())
     {
-        rct_litter* sprite = &get_sprite(spriteIndex)->litter;
-        uint16_t nextSpriteIndex = sprite->next_in_quadrant;
-        if (sprite->linked_list_type_offset == SPRITE_LIST_LITTER * 2)
+        const SpriteSpatialEntry& entry = quadrant[i];
+        int32_t distanceZ = abs(entry.z - z);
+        if (distanceZ <= 32)
         {
-            int32_t distanceZ = abs(sprite->z - z);
-            if (distanceZ <= 32)
+            rct_litter* sprite = &get_sprite(entry.sprite_index)->litter;
+            if (sprite->linked_list_type_offset == SPRITE_LIST_LITTER * 2)
             {
                 invalidate_sprite_0((rct_sprite*)sprite);
                 sprite_remove((rct_sprite*)sprite);
+                continue;
             }
         }
-        spriteIndex = nextSpriteIndex;
+        i++;
     }
 }
 
@@ -1021,26 +1025,23 @@ void footpath_remove_litter(int32_t x, int32_t y, int32_t z)
  */
 void footpath_interrupt_peeps(int32_t x, int32_t y, int32_t z)
 {
-    uint16_t spriteIndex = sprite_get_first_in_quadrant(x, y);
-    while (spriteIndex != SPRITE_INDEX_NULL)
+    for (const auto& entry : sprite_get_quadrant(x, y))
     {
-        rct_peep* peep = &get_sprite(spriteIndex)->peep;
-        uint16_t nextSpriteIndex = peep->next_in_quadrant;
+        if (entry.z != z)
+            continue;
+
+        rct_peep* peep = &get_sprite(entry.sprite_index)->peep;
         if (peep->linked_list_type_offset == SPRITE_LIST_PEEP * 2)
         {
             if (peep->state == PEEP_STATE_SITTING || peep->state == PEEP_STATE_WATCHING)
             {
-                if (peep->z == z)
-                {
-                    peep->SetState(PEEP_STATE_WALKING);
-                    peep->destination_x = (peep->x & 0xFFE0) + 16;
-                    peep->destination_y = (peep->y & 0xFFE0) + 16;
-                    peep->destination_tolerance = 5;
-                    peep->UpdateCurrentActionSpriteType();
-                }
+                peep->SetState(PEEP_STATE_WALKING);
+                peep->destination_x = (peep->x & 0xFFE0) + 16;
+                peep->destination_y = (peep->y & 0xFFE0) + 16;
+                peep->destination_tolerance = 5;
+                peep->UpdateCurrentActionSpriteType();
             }
         }
-        spriteIndex = nextSpriteIndex;
     }
 }
 
@@ -1311,7 +1312,11 @@ static bool sub_footpath_disconnect_queue_from_path(
             otherTileElement->AsPath()->SetEdges(otherTileElement->AsPath()->GetEdges() | (1 << ((direction + 2) & 3)));
         }
         if (action != 0)
+        {
+            peep_pathfind_cache_invalidate(x, y);
+            peep_pathfind_cache_invalidate(x1, y1);
             map_invalidate_tile_full(x1, y1);
+        }
         return true;
     }
     return false;
@@ -1493,6 +1498,7 @@ static void loc_6A6D7E(
         {
             footpath_interrupt_peeps(x, y, tileElement->base_height * 8);
         }
+        peep_pathfind_cache_invalidate(x, y);
         map_invalidate_element(x, y, tileElement);
     }
 
@@ -1502,6 +1508,7 @@ loc_6A6FD2:
         if (!query)
         {
             initialTileElement->AsPath()->SetEdges(initialTileElement->AsPath()->GetEdges() | (1 << direction));
+            peep_pathfind_cache_invalidate(initialX, initialY);
             map_invalidate_element(initialX, initialY, initialTileElement);
         }
     }
@@ -1705,6 +1712,7 @@ void footpath_chain_ride_queue(
             tileElement->AsPath()->SetRideIndex(rideIndex);
             tileElement->AsPath()->SetStationIndex(entranceIndex);
 
+            peep_pathfind_cache_invalidate(x, y);
             map_invalidate_element(x, y, tileElement);
 
             if (lastQueuePathElement == nullptr)
@@ -2163,6 +2171,29 @@ static void footpath_clear_wide(int32_t x, int32_t y)
     } while (!(tileElement++)->IsLastForTile());
 }
 
+/**
+ * Gets which path elements of the tile are wide, as a mask over their index in the tile.
+ * Returns false if the tile has too many elements for the mask.
+ */
+static bool footpath_get_wide_mask(int32_t x, int32_t y, uint64_t* outMask)
+{
+    uint64_t mask = 0;
+    int32_t index = 0;
+    TileElement* tileElement = map_get_first_element_at(x / 32, y / 32);
+    do
+    {
+        if (index >= 64)
+            return false;
+        if (tileElement->GetType() == TILE_ELEMENT_TYPE_PATH && tileElement->AsPath()->IsWide())
+        {
+            mask |= 1ULL << index;
+        }
+        index++;
+    } while (!(tileElement++)->IsLastForTile());
+    *outMask = mask;
+    return true;
+}
+
 /**
  *
  *  rct2: 0x006A8ACF
@@ -2203,6 +2234,10 @@ void footpath_update_path_wide_flags(int32_t x, int32_t y)
     if (y > 0x1FDF)
         return;
 
+    // The flags are recalculated every few ticks, the pathfinding cache only needs to know when they change.
+    uint64_t wideMaskBefore = 0;
+    bool hasWideMaskBefore = footpath_get_wide_mask(x, y, &wideMaskBefore);
+
     footpath_clear_wide(x, y);
     /* Rather than clearing the wide flag of the following tiles and
      * checking the state of them later, leave them intact and assume
@@ -2394,6 +2429,12 @@ void footpath_update_path_wide_flags(int32_t x, int32_t y)
                 tileElement->AsPath()->SetWide(true);
         }
     } while (!(tileElement++)->IsLastForTile());
+
+    uint64_t wideMaskAfter = 0;
+    if (!hasWideMaskBefore || !footpath_get_wide_mask(x, y, &wideMaskAfter) || wideMaskAfter != wideMaskBefore)
+    {
+        peep_pathfind_cache_invalidate(x, y);
+    }
 }
 
 bool footpath_is_blocked_by_vehicle(const TileCoordsXYZ& position)
@@ -2423,6 +2464,7 @@ void footpath_update_queue_entrance_banner(int32_t x, int32_t y, TileElement* ti
                     }
                 }
                 tileElement->AsPath()->SetRideIndex(RIDE_ID_NULL);
+                peep_pathfind_cache_invalidate(x, y);
             }
             break;
         case TILE_ELEMENT_TYPE_ENTRANCE:
@@ -2453,6 +2495,7 @@ static void footpath_remove_edges_towards_here(
     tileElement->AsPath()->SetCorners(tileElement->AsPath()->GetCorners() & ~(1 << cd));
     cd = ((cd + 1) & 3);
     tileElement->AsPath()->SetCorners(tileElement->AsPath()->GetCorners() & ~(1 << cd));
+    peep_pathfind_cache_invalidate(x, y);
     map_invalidate_tile(x, y, tileElement->base_height * 8, tileElement->clearance_height * 8);
 
     if (isQueue)
@@ -2649,6 +2692,7 @@ void footpath_remove_edges_at(int32_t x, int32_t y, TileElement* tileElement)
     }
 
     footpath_update_queue_entrance_banner(x, y, tileElement);
+    peep_pathfind_cache_invalidate(x, y);
 
     bool fixCorners = false;
     for (uint8_t direction = 0; direction < 4; direction++)
@@ -30,6 +30,7 @@
 #include "../network/network.h"
 #include "../object/ObjectManager.h"
 #include "../object/TerrainSurfaceObject.h"
+#include "../peep/Peep.h"
 #include "../ride/RideData.h"
 #include "../ride/Track.h"
 #include "../ride/TrackData.h"
@@ -50,6 +51,7 @@
 #include "Wall.h"
 
 #include <algorithm>
+#include <array>
 #include <iterator>
 
 using namespace OpenRCT2;
@@ -82,14 +84,43 @@ int16_t gMapSize;
 int16_t gMapSizeMaxXY;
 int16_t gMapBaseZ;
 
-TileElement gTileElements[MAX_TILE_TILE_ELEMENT_POINTERS * 3];
 TileElement* gTileElementTilePointers[MAX_TILE_TILE_ELEMENT_POINTERS];
 LocationXY16 gMapSelectionTiles[300];
 std::vector<PeepSpawn> gPeepSpawns;
 
-TileElement* gNextFreeTileElement;
 uint32_t gNextFreeTileElementPointerIndex;
 
+// Tile elements are allocated per square chunk of TILE_CHUNK_SIZE tiles.
+static constexpr int32_t TILE_CHUNK_SHIFT = 5;
+static constexpr int32_t TILE_CHUNK_SIZE = 1 << TILE_CHUNK_SHIFT;
+static constexpr int32_t TILE_CHUNKS_PER_AXIS = MAXIMUM_MAP_SIZE_TECHNICAL >> TILE_CHUNK_SHIFT;
+static constexpr size_t TILE_CHUNK_MIN_SEGMENT_SIZE = 256;
+// Holes of up to this many elements are kept for reuse, larger ones are only reclaimed by compaction.
+static constexpr size_t TILE_CHUNK_MAX_HOLE_SIZE = 16;
+
+/**
+ * The elements of every tile in a chunk live in the chunk's segments, each tile's elements contiguous.
+ * Inserting an element copies the tile's elements to a hole of the right size or the free end of the
+ * last segment, leaving a hole behind, and starts a new segment when that one is full. Elements of other
+ * tiles never move, except when the chunk is compacted.
+ */
+struct TileElementChunk
+{
+    std::vector<std::vector<TileElement>> Segments;
+    TileElement* NextFree = nullptr;
+    TileElement* End = nullptr;
+    size_t NumElementsAtCompaction = 0;
+    size_t NumAllocatedSinceCompaction = 0;
+    // Holes by size. New holes are pending until map_release_tile_element_holes, as whoever inserted
+    // the element that left them behind may still be looking at the old elements.
+    std::array<std::vector<TileElement*>, TILE_CHUNK_MAX_HOLE_SIZE + 1> Holes;
+    std::vector<std::pair<TileElement*, size_t>> PendingHoles;
+};
+
+static TileElementChunk _tileElementChunks[TILE_CHUNKS_PER_AXIS * TILE_CHUNKS_PER_AXIS];
+static size_t _numTileElements;
+static size_t _nextTileChunkToCompact;
+
 bool gLandMountainMode;
 bool gLandPaintMode;
 bool gClearSmallScenery;
@@ -325,12 +356,13 @@ BannerElement* map_get_banner_element_at(int32_t x, int32_t y, int32_t z, uint8_
  */
 void map_init(int32_t size)
 {
-    gNumMapAnimations = 0;
+    map_animation_clear();
     gNextFreeTileElementPointerIndex = 0;
 
-    for (int32_t i = 0; i < MAX_TILE_TILE_ELEMENT_POINTERS; i++)
+    std::vector<TileElement> tileElements(MAX_TILE_TILE_ELEMENT_POINTERS);
+    for (auto& element : tileElements)
     {
-        TileElement* tile_element = &gTileElements[i];
+        TileElement* tile_element = &element;
         tile_element->ClearAs(TILE_ELEMENT_TYPE_SURFACE);
         tile_element->flags = TILE_ELEMENT_FLAG_LAST_TILE;
         tile_element->base_height = 14;
@@ -352,7 +384,7 @@ void map_init(int32_t size)
     gMapSize = size;
     gMapSizeMaxXY = size * 32 - 33;
     gMapBaseZ = 7;
-    map_update_tile_pointers();
+    map_load_tile_elements(tileElements);
     map_remove_out_of_range_elements();
 
     auto intent = Intent(INTENT_ACTION_MAP);
@@ -411,38 +443,179 @@ void map_count_remaining_land_rights()
  */
 void map_strip_ghost_flag_from_elements()
 {
-    for (auto& element : gTileElements)
+    for (auto& chunk : _tileElementChunks)
+    {
+        for (auto& segment : chunk.Segments)
+        {
+            for (auto& element : segment)
+            {
+                element.flags &= ~TILE_ELEMENT_FLAG_GHOST;
+            }
+        }
+    }
+    peep_pathfind_cache_clear();
+}
+
+static size_t tile_element_count_for_tile(const TileElement* tileElement)
+{
+    size_t numElements = 1;
+    while (!(tileElement++)->IsLastForTile())
     {
-        element.flags &= ~TILE_ELEMENT_FLAG_GHOST;
+        numElements++;
     }
+    return numElements;
+}
+
+static TileElementChunk& map_get_tile_chunk(int32_t x, int32_t y)
+{
+    return _tileElementChunks[(y >> TILE_CHUNK_SHIFT) * TILE_CHUNKS_PER_AXIS + (x >> TILE_CHUNK_SHIFT)];
 }
 
 /**
- *
- *  rct2: 0x0068AFFD
+ * Copies the elements of every tile in the chunk into a single new segment with some room to spare
+ * and points the tiles at their new elements. Returns the number of elements in the chunk.
  */
-void map_update_tile_pointers()
+static size_t map_compact_tile_chunk(int32_t chunkX, int32_t chunkY)
 {
-    int32_t i, x, y;
+    int32_t left = chunkX << TILE_CHUNK_SHIFT;
+    int32_t top = chunkY << TILE_CHUNK_SHIFT;
 
-    for (i = 0; i < MAX_TILE_TILE_ELEMENT_POINTERS; i++)
+    size_t numElements = 0;
+    for (int32_t y = top; y < top + TILE_CHUNK_SIZE; y++)
     {
-        gTileElementTilePointers[i] = TILE_UNDEFINED_TILE_ELEMENT;
+        for (int32_t x = left; x < left + TILE_CHUNK_SIZE; x++)
+        {
+            numElements += tile_element_count_for_tile(gTileElementTilePointers[x + y * MAXIMUM_MAP_SIZE_TECHNICAL]);
+        }
     }
 
-    TileElement* tileElement = gTileElements;
-    TileElement** tile = gTileElementTilePointers;
-    for (y = 0; y < MAXIMUM_MAP_SIZE_TECHNICAL; y++)
+    std::vector<TileElement> segment(numElements + std::max(TILE_CHUNK_MIN_SEGMENT_SIZE, numElements / 8));
+    TileElement* dst = segment.data();
+    for (int32_t y = top; y < top + TILE_CHUNK_SIZE; y++)
+    {
+        for (int32_t x = left; x < left + TILE_CHUNK_SIZE; x++)
+        {
+            TileElement** tile = &gTileElementTilePointers[x + y * MAXIMUM_MAP_SIZE_TECHNICAL];
+            size_t numTileElements = tile_element_count_for_tile(*tile);
+            std::copy_n(*tile, numTileElements, dst);
+            *tile = dst;
+            dst += numTileElements;
+        }
+    }
+
+    auto& chunk = _tileElementChunks[chunkY * TILE_CHUNKS_PER_AXIS + chunkX];
+    for (auto& holes : chunk.Holes)
+    {
+        holes.clear();
+    }
+    chunk.PendingHoles.clear();
+    chunk.Segments.clear();
+    chunk.Segments.push_back(std::move(segment));
+    chunk.NextFree = dst;
+    chunk.End = chunk.Segments.back().data() + chunk.Segments.back().size();
+    chunk.NumElementsAtCompaction = numElements;
+    chunk.NumAllocatedSinceCompaction = 0;
+    return numElements;
+}
+
+/**
+ * Returns room for the given number of elements in the chunk, reusing a hole of exactly that size if there
+ * is one and starting a new segment if the last one is full.
+ */
+static TileElement* map_allocate_tile_elements(TileElementChunk& chunk, size_t numElements)
+{
+    if (numElements <= TILE_CHUNK_MAX_HOLE_SIZE && !chunk.Holes[numElements].empty())
+    {
+        TileElement* result = chunk.Holes[numElements].back();
+        chunk.Holes[numElements].pop_back();
+        return result;
+    }
+
+    if ((size_t)(chunk.End - chunk.NextFree) < numElements)
     {
-        for (x = 0; x < MAXIMUM_MAP_SIZE_TECHNICAL; x++)
+        size_t segmentSize = std::max({ numElements, TILE_CHUNK_MIN_SEGMENT_SIZE, chunk.NumElementsAtCompaction / 8 });
+        chunk.Segments.emplace_back(segmentSize);
+        chunk.NextFree = chunk.Segments.back().data();
+        chunk.End = chunk.NextFree + segmentSize;
+    }
+
+    TileElement* result = chunk.NextFree;
+    chunk.NextFree += numElements;
+    chunk.NumAllocatedSinceCompaction += numElements;
+    return result;
+}
+
+/**
+ * Replaces every tile element with the given elements, which are laid out tile by tile
+ * in the same order as gTileElementTilePointers. Tiles the elements run out for are left
+ * with a flat surface.
+ *  rct2: 0x0068AFFD
+ */
+void map_load_tile_elements(const std::vector<TileElement>& tileElements)
+{
+    static TileElement blankSurface;
+    blankSurface.ClearAs(TILE_ELEMENT_TYPE_SURFACE);
+    blankSurface.flags = TILE_ELEMENT_FLAG_LAST_TILE;
+    blankSurface.AsSurface()->SetSlope(TILE_ELEMENT_SLOPE_FLAT);
+    blankSurface.AsSurface()->SetSurfaceStyle(TERRAIN_GRASS);
+    blankSurface.AsSurface()->SetEdgeStyle(TERRAIN_EDGE_ROCK);
+    blankSurface.AsSurface()->SetGrassLength(GRASS_LENGTH_CLEAR_0);
+    blankSurface.AsSurface()->SetOwnership(OWNERSHIP_UNOWNED);
+
+    // Point the tiles into the given elements for now, compacting the chunks copies them into the store.
+    size_t index = 0;
+    for (auto& tile : gTileElementTilePointers)
+    {
+        size_t end = index;
+        while (end < tileElements.size() && !tileElements[end].IsLastForTile())
         {
-            *tile++ = tileElement;
-            while (!(tileElement++)->IsLastForTile())
-                ;
+            end++;
         }
+        if (end < tileElements.size())
+        {
+            tile = const_cast<TileElement*>(&tileElements[index]);
+            index = end + 1;
+        }
+        else
+        {
+            tile = &blankSurface;
+            index = end;
+        }
+    }
+    if (index != tileElements.size())
+    {
+        log_verbose("%u tile elements left over after loading the map", (uint32_t)(tileElements.size() - index));
     }
 
-    gNextFreeTileElement = tileElement;
+    _numTileElements = 0;
+    _nextTileChunkToCompact = 0;
+    for (int32_t chunkY = 0; chunkY < TILE_CHUNKS_PER_AXIS; chunkY++)
+    {
+        for (int32_t chunkX = 0; chunkX < TILE_CHUNKS_PER_AXIS; chunkX++)
+        {
+            _numTileElements += map_compact_tile_chunk(chunkX, chunkY);
+        }
+    }
+    peep_pathfind_cache_clear();
+}
+
+/**
+ * Returns a copy of every tile element laid out the way map_load_tile_elements expects, without any holes.
+ */
+std::vector<TileElement> map_get_tile_elements()
+{
+    std::vector<TileElement> tileElements;
+    tileElements.reserve(_numTileElements);
+    for (const TileElement* tileElement : gTileElementTilePointers)
+    {
+        tileElements.insert(tileElements.end(), tileElement, tileElement + tile_element_count_for_tile(tileElement));
+    }
+    return tileElements;
+}
+
+size_t map_get_num_tile_elements()
+{
+    return _numTileElements;
 }
 
 /**
@@ -2498,8 +2671,64 @@ void game_command_place_large_scenery(
  *
  *  rct2: 0x0068B280
  */
+/**
+ * Discards the guest pathfinding results that may depend on the tile of the given element. Elements do not know their
+ * own tile, so it is the one in the element's chunk that starts closest before the element.
+ */
+static void map_invalidate_pathfind_cache_at_element(const TileElement* tileElement)
+{
+    for (int32_t chunkY = 0; chunkY < TILE_CHUNKS_PER_AXIS; chunkY++)
+    {
+        for (int32_t chunkX = 0; chunkX < TILE_CHUNKS_PER_AXIS; chunkX++)
+        {
+            const auto& segments = _tileElementChunks[chunkY * TILE_CHUNKS_PER_AXIS + chunkX].Segments;
+            bool inChunk = std::any_of(
+                segments.begin(), segments.end(), [tileElement](const std::vector<TileElement>& segment) {
+                    return tileElement >= segment.data() && tileElement < segment.data() + segment.size();
+                });
+            if (!inChunk)
+                continue;
+
+            const TileElement* tileStart = nullptr;
+            int32_t tileX = 0;
+            int32_t tileY = 0;
+            for (int32_t y = chunkY << TILE_CHUNK_SHIFT; y < (chunkY + 1) << TILE_CHUNK_SHIFT; y++)
+            {
+                for (int32_t x = chunkX << TILE_CHUNK_SHIFT; x < (chunkX + 1) << TILE_CHUNK_SHIFT; x++)
+                {
+                    const TileElement* tile = gTileElementTilePointers[x + y * MAXIMUM_MAP_SIZE_TECHNICAL];
+                    if (tile <= tileElement && (tileStart == nullptr || tile > tileStart))
+                    {
+                        tileStart = tile;
+                        tileX = x;
+                        tileY = y;
+                    }
+                }
+            }
+            if (tileStart != nullptr)
+            {
+                peep_pathfind_cache_invalidate(tileX * 32, tileY * 32);
+                return;
+            }
+        }
+    }
+
+    // Not in the tile element store yet, e.g. while a park is being imported
+    peep_pathfind_cache_clear();
+}
+
 void tile_element_remove(TileElement* tileElement)
 {
+    switch (tileElement->GetType())
+    {
+        case TILE_ELEMENT_TYPE_PATH:
+        case TILE_ELEMENT_TYPE_TRACK:
+        case TILE_ELEMENT_TYPE_ENTRANCE:
+        case TILE_ELEMENT_TYPE_BANNER:
+            map_invalidate_pathfind_cache_at_element(tileElement);
+            break;
+    }
+
     // Replace Nth element by (N+1)th element.
     // This loop will make tileElement point to the old last element position,
     // after copy it to it's new position
@@ -2514,11 +2743,7 @@ void tile_element_remove(TileElement* tileElement)
     // Mark the latest element with the last element flag.
     (tileElement - 1)->flags |= TILE_ELEMENT_FLAG_LAST_TILE;
     tileElement->base_height = 0xFF;
-
-    if ((tileElement + 1) == gNextFreeTileElement)
-    {
-        gNextFreeTileElement--;
-    }
+    _numTileElements--;
 }
 
 /**
@@ -2553,6 +2778,7 @@ void map_remove_all_rides()
                 break;
         }
     } while (tile_element_iterator_next(&it));
+    peep_pathfind_cache_clear();
 }
 
 /**
@@ -2656,72 +2882,79 @@ void map_reorganise_elements()
 {
     context_setcurrentcursor(CURSOR_ZZZ);
 
-    TileElement* new_tile_elements = (TileElement*)malloc(
-        3 * (MAXIMUM_MAP_SIZE_TECHNICAL * MAXIMUM_MAP_SIZE_TECHNICAL) * sizeof(TileElement));
-    TileElement* new_elements_pointer = new_tile_elements;
-
-    if (new_tile_elements == nullptr)
+    _numTileElements = 0;
+    for (int32_t chunkY = 0; chunkY < TILE_CHUNKS_PER_AXIS; chunkY++)
     {
-        log_fatal("Unable to allocate memory for map elements.");
-        return;
+        for (int32_t chunkX = 0; chunkX < TILE_CHUNKS_PER_AXIS; chunkX++)
+        {
+            _numTileElements += map_compact_tile_chunk(chunkX, chunkY);
+        }
     }
+}
 
-    uint32_t num_elements;
-
-    for (int32_t y = 0; y < MAXIMUM_MAP_SIZE_TECHNICAL; y++)
+/**
+ * Makes the holes left behind since the last call available for reuse. Must only be called when no
+ * pointers to tile elements are held, i.e. at the same points the whole map used to be reorganised.
+ */
+static void map_release_tile_element_holes()
+{
+    for (auto& chunk : _tileElementChunks)
     {
-        for (int32_t x = 0; x < MAXIMUM_MAP_SIZE_TECHNICAL; x++)
+        for (const auto& hole : chunk.PendingHoles)
         {
-            TileElement* startElement = map_get_first_element_at(x, y);
-            TileElement* endElement = startElement;
-            while (!(endElement++)->IsLastForTile())
-                ;
-
-            num_elements = (uint32_t)(endElement - startElement);
-            std::memcpy(new_elements_pointer, startElement, num_elements * sizeof(TileElement));
-            new_elements_pointer += num_elements;
+            chunk.Holes[hole.second].push_back(hole.first);
         }
+        chunk.PendingHoles.clear();
     }
+}
 
-    num_elements = (uint32_t)(new_elements_pointer - new_tile_elements);
-    std::memcpy(gTileElements, new_tile_elements, num_elements * sizeof(TileElement));
-    std::memset(
-        gTileElements + num_elements, 0,
-        (3 * (MAXIMUM_MAP_SIZE_TECHNICAL * MAXIMUM_MAP_SIZE_TECHNICAL) - num_elements) * sizeof(TileElement));
+/**
+ * Releases pending holes and compacts at most one chunk that has allocated more elements since it was
+ * last compacted than it held back then. Called once per tick, so the cost of a compaction is bounded
+ * by the size of a chunk and construction never has to wait for one.
+ */
+void map_update_tile_element_store()
+{
+    map_release_tile_element_holes();
 
-    free(new_tile_elements);
+    constexpr size_t numChunks = std::size(_tileElementChunks);
+    for (size_t i = 0; i < numChunks; i++)
+    {
+        size_t chunkIndex = (_nextTileChunkToCompact + i) % numChunks;
+        const auto& chunk = _tileElementChunks[chunkIndex];
+        if (!chunk.Segments.empty() && chunk.NumAllocatedSinceCompaction > chunk.NumElementsAtCompaction)
+        {
+            map_compact_tile_chunk((int32_t)(chunkIndex % TILE_CHUNKS_PER_AXIS), (int32_t)(chunkIndex / TILE_CHUNKS_PER_AXIS));
+            _nextTileChunkToCompact = (chunkIndex + 1) % numChunks;
+            break;
+        }
+    }
+}
 
-    map_update_tile_pointers();
+static bool map_check_free_elements(int32_t numElements)
+{
+    if (_numTileElements + numElements > MAX_TILE_ELEMENTS)
+    {
+        // Not enough spare elements left :'(
+        gGameCommandErrorText = STR_ERR_LANDSCAPE_DATA_AREA_FULL;
+        return false;
+    }
+    return true;
 }
 
 /**
  *
  *  rct2: 0x0068B044
  *  Returns true on space available for more elements
- *  Reorganises the map elements to check for space
+ *  Callers check before inserting anything, so the holes left behind so far can be reused from here on.
+ *  Nothing is moved, chunks are compacted a bit at a time by map_update_tile_element_store.
  */
 bool map_check_free_elements_and_reorganise(int32_t numElements)
 {
     if (numElements != 0)
     {
-        auto tileElementEnd = &gTileElements[MAX_TILE_ELEMENTS];
-
-        // Check if is there is room for the required number of elements
-        auto newTileElementEnd = gNextFreeTileElement + numElements;
-        if (newTileElementEnd > tileElementEnd)
-        {
-            // Defragment the map element list
-            map_reorganise_elements();
-
-            // Check if there is any room again
-            newTileElementEnd = gNextFreeTileElement + numElements;
-            if (newTileElementEnd > tileElementEnd)
-            {
-                // Not enough spare elements left :'(
-                gGameCommandErrorText = STR_ERR_LANDSCAPE_DATA_AREA_FULL;
-                return false;
-            }
-        }
+        map_release_tile_element_holes();
+        return map_check_free_elements(numElements);
     }
     return true;
 }
@@ -2734,14 +2967,21 @@ TileElement* tile_element_insert(int32_t x, int32_t y, int32_t z, int32_t flags)
 {
     TileElement *originalTileElement, *newTileElement, *insertedElement;
 
-    if (!map_check_free_elements_and_reorganise(1))
+    if (!map_check_free_elements(1))
     {
         log_error("Cannot insert new element");
         return nullptr;
     }
 
-    newTileElement = gNextFreeTileElement;
+    auto& chunk = map_get_tile_chunk(x, y);
     originalTileElement = gTileElementTilePointers[y * MAXIMUM_MAP_SIZE_TECHNICAL + x];
+    size_t numOriginalElements = tile_element_count_for_tile(originalTileElement);
+    if (numOriginalElements <= TILE_CHUNK_MAX_HOLE_SIZE)
+    {
+        chunk.PendingHoles.emplace_back(originalTileElement, numOriginalElements);
+    }
+    newTileElement = map_allocate_tile_elements(chunk, numOriginalElements + 1);
+    peep_pathfind_cache_invalidate(x * 32, y * 32);
 
     // Set tile index pointer to point to new element block
     gTileElementTilePointers[y * MAXIMUM_MAP_SIZE_TECHNICAL + x] = newTileElement;
@@ -2786,7 +3026,7 @@ TileElement* tile_element_insert(int32_t x, int32_t y, int32_t z, int32_t flags)
         } while (!((newTileElement - 1)->flags & TILE_ELEMENT_FLAG_LAST_TILE));
     }
 
-    gNextFreeTileElement = newTileElement;
+    _numTileElements++;
     return insertedElement;
 }
 
@@ -3281,6 +3521,7 @@ static void clear_element_at(int32_t x, int32_t y, TileElement** elementPtr)
                 GAME_COMMAND_REMOVE_BANNER, 0, 0);
             break;
         default:
+            peep_pathfind_cache_invalidate(x, y);
             tile_element_remove(element);
             break;
     }
@@ -3899,6 +4140,12 @@ void game_command_modify_tile(
             break;
     }
 
+    // The tile inspector edits elements in place, which the pathfinding cache has to know about.
+    if ((flags & GAME_COMMAND_FLAG_APPLY) && *ebx != MONEY32_UNDEFINED)
+    {
+        peep_pathfind_cache_invalidate(x << 5, y << 5);
+    }
+
     if (flags & GAME_COMMAND_FLAG_APPLY && gGameCommandNestLevel == 1 && !(flags & GAME_COMMAND_FLAG_GHOST)
         && *ebx != MONEY32_UNDEFINED)
     {
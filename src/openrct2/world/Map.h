@@ -27,7 +27,8 @@
 
 #define MAP_MINIMUM_X_Y (-MAXIMUM_MAP_SIZE_TECHNICAL)
 
-#define MAX_TILE_ELEMENTS 196096 // 0x30000
+// The number of tile elements an S6 file can hold, the tile element store itself has no fixed size.
+#define MAX_TILE_ELEMENTS 196608 // 0x30000
 #define MAX_TILE_TILE_ELEMENT_POINTERS (MAXIMUM_MAP_SIZE_TECHNICAL * MAXIMUM_MAP_SIZE_TECHNICAL)
 #define MAX_PEEP_SPAWNS 8
 #define PEEP_SPAWN_UNDEFINED 0xFFFF
@@ -102,13 +103,11 @@ extern uint8_t gMapSelectArrowDirection;
 
 extern uint8_t gMapGroundFlags;
 
-extern TileElement gTileElements[MAX_TILE_TILE_ELEMENT_POINTERS * 3];
 extern TileElement* gTileElementTilePointers[MAX_TILE_TILE_ELEMENT_POINTERS];
 
 extern LocationXY16 gMapSelectionTiles[300];
 extern std::vector<PeepSpawn> gPeepSpawns;
 
-extern TileElement* gNextFreeTileElement;
 extern uint32_t gNextFreeTileElementPointerIndex;
 
 // Used in the land tool window to enable mountain tool / land smoothing
@@ -130,7 +129,9 @@ extern bool gMapLandRightsUpdateSuccess;
 void map_init(int32_t size);
 void map_count_remaining_land_rights();
 void map_strip_ghost_flag_from_elements();
-void map_update_tile_pointers();
+void map_load_tile_elements(const std::vector<TileElement>& tileElements);
+std::vector<TileElement> map_get_tile_elements();
+size_t map_get_num_tile_elements();
 TileElement* map_get_first_element_at(int32_t x, int32_t y);
 TileElement* map_get_nth_element_at(int32_t x, int32_t y, int32_t n);
 void map_set_tile_elements(int32_t x, int32_t y, TileElement* elements);
@@ -235,6 +236,7 @@ void tile_element_iterator_restart_for_tile(tile_element_iterator* it);
 
 void wall_remove_intersecting_walls(int32_t x, int32_t y, int32_t z0, int32_t z1, int32_t direction);
 void map_update_tiles();
+void map_update_tile_element_store();
 int32_t map_get_highest_z(int32_t tileX, int32_t tileY);
 
 bool tile_element_wants_path_connection_towards(TileCoordsXYZD coords, const TileElement* const elementToBeRemoved);
@@ -11,6 +11,7 @@
 
 #include "../Context.h"
 #include "../Game.h"
+#include "../OpenRCT2.h"
 #include "../interface/Viewport.h"
 #include "../object/StationObject.h"
 #include "../ride/Ride.h"
@@ -24,14 +25,74 @@
 #include "SmallScenery.h"
 #include "Sprite.h"
 
+#include <algorithm>
 #include <cstring>
 
 using map_animation_invalidate_event_handler = bool (*)(int32_t x, int32_t y, int32_t baseZ);
 
 static bool map_animation_invalidate(rct_map_animation* obj);
 
-uint16_t gNumMapAnimations;
-rct_map_animation gAnimatedObjects[MAX_ANIMATED_OBJECTS];
+constexpr uint32_t MAP_ANIMATION_NULL = UINT32_MAX;
+
+// Animations are kept in no particular order, removing one moves the last animation into its place. Every tile links
+// the animations on it together, so finding an animation only looks at the few animations on the same tile.
+static std::vector<rct_map_animation> _mapAnimations;
+static std::vector<uint32_t> _mapAnimationNextOnTile;
+static std::vector<uint32_t> _tileFirstMapAnimation;
+
+static uint32_t map_animation_get_tile_index(int32_t x, int32_t y)
+{
+    return (y >> 5) * MAXIMUM_MAP_SIZE_TECHNICAL + (x >> 5);
+}
+
+/**
+ * Finds the link that points to the given animation on its tile, so it can be changed.
+ */
+static uint32_t* map_animation_find_link(uint32_t index)
+{
+    const rct_map_animation& animation = _mapAnimations[index];
+    uint32_t* link = &_tileFirstMapAnimation[map_animation_get_tile_index(animation.x, animation.y)];
+    while (*link != index)
+    {
+        link = &_mapAnimationNextOnTile[*link];
+    }
+    return link;
+}
+
+static void map_animation_add(const rct_map_animation& animation)
+{
+    if ((animation.x >> 5) >= MAXIMUM_MAP_SIZE_TECHNICAL || (animation.y >> 5) >= MAXIMUM_MAP_SIZE_TECHNICAL)
+    {
+        log_warning("Ignoring animation outside of the map at %d, %d", animation.x, animation.y);
+        return;
+    }
+    if (_tileFirstMapAnimation.empty())
+    {
+        _tileFirstMapAnimation.resize(MAXIMUM_MAP_SIZE_TECHNICAL * MAXIMUM_MAP_SIZE_TECHNICAL, MAP_ANIMATION_NULL);
+    }
+
+    uint32_t index = (uint32_t)_mapAnimations.size();
+    uint32_t& first = _tileFirstMapAnimation[map_animation_get_tile_index(animation.x, animation.y)];
+    _mapAnimations.push_back(animation);
+    _mapAnimationNextOnTile.push_back(first);
+    first = index;
+}
+
+static void map_animation_remove(uint32_t index)
+{
+    uint32_t* link = map_animation_find_link(index);
+    *link = _mapAnimationNextOnTile[index];
+
+    uint32_t last = (uint32_t)_mapAnimations.size() - 1;
+    if (index != last)
+    {
+        *map_animation_find_link(last) = index;
+        _mapAnimations[index] = _mapAnimations[last];
+        _mapAnimationNextOnTile[index] = _mapAnimationNextOnTile[last];
+    }
+    _mapAnimations.pop_back();
+    _mapAnimationNextOnTile.pop_back();
+}
 
 /**
  *
@@ -44,33 +105,98 @@ rct_map_animation gAnimatedObjects[MAX_ANIMATED_OBJECTS];
  */
 void map_animation_create(int32_t type, int32_t x, int32_t y, int32_t z)
 {
-    rct_map_animation* aobj = &gAnimatedObjects[0];
-    int32_t numAnimatedObjects = gNumMapAnimations;
-    if (numAnimatedObjects >= MAX_ANIMATED_OBJECTS)
+    if (_mapAnimations.size() >= MAX_ANIMATED_OBJECTS)
     {
         log_error("Exceeded the maximum number of animations");
         return;
     }
-    for (int32_t i = 0; i < numAnimatedObjects; i++, aobj++)
+
+    if (!_tileFirstMapAnimation.empty())
     {
-        if (aobj->x != x)
-            continue;
-        if (aobj->y != y)
-            continue;
-        if (aobj->baseZ != z)
-            continue;
-        if (aobj->type != type)
-            continue;
-        // Animation already exists
-        return;
+        uint32_t index = _tileFirstMapAnimation[map_animation_get_tile_index(x, y)];
+        for (; index != MAP_ANIMATION_NULL; index = _mapAnimationNextOnTile[index])
+        {
+            const rct_map_animation& animation = _mapAnimations[index];
+            if (animation.x == x && animation.y == y && animation.baseZ == z && animation.type == type)
+            {
+                // Animation already exists
+                return;
+            }
+        }
     }
 
     // Create new animation
-    gNumMapAnimations++;
-    aobj->type = type;
-    aobj->x = x;
-    aobj->y = y;
-    aobj->baseZ = z;
+    rct_map_animation animation;
+    animation.type = type;
+    animation.x = x;
+    animation.y = y;
+    animation.baseZ = z;
+    map_animation_add(animation);
+}
+
+/**
+ * Whether the animation changes the game rather than only how it looks this tick, in which case it has to be updated
+ * regardless of whether it can be seen.
+ */
+static bool map_animation_affects_game_state(const rct_map_animation& animation)
+{
+    switch (animation.type)
+    {
+        case MAP_ANIMATION_TYPE_TRACK_ONRIDEPHOTO:
+        case MAP_ANIMATION_TYPE_WALL_DOOR:
+            return true;
+        case MAP_ANIMATION_TYPE_SMALL_SCENERY:
+            // Clocks make peeps check the time.
+            return !(gCurrentTicks & 0x3FF);
+        default:
+            return false;
+    }
+}
+
+/**
+ * Gets the areas of the map the viewports show, in the same coordinates as map_invalidate_tile_zoom1 uses. Only
+ * viewports that are not zoomed out further than that are included, as animations are not redrawn for the others.
+ */
+static std::vector<rct_viewport*> map_animation_get_viewports()
+{
+    std::vector<rct_viewport*> viewports;
+    if (gOpenRCT2Headless)
+    {
+        return viewports;
+    }
+    for (auto& viewport : g_viewport_list)
+    {
+        if (viewport.width != 0 && viewport.zoom <= 1)
+        {
+            viewports.push_back(&viewport);
+        }
+    }
+    return viewports;
+}
+
+static bool map_animation_is_visible(const rct_map_animation& animation, const std::vector<rct_viewport*>& viewports)
+{
+    if (viewports.empty())
+    {
+        return false;
+    }
+
+    // Covers whatever part of the tile the handlers invalidate, including tall scenery.
+    CoordsXY screenCoords = translate_3d_to_2d_with_z(
+        get_current_rotation(), { animation.x + 16, animation.y + 16, animation.baseZ * 8 });
+    int32_t left = screenCoords.x - 32;
+    int32_t right = screenCoords.x + 32;
+    int32_t top = screenCoords.y - 32 - 256;
+    int32_t bottom = screenCoords.y + 32;
+    for (const auto viewport : viewports)
+    {
+        if (right > viewport->view_x && left < viewport->view_x + viewport->view_width && bottom > viewport->view_y
+            && top < viewport->view_y + viewport->view_height)
+        {
+            return true;
+        }
+    }
+    return false;
 }
 
 /**
@@ -79,26 +205,61 @@ void map_animation_create(int32_t type, int32_t x, int32_t y, int32_t z)
  */
 void map_animation_invalidate_all()
 {
-    rct_map_animation* aobj = &gAnimatedObjects[0];
-    int32_t numAnimatedObjects = gNumMapAnimations;
-    while (numAnimatedObjects > 0)
+    auto viewports = map_animation_get_viewports();
+
+    uint32_t index = 0;
+    while (index < _mapAnimations.size())
     {
-        if (map_animation_invalidate(aobj))
+        const rct_map_animation& animation = _mapAnimations[index];
+
+        // Which animations are removed must not depend on what can be seen, so that every client keeps the same list.
+        // Animations that can not be seen are only looked at when they are checked for whether they still exist.
+        bool validate = map_animation_affects_game_state(animation)
+            || ((animation.x >> 5) + (animation.y >> 5) + gCurrentTicks) % MAP_ANIMATION_VALIDATE_INTERVAL == 0;
+        if (!validate && !map_animation_is_visible(animation, viewports))
+        {
+            index++;
+            continue;
+        }
+
+        if (map_animation_invalidate(&_mapAnimations[index]) && validate)
         {
-            // Remove animated object
-            gNumMapAnimations--;
-            numAnimatedObjects--;
-            if (numAnimatedObjects > 0)
-                memmove(aobj, aobj + 1, numAnimatedObjects * sizeof(rct_map_animation));
+            // Remove animated object, which moves the last one to this index
+            map_animation_remove(index);
         }
         else
         {
-            numAnimatedObjects--;
-            aobj++;
+            index++;
         }
     }
 }
 
+void map_animation_clear()
+{
+    _mapAnimations.clear();
+    _mapAnimationNextOnTile.clear();
+    std::fill(_tileFirstMapAnimation.begin(), _tileFirstMapAnimation.end(), MAP_ANIMATION_NULL);
+}
+
+void map_animation_load(const std::vector<rct_map_animation>& animations)
+{
+    map_animation_clear();
+    for (const auto& animation : animations)
+    {
+        map_animation_add(animation);
+    }
+}
+
+std::vector<rct_map_animation> map_animation_get_all()
+{
+    return _mapAnimations;
+}
+
+size_t map_animation_get_count()
+{
+    return _mapAnimations.size();
+}
+
 /**
  *
  *  rct2: 0x00666670
@@ -206,18 +367,18 @@ static bool map_animation_invalidate_small_scenery(int32_t x, int32_t y, int32_t
                 int32_t x2 = x - CoordsDirectionDelta[direction].x;
                 int32_t y2 = y - CoordsDirectionDelta[direction].y;
 
-                uint16_t spriteIdx = sprite_get_first_in_quadrant(x2, y2);
-                for (; spriteIdx != SPRITE_INDEX_NULL; spriteIdx = sprite->generic.next_in_quadrant)
+                for (const auto& entry : sprite_get_quadrant(x2, y2))
                 {
-                    sprite = get_sprite(spriteIdx);
+                    if (entry.z != tileElement->base_height * 8)
+                        continue;
+
+                    sprite = get_sprite(entry.sprite_index);
                     if (sprite->generic.linked_list_type_offset != SPRITE_LIST_PEEP * 2)
                         continue;
 
                     peep = &sprite->peep;
                     if (peep->state != PEEP_STATE_WALKING)
                         continue;
-                    if (peep->z != tileElement->base_height * 8)
-                        continue;
                     if (peep->action < PEEP_ACTION_NONE_1)
                         continue;
 
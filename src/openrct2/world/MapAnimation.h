@@ -12,6 +12,8 @@
 
 #include "../common.h"
 
+#include <vector>
+
 #pragma pack(push, 1)
 /**
  * Animated object
@@ -48,10 +50,17 @@ enum
 
 #define MAX_ANIMATED_OBJECTS 2000
 
-extern uint16_t gNumMapAnimations;
-extern rct_map_animation gAnimatedObjects[MAX_ANIMATED_OBJECTS];
+// Animations that no viewport can see are only checked for whether they still exist once every this many ticks.
+constexpr uint32_t MAP_ANIMATION_VALIDATE_INTERVAL = 16;
 
 void map_animation_create(int32_t type, int32_t x, int32_t y, int32_t z);
 void map_animation_invalidate_all();
+void map_animation_clear();
+/**
+ * Replaces all animations, e.g. with the ones of a park that is being loaded.
+ */
+void map_animation_load(const std::vector<rct_map_animation>& animations);
+std::vector<rct_map_animation> map_animation_get_all();
+size_t map_animation_get_count();
 
 #endif
@@ -15,6 +15,8 @@
 #include "../audio/audio.h"
 #include "../core/Crypt.h"
 #include "../core/Guard.hpp"
+#include "../core/IStream.hpp"
+#include "../core/JobPool.h"
 #include "../interface/Viewport.h"
 #include "../localisation/Date.h"
 #include "../localisation/Localisation.h"
@@ -23,11 +25,17 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstring>
 #include <iterator>
+#include <memory>
 
 uint16_t gSpriteListHead[6];
 uint16_t gSpriteListCount[6];
-static rct_sprite _spriteList[MAX_SPRITES];
+// The first SPRITE_POOL_INITIAL_CAPACITY sprites, any further sprites live in chunks that are
+// allocated on demand. Sprites never move, so pointers to them stay valid while the pool grows.
+static rct_sprite _spriteList[SPRITE_POOL_INITIAL_CAPACITY];
+static std::vector<std::unique_ptr<rct_sprite[]>> _spriteChunks;
+static size_t _spriteCapacity = SPRITE_POOL_INITIAL_CAPACITY;
 
 static bool _spriteFlashingList[MAX_SPRITES];
 
@@ -35,6 +43,13 @@ static bool _spriteFlashingList[MAX_SPRITES];
 
 uint16_t gSpriteSpatialIndex[0x10001];
 
+#define SPATIAL_INDEX_CELL_NONE 0xFFFFFFFF
+
+// Each cell holds the same sprites as its next_in_quadrant list and in the same order, so queries can scan a small
+// array instead of following links through the sprite array. Sprites without a location are not stored.
+static std::vector<SpriteSpatialEntry> _spriteSpatialCells[SPATIAL_INDEX_LOCATION_NULL];
+static uint32_t _spriteSpatialCellOfSprite[MAX_SPRITES];
+
 const rct_string_id litterNames[12] = { STR_LITTER_VOMIT,
                                         STR_LITTER_VOMIT,
                                         STR_SHOP_ITEM_SINGULAR_EMPTY_CAN,
@@ -68,20 +83,134 @@ std::string rct_sprite_checksum::ToString() const
     return result;
 }
 
+static rct_sprite* get_sprite_unchecked(size_t spriteIndex)
+{
+    if (spriteIndex < SPRITE_POOL_INITIAL_CAPACITY)
+    {
+        return &_spriteList[spriteIndex];
+    }
+    size_t offset = spriteIndex - SPRITE_POOL_INITIAL_CAPACITY;
+    return &_spriteChunks[offset / SPRITE_POOL_CHUNK_SIZE][offset % SPRITE_POOL_CHUNK_SIZE];
+}
+
 rct_sprite* try_get_sprite(size_t spriteIndex)
 {
     rct_sprite* sprite = nullptr;
-    if (spriteIndex < MAX_SPRITES)
+    if (spriteIndex < _spriteCapacity)
     {
-        sprite = &_spriteList[spriteIndex];
+        sprite = get_sprite_unchecked(spriteIndex);
     }
     return sprite;
 }
 
 rct_sprite* get_sprite(size_t sprite_idx)
 {
-    openrct2_assert(sprite_idx < MAX_SPRITES, "Tried getting sprite %u", sprite_idx);
-    return &_spriteList[sprite_idx];
+    openrct2_assert(sprite_idx < _spriteCapacity, "Tried getting sprite %u", sprite_idx);
+    return get_sprite_unchecked(sprite_idx);
+}
+
+size_t sprite_get_capacity()
+{
+    return _spriteCapacity;
+}
+
+/**
+ * Allocates or releases chunks so that the pool holds the given number of sprites, rounded up to
+ * a whole chunk. New sprites are zeroed and are not part of any list, that is up to the caller.
+ */
+void sprite_set_capacity(size_t capacity)
+{
+    capacity = std::clamp<size_t>(capacity, SPRITE_POOL_INITIAL_CAPACITY, MAX_SPRITES);
+    size_t numChunks = (capacity - SPRITE_POOL_INITIAL_CAPACITY + SPRITE_POOL_CHUNK_SIZE - 1) / SPRITE_POOL_CHUNK_SIZE;
+    if (numChunks < _spriteChunks.size())
+    {
+        _spriteChunks.resize(numChunks);
+    }
+    while (_spriteChunks.size() < numChunks)
+    {
+        _spriteChunks.push_back(std::make_unique<rct_sprite[]>(SPRITE_POOL_CHUNK_SIZE));
+    }
+    _spriteCapacity = SPRITE_POOL_INITIAL_CAPACITY + numChunks * SPRITE_POOL_CHUNK_SIZE;
+}
+
+/**
+ * Adds a chunk of null sprites to the end of SPRITE_LIST_NULL. Returns false if the pool can not grow any further.
+ */
+static bool sprite_pool_grow()
+{
+    if (_spriteCapacity + SPRITE_POOL_CHUNK_SIZE > MAX_SPRITES)
+    {
+        return false;
+    }
+
+    uint16_t tailIndex = SPRITE_INDEX_NULL;
+    for (uint16_t spriteIndex = gSpriteListHead[SPRITE_LIST_NULL]; spriteIndex != SPRITE_INDEX_NULL;
+         spriteIndex = get_sprite(spriteIndex)->generic.next)
+    {
+        tailIndex = spriteIndex;
+    }
+
+    size_t firstNewIndex = _spriteCapacity;
+    sprite_set_capacity(_spriteCapacity + SPRITE_POOL_CHUNK_SIZE);
+    for (size_t i = firstNewIndex; i < _spriteCapacity; i++)
+    {
+        rct_sprite_generic* sprite = &get_sprite(i)->generic;
+        sprite->sprite_identifier = SPRITE_IDENTIFIER_NULL;
+        sprite->sprite_index = (uint16_t)i;
+        sprite->linked_list_type_offset = SPRITE_LIST_NULL * 2;
+        sprite->next_in_quadrant = SPRITE_INDEX_NULL;
+        sprite->next = SPRITE_INDEX_NULL;
+        sprite->previous = tailIndex;
+        if (tailIndex == SPRITE_INDEX_NULL)
+        {
+            gSpriteListHead[SPRITE_LIST_NULL] = (uint16_t)i;
+        }
+        else
+        {
+            get_sprite(tailIndex)->generic.next = (uint16_t)i;
+        }
+        _spriteFlashingList[i] = false;
+        tailIndex = (uint16_t)i;
+    }
+    gSpriteListCount[SPRITE_LIST_NULL] += SPRITE_POOL_CHUNK_SIZE;
+
+    log_verbose("Sprite pool grown to %u sprites", (uint32_t)_spriteCapacity);
+    return true;
+}
+
+/**
+ * Writes every sprite and the sprite lists if the pool has grown beyond what S6 files can hold.
+ * Used for network map transfers and replays, which must restore the exact state of the pool.
+ */
+void sprite_write_extended_pool(IStream* stream)
+{
+    stream->WriteValue<uint32_t>((uint32_t)_spriteCapacity);
+    if (_spriteCapacity > SPRITE_POOL_INITIAL_CAPACITY)
+    {
+        stream->Write(_spriteList, sizeof(_spriteList));
+        for (const auto& chunk : _spriteChunks)
+        {
+            stream->Write(chunk.get(), SPRITE_POOL_CHUNK_SIZE * sizeof(rct_sprite));
+        }
+        stream->Write(gSpriteListHead, sizeof(gSpriteListHead));
+        stream->Write(gSpriteListCount, sizeof(gSpriteListCount));
+    }
+}
+
+void sprite_read_extended_pool(IStream* stream)
+{
+    size_t capacity = stream->ReadValue<uint32_t>();
+    if (capacity > SPRITE_POOL_INITIAL_CAPACITY)
+    {
+        sprite_set_capacity(capacity);
+        stream->Read(_spriteList, sizeof(_spriteList));
+        for (const auto& chunk : _spriteChunks)
+        {
+            stream->Read(chunk.get(), SPRITE_POOL_CHUNK_SIZE * sizeof(rct_sprite));
+        }
+        stream->Read(gSpriteListHead, sizeof(gSpriteListHead));
+        stream->Read(gSpriteListCount, sizeof(gSpriteListCount));
+    }
 }
 
 uint16_t sprite_get_first_in_quadrant(int32_t x, int32_t y)
@@ -90,6 +219,85 @@ uint16_t sprite_get_first_in_quadrant(int32_t x, int32_t y)
     return gSpriteSpatialIndex[offset];
 }
 
+/**
+ * Gets the sprites on the tile containing the given coordinates, in the same order as the
+ * next_in_quadrant list starting at sprite_get_first_in_quadrant. Removing or moving sprites
+ * changes the returned array.
+ */
+const std::vector<SpriteSpatialEntry>& sprite_get_quadrant(int32_t x, int32_t y)
+{
+    int32_t offset = ((x & 0x1FE0) << 3) | (y >> 5);
+    return _spriteSpatialCells[offset];
+}
+
+static SpriteSpatialEntry* sprite_spatial_cell_find(uint16_t spriteIndex)
+{
+    uint32_t cell = _spriteSpatialCellOfSprite[spriteIndex];
+    if (cell == SPATIAL_INDEX_CELL_NONE)
+        return nullptr;
+
+    for (auto& entry : _spriteSpatialCells[cell])
+    {
+        if (entry.sprite_index == spriteIndex)
+            return &entry;
+    }
+    return nullptr;
+}
+
+static void sprite_spatial_cell_remove(uint16_t spriteIndex)
+{
+    uint32_t cell = _spriteSpatialCellOfSprite[spriteIndex];
+    if (cell == SPATIAL_INDEX_CELL_NONE)
+        return;
+
+    auto& entries = _spriteSpatialCells[cell];
+    auto it = std::find_if(entries.begin(), entries.end(), [spriteIndex](const SpriteSpatialEntry& entry) {
+        return entry.sprite_index == spriteIndex;
+    });
+    if (it != entries.end())
+    {
+        entries.erase(it);
+    }
+    _spriteSpatialCellOfSprite[spriteIndex] = SPATIAL_INDEX_CELL_NONE;
+}
+
+/**
+ * Adds a sprite to the front of a cell, mirroring how it is linked at the head of the quadrant list.
+ */
+static void sprite_spatial_cell_insert(size_t cell, uint16_t spriteIndex, int16_t x, int16_t y, int16_t z)
+{
+    if (cell >= SPATIAL_INDEX_LOCATION_NULL)
+        return;
+
+    auto& entries = _spriteSpatialCells[cell];
+    entries.insert(entries.begin(), { spriteIndex, x, y, z });
+    _spriteSpatialCellOfSprite[spriteIndex] = static_cast<uint32_t>(cell);
+}
+
+/**
+ * Rebuilds the cells from gSpriteSpatialIndex and the next_in_quadrant lists. Must be called
+ * whenever those are changed directly, e.g. when they are restored from a network or replay stream.
+ */
+void sprite_spatial_index_sync()
+{
+    std::fill_n(_spriteSpatialCellOfSprite, std::size(_spriteSpatialCellOfSprite), SPATIAL_INDEX_CELL_NONE);
+    for (uint32_t cell = 0; cell < SPATIAL_INDEX_LOCATION_NULL; cell++)
+    {
+        auto& entries = _spriteSpatialCells[cell];
+        entries.clear();
+
+        // Broken saves can contain invalid or cyclic lists, so do not trust the links blindly.
+        uint16_t spriteIndex = gSpriteSpatialIndex[cell];
+        while (spriteIndex < _spriteCapacity && _spriteSpatialCellOfSprite[spriteIndex] == SPATIAL_INDEX_CELL_NONE)
+        {
+            const rct_sprite_generic* sprite = &get_sprite(spriteIndex)->generic;
+            entries.push_back({ spriteIndex, sprite->x, sprite->y, sprite->z });
+            _spriteSpatialCellOfSprite[spriteIndex] = cell;
+            spriteIndex = sprite->next_in_quadrant;
+        }
+    }
+}
+
 static void invalidate_sprite_max_zoom(rct_sprite* sprite, int32_t maxZoom)
 {
     if (sprite->generic.sprite_left == LOCATION_NULL)
@@ -143,6 +351,7 @@ void invalidate_sprite_2(rct_sprite* sprite)
 void reset_sprite_list()
 {
     gSavedAge = 0;
+    sprite_set_capacity(SPRITE_POOL_INITIAL_CAPACITY);
     std::memset(_spriteList, 0, sizeof(_spriteList));
 
     for (int32_t i = 0; i < NUM_SPRITE_LISTS; i++)
@@ -154,7 +363,7 @@ void reset_sprite_list()
 
     rct_sprite* previous_spr = (rct_sprite*)SPRITE_INDEX_NULL;
 
-    for (int32_t i = 0; i < MAX_SPRITES; ++i)
+    for (size_t i = 0; i < _spriteCapacity; ++i)
     {
         rct_sprite* spr = get_sprite(i);
         spr->generic.sprite_identifier = SPRITE_IDENTIFIER_NULL;
@@ -176,7 +385,7 @@ void reset_sprite_list()
         previous_spr = spr;
     }
 
-    gSpriteListCount[SPRITE_LIST_NULL] = MAX_SPRITES;
+    gSpriteListCount[SPRITE_LIST_NULL] = (uint16_t)_spriteCapacity;
 
     reset_sprite_spatial_index();
 }
@@ -190,7 +399,7 @@ void reset_sprite_list()
 void reset_sprite_spatial_index()
 {
     std::fill_n(gSpriteSpatialIndex, std::size(gSpriteSpatialIndex), SPRITE_INDEX_NULL);
-    for (size_t i = 0; i < MAX_SPRITES; i++)
+    for (size_t i = 0; i < _spriteCapacity; i++)
     {
         rct_sprite* spr = get_sprite(i);
         if (spr->generic.sprite_identifier != SPRITE_IDENTIFIER_NULL)
@@ -201,6 +410,7 @@ void reset_sprite_spatial_index()
             spr->generic.next_in_quadrant = nextSpriteId;
         }
     }
+    sprite_spatial_index_sync();
 }
 
 static size_t GetSpatialIndexOffset(int32_t x, int32_t y)
@@ -220,6 +430,86 @@ static size_t GetSpatialIndexOffset(int32_t x, int32_t y)
     return index;
 }
 
+/**
+ * Returns whether the sprite is part of the checksums, and if so copies the part of it that is game state.
+ */
+static bool sprite_get_checksum_copy(const rct_sprite* sprite, rct_sprite* copy)
+{
+    if (sprite->generic.sprite_identifier == SPRITE_IDENTIFIER_NULL
+        || sprite->generic.sprite_identifier == SPRITE_IDENTIFIER_MISC)
+    {
+        return false;
+    }
+
+    *copy = *sprite;
+    copy->generic.sprite_left = copy->generic.sprite_right = copy->generic.sprite_top = copy->generic.sprite_bottom = 0;
+
+    if (copy->generic.sprite_identifier == SPRITE_IDENTIFIER_PEEP)
+    {
+        // We set this to 0 because as soon the client selects a guest the window will remove the
+        // invalidation flags causing the sprite checksum to be different than on server, the flag does not affect
+        // game state.
+        copy->peep.window_invalidate_flags = 0;
+    }
+    return true;
+}
+
+static uint64_t sprite_checksum_mix(uint64_t value)
+{
+    value ^= value >> 33;
+    value *= 0xff51afd7ed558ccdULL;
+    value ^= value >> 33;
+    value *= 0xc4ceb9fe1a85ec53ULL;
+    value ^= value >> 33;
+    return value;
+}
+
+static uint64_t sprite_checksum_fast_sprite(size_t spriteIndex)
+{
+    rct_sprite copy;
+    if (!sprite_get_checksum_copy(get_sprite(spriteIndex), &copy))
+    {
+        return 0;
+    }
+
+    uint64_t words[sizeof(rct_sprite) / sizeof(uint64_t)];
+    std::memcpy(words, &copy, sizeof(words));
+    uint64_t hash = sprite_checksum_mix(spriteIndex + 1);
+    for (auto word : words)
+    {
+        hash = sprite_checksum_mix(hash ^ word);
+    }
+    return hash;
+}
+
+uint64_t sprite_checksum_fast()
+{
+    // Each sprite is hashed together with its index and the hashes are summed, so the blocks can be hashed in any
+    // order and on any number of threads without changing the result.
+    constexpr size_t blockSize = 1024;
+    size_t numBlocks = (_spriteCapacity + blockSize - 1) / blockSize;
+    std::vector<uint64_t> blockSums(numBlocks);
+    JobPool::ParallelFor(
+        0, numBlocks,
+        [&blockSums](size_t block) {
+            size_t end = std::min(_spriteCapacity, (block + 1) * blockSize);
+            uint64_t sum = 0;
+            for (size_t i = block * blockSize; i < end; i++)
+            {
+                sum += sprite_checksum_fast_sprite(i);
+            }
+            blockSums[block] = sum;
+        },
+        1);
+
+    uint64_t checksum = 0;
+    for (auto sum : blockSums)
+    {
+        checksum += sum;
+    }
+    return checksum;
+}
+
 #ifndef DISABLE_NETWORK
 
 rct_sprite_checksum sprite_checksum()
@@ -240,23 +530,11 @@ rct_sprite_checksum sprite_checksum()
         }
 
         _spriteHashAlg->Clear();
-        for (size_t i = 0; i < MAX_SPRITES; i++)
+        for (size_t i = 0; i < _spriteCapacity; i++)
         {
-            auto sprite = get_sprite(i);
-            if (sprite->generic.sprite_identifier != SPRITE_IDENTIFIER_NULL
-                && sprite->generic.sprite_identifier != SPRITE_IDENTIFIER_MISC)
+            rct_sprite copy;
+            if (sprite_get_checksum_copy(get_sprite(i), &copy))
             {
-                auto copy = *sprite;
-                copy.generic.sprite_left = copy.generic.sprite_right = copy.generic.sprite_top = copy.generic.sprite_bottom = 0;
-
-                if (copy.generic.sprite_identifier == SPRITE_IDENTIFIER_PEEP)
-                {
-                    // We set this to 0 because as soon the client selects a guest the window will remove the
-                    // invalidation flags causing the sprite checksum to be different than on server, the flag does not affect
-                    // game state.
-                    copy.peep.window_invalidate_flags = 0;
-                }
-
                 _spriteHashAlg->Update(&copy, sizeof(copy));
             }
         }
@@ -346,11 +624,15 @@ rct_sprite* create_sprite(uint8_t bl)
         uint16_t cx = 0x12C - gSpriteListCount[SPRITE_LIST_MISC];
         if (cx >= gSpriteListCount[SPRITE_LIST_NULL])
         {
-            return nullptr;
+            // Only grow the pool if it is the lack of free sprites rather than the misc limit that is in the way
+            if (gSpriteListCount[SPRITE_LIST_MISC] > 0x12C || !sprite_pool_grow())
+            {
+                return nullptr;
+            }
         }
         linkedListTypeOffset = SPRITE_LIST_MISC * 2;
     }
-    else if (gSpriteListCount[SPRITE_LIST_NULL] == 0)
+    else if (gSpriteListCount[SPRITE_LIST_NULL] == 0 && !sprite_pool_grow())
     {
         return nullptr;
     }
@@ -619,6 +901,9 @@ void sprite_move(int16_t x, int16_t y, int16_t z, rct_sprite* sprite)
         int32_t tempSpriteIndex = gSpriteSpatialIndex[newIndex];
         gSpriteSpatialIndex[newIndex] = sprite->generic.sprite_index;
         sprite->generic.next_in_quadrant = tempSpriteIndex;
+
+        sprite_spatial_cell_remove(sprite->generic.sprite_index);
+        sprite_spatial_cell_insert(newIndex, sprite->generic.sprite_index, x, y, z);
     }
 
     if (x == LOCATION_NULL)
@@ -664,6 +949,14 @@ void sprite_set_coordinates(int16_t x, int16_t y, int16_t z, rct_sprite* sprite)
     sprite->generic.x = x;
     sprite->generic.y = y;
     sprite->generic.z = z;
+
+    SpriteSpatialEntry* entry = sprite_spatial_cell_find(sprite->generic.sprite_index);
+    if (entry != nullptr)
+    {
+        entry->x = x;
+        entry->y = y;
+        entry->z = z;
+    }
 }
 
 /**
@@ -685,6 +978,7 @@ void sprite_remove(rct_sprite* sprite)
         spriteIndex = &quadrantSprite->generic.next_in_quadrant;
     }
     *spriteIndex = sprite->generic.next_in_quadrant;
+    sprite_spatial_cell_remove(sprite->generic.sprite_index);
 }
 
 static bool litter_can_be_at(int32_t x, int32_t y, int32_t z)
@@ -772,25 +1066,23 @@ void litter_create(int32_t x, int32_t y, int32_t z, int32_t direction, int32_t t
  */
 void litter_remove_at(int32_t x, int32_t y, int32_t z)
 {
-    uint16_t spriteIndex = sprite_get_first_in_quadrant(x, y);
-    while (spriteIndex != SPRITE_INDEX_NULL)
+    // Removing a sprite shifts the next one into its slot, so only advance past sprites that are kept.
+    const auto& quadrant = sprite_get_quadrant(x, y);
+    size_t i = 0;
+    while (i < quadrant.size())
     {
-        rct_sprite* sprite = get_sprite(spriteIndex);
-        uint16_t nextSpriteIndex = sprite->generic.next_in_quadrant;
-        if (sprite->generic.linked_list_type_offset == SPRITE_LIST_LITTER * 2)
+        const SpriteSpatialEntry& entry = quadrant[i];
+        if (abs(entry.z - z) <= 16 && abs(entry.x - x) <= 8 && abs(entry.y - y) <= 8)
         {
-            rct_litter* litter = &sprite->litter;
-
-            if (abs(litter->z - z) <= 16)
+            rct_sprite* sprite = get_sprite(entry.sprite_index);
+            if (sprite->generic.linked_list_type_offset == SPRITE_LIST_LITTER * 2)
             {
-                if (abs(litter->x - x) <= 8 && abs(litter->y - y) <= 8)
-                {
-                    invalidate_sprite_0(sprite);
-                    sprite_remove(sprite);
-                }
+                invalidate_sprite_0(sprite);
+                sprite_remove(sprite);
+                continue;
             }
         }
-        spriteIndex = nextSpriteIndex;
+        i++;
     }
 }
 
@@ -811,11 +1103,11 @@ static bool sprite_should_tween(rct_sprite* sprite)
 
 static void store_sprite_locations(LocationXYZ16* sprite_locations)
 {
-    for (uint16_t i = 0; i < MAX_SPRITES; i++)
+    for (size_t i = 0; i < _spriteCapacity; i++)
     {
         // skip going through `get_sprite` to not get stalled on assert,
         // this can get very expensive for busy parks with uncap FPS option on
-        const rct_sprite* sprite = &_spriteList[i];
+        const rct_sprite* sprite = get_sprite_unchecked(i);
         sprite_locations[i].x = sprite->generic.x;
         sprite_locations[i].y = sprite->generic.y;
         sprite_locations[i].z = sprite->generic.z;
@@ -836,7 +1128,7 @@ void sprite_position_tween_all(float alpha)
 {
     const float inv = (1.0f - alpha);
 
-    for (uint16_t i = 0; i < MAX_SPRITES; i++)
+    for (size_t i = 0; i < _spriteCapacity; i++)
     {
         rct_sprite* sprite = get_sprite(i);
         if (sprite_should_tween(sprite))
@@ -860,7 +1152,7 @@ void sprite_position_tween_all(float alpha)
  */
 void sprite_position_tween_restore()
 {
-    for (uint16_t i = 0; i < MAX_SPRITES; i++)
+    for (size_t i = 0; i < _spriteCapacity; i++)
     {
         rct_sprite* sprite = get_sprite(i);
         if (sprite_should_tween(sprite))
@@ -875,7 +1167,7 @@ void sprite_position_tween_restore()
 
 void sprite_position_tween_reset()
 {
-    for (uint16_t i = 0; i < MAX_SPRITES; i++)
+    for (size_t i = 0; i < _spriteCapacity; i++)
     {
         rct_sprite* sprite = get_sprite(i);
         _spritelocations1[i].x = _spritelocations2[i].x = sprite->generic.x;
@@ -1042,7 +1334,7 @@ int32_t fix_disjoint_sprites()
     int32_t count = 0;
 
     // Find all null sprites
-    for (sprite_idx = 0; sprite_idx < MAX_SPRITES; sprite_idx++)
+    for (sprite_idx = 0; sprite_idx < _spriteCapacity; sprite_idx++)
     {
         rct_sprite* spr = get_sprite(sprite_idx);
         if (spr->generic.sprite_identifier == SPRITE_IDENTIFIER_NULL)
@@ -1090,6 +1382,7 @@ int32_t check_for_spatial_index_cycles(bool fix)
                     spr->generic.next_in_quadrant = SPRITE_INDEX_NULL;
                     cycle_start = spr;
                 }
+                sprite_spatial_index_sync();
             }
             return i;
         }
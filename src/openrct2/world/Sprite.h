@@ -14,8 +14,15 @@
 #include "../peep/Peep.h"
 #include "../ride/Vehicle.h"
 
+#include <vector>
+
+interface IStream;
+
 #define SPRITE_INDEX_NULL 0xFFFF
-#define MAX_SPRITES 10000
+// The sprite pool starts with as many sprites as an S6 file can hold and grows in chunks when it runs out.
+#define SPRITE_POOL_INITIAL_CAPACITY 10000
+#define SPRITE_POOL_CHUNK_SIZE 2000
+#define MAX_SPRITES 64000
 #define NUM_SPRITE_LISTS 6
 
 enum SPRITE_IDENTIFIER
@@ -247,6 +254,18 @@ enum
     LITTER_TYPE_EMPTY_BOWL_BLUE,
 };
 
+/**
+ * A sprite in a spatial index cell together with a copy of its position, so that a cell can be
+ * filtered without touching the sprites themselves.
+ */
+struct SpriteSpatialEntry
+{
+    uint16_t sprite_index;
+    int16_t x;
+    int16_t y;
+    int16_t z;
+};
+
 rct_sprite* try_get_sprite(size_t spriteIndex);
 rct_sprite* get_sprite(size_t sprite_idx);
 
@@ -258,6 +277,10 @@ extern const rct_string_id litterNames[12];
 
 rct_sprite* create_sprite(uint8_t bl);
 void reset_sprite_list();
+size_t sprite_get_capacity();
+void sprite_set_capacity(size_t capacity);
+void sprite_write_extended_pool(IStream* stream);
+void sprite_read_extended_pool(IStream* stream);
 void reset_sprite_spatial_index();
 void sprite_clear_all_unused();
 void move_sprite_to_list(rct_sprite* sprite, uint8_t cl);
@@ -273,6 +296,8 @@ void litter_remove_at(int32_t x, int32_t y, int32_t z);
 void sprite_misc_explosion_cloud_create(int32_t x, int32_t y, int32_t z);
 void sprite_misc_explosion_flare_create(int32_t x, int32_t y, int32_t z);
 uint16_t sprite_get_first_in_quadrant(int32_t x, int32_t y);
+const std::vector<SpriteSpatialEntry>& sprite_get_quadrant(int32_t x, int32_t y);
+void sprite_spatial_index_sync();
 void sprite_position_tween_store_a();
 void sprite_position_tween_store_b();
 void sprite_position_tween_all(float nudge);
@@ -314,6 +339,12 @@ void crash_splash_update(rct_crash_splash* splash);
 
 rct_sprite_checksum sprite_checksum();
 
+/**
+ * A much cheaper checksum of the same sprite state as sprite_checksum, used to check network clients stay in sync.
+ * Replays keep using sprite_checksum, as they store its result.
+ */
+uint64_t sprite_checksum_fast();
+
 void sprite_set_flashing(rct_sprite* sprite, bool flashing);
 bool sprite_get_flashing(rct_sprite* sprite);
 int32_t check_for_sprite_list_cycles(bool fix);
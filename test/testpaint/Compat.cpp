@@ -151,7 +151,7 @@ rct_ride_entry* get_ride_entry_by_ride(const Ride* ride)
 
 rct_sprite* get_sprite(size_t sprite_idx)
 {
-    assert(sprite_idx < MAX_SPRITES);
+    assert(sprite_idx < SPRITE_POOL_INITIAL_CAPACITY);
     return &sprite_list[sprite_idx];
 }
 
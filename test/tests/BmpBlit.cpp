@@ -0,0 +1,162 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <gtest/gtest.h>
+#include <openrct2/drawing/Drawing.h>
+#include <openrct2/util/Util.h>
+#include <random>
+#include <vector>
+
+using bmp_blit_copy_func = void (*)(int32_t, int32_t, const uint8_t*, uint8_t*, int32_t, int32_t);
+using bmp_blit_remap_func = void (*)(int32_t, int32_t, const uint8_t*, uint8_t*, const uint8_t*, int32_t, int32_t);
+
+class BmpBlitTest : public testing::Test
+{
+protected:
+    static constexpr int32_t SourceWidth = 100;
+    static constexpr int32_t DestWidth = 120;
+    static constexpr int32_t Height = 20;
+
+    std::vector<uint8_t> Source = std::vector<uint8_t>(SourceWidth * Height);
+    std::vector<uint8_t> Dest = std::vector<uint8_t>(DestWidth * Height);
+    std::vector<uint8_t> Palette = std::vector<uint8_t>(256);
+
+    void SetUp() override
+    {
+        std::mt19937 random(0);
+        // About a third of the sprite is transparent, in runs as well as single pixels.
+        for (size_t i = 0; i < Source.size(); i++)
+        {
+            Source[i] = (i % 37 < 8 || random() % 5 == 0) ? 0 : (uint8_t)random();
+        }
+        for (auto& pixel : Dest)
+        {
+            pixel = (uint8_t)random();
+        }
+        // Some colours remap to 0, which leaves the pixel untouched.
+        for (size_t i = 0; i < Palette.size(); i++)
+        {
+            Palette[i] = i % 11 == 0 ? 0 : (uint8_t)random();
+        }
+    }
+
+    /**
+     * Blits every width up to the width of the source, so the kernels run with and without a scalar tail.
+     */
+    void ExpectSameAsScalar(bmp_blit_copy_func func)
+    {
+        for (int32_t width = 1; width <= SourceWidth; width++)
+        {
+            auto expected = Dest;
+            auto actual = Dest;
+            bmp_blit_copy_scalar(width, Height, Source.data(), expected.data(), SourceWidth - width, DestWidth - width);
+            func(width, Height, Source.data(), actual.data(), SourceWidth - width, DestWidth - width);
+            ASSERT_EQ(actual, expected) << "width " << width;
+        }
+    }
+
+    void ExpectSameAsScalar(bmp_blit_remap_func func, bmp_blit_remap_func scalarFunc)
+    {
+        for (int32_t width = 1; width <= SourceWidth; width++)
+        {
+            auto expected = Dest;
+            auto actual = Dest;
+            scalarFunc(
+                width, Height, Source.data(), expected.data(), Palette.data(), SourceWidth - width, DestWidth - width);
+            func(width, Height, Source.data(), actual.data(), Palette.data(), SourceWidth - width, DestWidth - width);
+            ASSERT_EQ(actual, expected) << "width " << width;
+        }
+    }
+};
+
+TEST_F(BmpBlitTest, scalar)
+{
+    auto copied = Dest;
+    auto remapped = Dest;
+    auto glass = Dest;
+    bmp_blit_copy_scalar(SourceWidth, Height, Source.data(), copied.data(), 0, DestWidth - SourceWidth);
+    bmp_blit_remap_scalar(SourceWidth, Height, Source.data(), remapped.data(), Palette.data(), 0, DestWidth - SourceWidth);
+    bmp_blit_glass_scalar(SourceWidth, Height, Source.data(), glass.data(), Palette.data(), 0, DestWidth - SourceWidth);
+    for (int32_t y = 0; y < Height; y++)
+    {
+        for (int32_t x = 0; x < DestWidth; x++)
+        {
+            uint8_t source = x < SourceWidth ? Source[y * SourceWidth + x] : 0;
+            uint8_t dest = Dest[y * DestWidth + x];
+            size_t i = y * DestWidth + x;
+            ASSERT_EQ(copied[i], source != 0 ? source : dest);
+            ASSERT_EQ(remapped[i], Palette[source] != 0 ? Palette[source] : dest);
+            ASSERT_EQ(glass[i], source != 0 ? Palette[dest] : dest);
+        }
+    }
+}
+
+TEST_F(BmpBlitTest, sse4_1_matches_scalar)
+{
+    if (!sse41_available())
+    {
+        return;
+    }
+    ExpectSameAsScalar(bmp_blit_copy_sse4_1);
+    ExpectSameAsScalar(bmp_blit_glass_sse4_1, bmp_blit_glass_scalar);
+}
+
+TEST_F(BmpBlitTest, avx2_matches_scalar)
+{
+    if (!avx2_available())
+    {
+        return;
+    }
+    ExpectSameAsScalar(bmp_blit_copy_avx2);
+    ExpectSameAsScalar(bmp_blit_remap_avx2, bmp_blit_remap_scalar);
+    ExpectSameAsScalar(bmp_blit_glass_avx2, bmp_blit_glass_scalar);
+}
+
+TEST_F(BmpBlitTest, unzoomed_sprites_match_zoomed_path)
+{
+    // Zoom level 0 goes through the blit functions, so compare it with what the zoomed loops draw at zoom level 0 with
+    // every other pixel skipped. Drawing the sprite at zoom level 1 samples every other pixel of every other line.
+    rct_g1_element g1 = {};
+    g1.offset = Source.data();
+    g1.width = SourceWidth;
+    g1.height = Height;
+    g1.flags = G1_FLAG_BMP;
+
+    std::vector<uint8_t> halfSource;
+    for (int32_t y = 0; y < Height; y += 2)
+    {
+        for (int32_t x = 0; x < SourceWidth; x += 2)
+        {
+            halfSource.push_back(Source[y * SourceWidth + x]);
+        }
+    }
+    rct_g1_element halfG1 = g1;
+    halfG1.offset = halfSource.data();
+    halfG1.width = SourceWidth / 2;
+    halfG1.height = Height / 2;
+
+    for (int32_t imageType : { IMAGE_TYPE_DEFAULT, IMAGE_TYPE_REMAP, IMAGE_TYPE_TRANSPARENT })
+    {
+        rct_drawpixelinfo dpi = {};
+        dpi.width = DestWidth;
+        dpi.height = Height;
+
+        auto unzoomed = Dest;
+        dpi.zoom_level = 0;
+        gfx_bmp_sprite_to_buffer(
+            Palette.data(), halfG1.offset, unzoomed.data(), &halfG1, &dpi, halfG1.height, halfG1.width, imageType);
+
+        auto zoomed = Dest;
+        dpi.width = DestWidth * 2;
+        dpi.zoom_level = 1;
+        gfx_bmp_sprite_to_buffer(Palette.data(), g1.offset, zoomed.data(), &g1, &dpi, g1.height, g1.width, imageType);
+
+        ASSERT_EQ(unzoomed, zoomed) << "image type " << imageType;
+    }
+}
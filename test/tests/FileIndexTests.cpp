@@ -0,0 +1,178 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <algorithm>
+#include <atomic>
+#include <gtest/gtest.h>
+#include <openrct2/core/File.h>
+#include <openrct2/core/FileIndex.hpp>
+#include <openrct2/core/Path.hpp>
+#include <openrct2/platform/platform.h>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#    include <sys/utime.h>
+#else
+#    include <utime.h>
+#endif
+
+/**
+ * Indexes the contents of text files and counts how many files it had to load.
+ */
+class TextFileIndex final : public FileIndex<std::string>
+{
+public:
+    mutable std::atomic<size_t> NumCreated = { 0 };
+
+    explicit TextFileIndex(const std::string& directory)
+        : FileIndex("text file index", 0x58444946, 1, Path::Combine(directory, "index.idx"), "*.txt", { directory })
+    {
+    }
+
+protected:
+    std::tuple<bool, std::string> Create(int32_t, const std::string& path) const override
+    {
+        NumCreated++;
+        return std::make_tuple(true, File::ReadAllText(path));
+    }
+
+    void Serialise(IStream* stream, const std::string& item) const override
+    {
+        stream->WriteString(item);
+    }
+
+    std::string Deserialise(IStream* stream) const override
+    {
+        return stream->ReadStdString();
+    }
+};
+
+class FileIndexTest : public testing::Test
+{
+protected:
+    std::string Directory = Path::GetAbsolute("file_index_test");
+
+    void SetUp() override
+    {
+        platform_directory_delete(Directory.c_str());
+        Path::CreateDirectory(Directory);
+        WriteFile("a.txt", "apple");
+        WriteFile("b.txt", "banana");
+        WriteFile("c.txt", "cherry");
+    }
+
+    void TearDown() override
+    {
+        platform_directory_delete(Directory.c_str());
+    }
+
+    void WriteFile(const std::string& name, const std::string& contents)
+    {
+        File::WriteAllBytes(Path::Combine(Directory, name), contents.data(), contents.size());
+    }
+
+    /**
+     * Changes the modification date of a file without changing its contents.
+     */
+    void TouchFile(const std::string& name, time_t time)
+    {
+        auto path = Path::Combine(Directory, name);
+#ifdef _WIN32
+        struct _utimbuf times = { time, time };
+        _utime(path.c_str(), &times);
+#else
+        struct utimbuf times = { time, time };
+        utime(path.c_str(), &times);
+#endif
+    }
+
+    static std::vector<std::string> Sorted(std::vector<std::string> items)
+    {
+        std::sort(items.begin(), items.end());
+        return items;
+    }
+};
+
+TEST_F(FileIndexTest, unchanged_files_are_loaded_from_index)
+{
+    TextFileIndex index(Directory);
+    auto built = index.LoadOrBuild(0);
+    ASSERT_EQ(index.NumCreated.load(), 3U);
+    ASSERT_EQ(Sorted(built), (std::vector<std::string>{ "apple", "banana", "cherry" }));
+
+    auto loaded = index.LoadOrBuild(0);
+    ASSERT_EQ(index.NumCreated.load(), 3U);
+    ASSERT_EQ(loaded, built);
+}
+
+TEST_F(FileIndexTest, only_new_and_changed_files_are_indexed)
+{
+    TextFileIndex index(Directory);
+    index.LoadOrBuild(0);
+
+    WriteFile("b.txt", "blueberry");
+    WriteFile("d.txt", "date");
+    auto items = index.LoadOrBuild(0);
+    ASSERT_EQ(index.NumCreated.load(), 5U);
+    ASSERT_EQ(Sorted(items), (std::vector<std::string>{ "apple", "blueberry", "cherry", "date" }));
+}
+
+TEST_F(FileIndexTest, deleted_files_are_removed)
+{
+    TextFileIndex index(Directory);
+    index.LoadOrBuild(0);
+
+    File::Delete(Path::Combine(Directory, "a.txt"));
+    auto items = index.LoadOrBuild(0);
+    ASSERT_EQ(index.NumCreated.load(), 3U);
+    ASSERT_EQ(Sorted(items), (std::vector<std::string>{ "banana", "cherry" }));
+
+    // The index no longer contains the deleted file either
+    index.LoadOrBuild(0);
+    ASSERT_EQ(index.NumCreated.load(), 3U);
+}
+
+TEST_F(FileIndexTest, language_change_rebuilds_index)
+{
+    TextFileIndex index(Directory);
+    index.LoadOrBuild(0);
+    index.LoadOrBuild(1);
+    ASSERT_EQ(index.NumCreated.load(), 6U);
+}
+
+TEST_F(FileIndexTest, touched_files_are_loaded_from_index)
+{
+    TextFileIndex index(Directory);
+    index.LoadOrBuild(0);
+
+    TouchFile("a.txt", 1000000000);
+    auto items = index.LoadOrBuild(0);
+    ASSERT_EQ(index.NumCreated.load(), 3U);
+    ASSERT_EQ(Sorted(items), (std::vector<std::string>{ "apple", "banana", "cherry" }));
+
+    // The new modification date is stored, so the file is not hashed again on the next load
+    TouchFile("a.txt", 1100000000);
+    index.LoadOrBuild(0);
+    ASSERT_EQ(index.NumCreated.load(), 3U);
+}
+
+TEST_F(FileIndexTest, touched_and_changed_files_are_indexed)
+{
+    TextFileIndex index(Directory);
+    index.LoadOrBuild(0);
+
+    WriteFile("a.txt", "apricot");
+    // Same size as before, so only the content hash tells it apart
+    WriteFile("c.txt", "citron");
+    TouchFile("c.txt", 1000000000);
+    auto items = index.LoadOrBuild(0);
+    ASSERT_EQ(index.NumCreated.load(), 5U);
+    ASSERT_EQ(Sorted(items), (std::vector<std::string>{ "apricot", "banana", "citron" }));
+}
@@ -0,0 +1,190 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <atomic>
+#include <chrono>
+#include <gtest/gtest.h>
+#include <openrct2/core/JobPool.h>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+TEST(JobPoolTest, parallel_for_visits_every_index_once)
+{
+    constexpr size_t count = 100000;
+    std::vector<std::atomic<int>> visits(count);
+    JobPool::ParallelFor(0, count, [&visits](size_t i) { visits[i]++; });
+    for (size_t i = 0; i < count; i++)
+    {
+        ASSERT_EQ(visits[i].load(), 1);
+    }
+}
+
+TEST(JobPoolTest, parallel_for_empty_and_small_ranges)
+{
+    std::atomic<size_t> calls = { 0 };
+    JobPool::ParallelFor(10, 10, [&calls](size_t) { calls++; });
+    ASSERT_EQ(calls.load(), 0U);
+    JobPool::ParallelFor(10, 13, [&calls](size_t) { calls++; }, 100);
+    ASSERT_EQ(calls.load(), 3U);
+}
+
+TEST(JobPoolTest, task_groups_wait_independently)
+{
+    std::atomic<int> first = { 0 };
+    std::atomic<int> second = { 0 };
+    TaskGroup groupA;
+    TaskGroup groupB;
+    for (int i = 0; i < 64; i++)
+    {
+        groupA.Run([&first]() { first++; });
+        groupB.Run([&second]() { second += 2; });
+    }
+    groupA.Wait();
+    ASSERT_TRUE(groupA.IsDone());
+    ASSERT_EQ(first.load(), 64);
+    groupB.Wait();
+    ASSERT_EQ(second.load(), 128);
+}
+
+TEST(JobPoolTest, nested_groups)
+{
+    std::atomic<int> total = { 0 };
+    JobPool::ParallelFor(
+        0, 16,
+        [&total](size_t) {
+            TaskGroup inner;
+            for (int i = 0; i < 16; i++)
+            {
+                inner.Run([&total]() { total++; });
+            }
+            inner.Wait();
+        },
+        1);
+    ASSERT_EQ(total.load(), 256);
+}
+
+TEST(JobPoolTest, waiting_only_runs_jobs_of_the_group)
+{
+    // Keep every worker busy so the waiting thread is the only one that could run the unrelated job.
+    std::atomic_bool release = { false };
+    TaskGroup busy;
+    for (size_t i = 0; i + 1 < JobPool::GetNumThreads(); i++)
+    {
+        busy.Run([&release]() {
+            while (!release)
+            {
+                std::this_thread::yield();
+            }
+        });
+    }
+
+    std::atomic_bool waiting = { true };
+    std::atomic_bool ranWhileWaiting = { false };
+    TaskGroup unrelated;
+    unrelated.Run([&waiting, &ranWhileWaiting]() { ranWhileWaiting = waiting.load(); });
+
+    std::atomic<int> total = { 0 };
+    TaskGroup group;
+    group.Run([&total]() { total++; });
+    group.Wait();
+    waiting = false;
+
+    release = true;
+    busy.Wait();
+    unrelated.Wait();
+    ASSERT_EQ(total.load(), 1);
+    ASSERT_FALSE(ranWhileWaiting.load());
+}
+
+TEST(JobPoolTest, more_jobs_than_queue_capacity)
+{
+    constexpr int count = 20000;
+    std::atomic<int> total = { 0 };
+    TaskGroup group;
+    for (int i = 0; i < count; i++)
+    {
+        group.Run([&total]() { total++; });
+    }
+    group.Wait();
+    ASSERT_EQ(total.load(), count);
+}
+
+TEST(JobPoolTest, wait_rethrows_exceptions)
+{
+    TaskGroup group;
+    group.Run([]() { throw std::runtime_error("job failed"); });
+    ASSERT_THROW(group.Wait(), std::runtime_error);
+    // The exception is only reported once.
+    group.Run([]() {});
+    group.Wait();
+}
+
+TEST(JobPoolTest, wait_sleeps_until_jobs_on_other_threads_finish)
+{
+    std::atomic_bool started = { false };
+    std::atomic<int> reports = { 0 };
+    TaskGroup group;
+    group.Run([&started]() {
+        started = true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    });
+    while (!started)
+    {
+        std::this_thread::yield();
+    }
+    // The only job is running on a worker, so the wait can only return once that job has finished.
+    group.Wait([&reports]() { reports++; });
+    ASSERT_TRUE(group.IsDone());
+    ASSERT_EQ(reports.load(), 1);
+}
+
+TEST(JobPoolTest, future_returns_result)
+{
+    int a = 6;
+    int b = 7;
+    JobFuture<int> future;
+    future.Run([&a, &b]() { return a * b; });
+    ASSERT_EQ(future.Get(), 42);
+    ASSERT_TRUE(future.IsReady());
+}
+
+TEST(JobPoolTest, futures_run_in_parallel)
+{
+    std::vector<int> values(1000);
+    for (size_t i = 0; i < values.size(); i++)
+    {
+        values[i] = static_cast<int>(i);
+    }
+    const int* data = values.data();
+    size_t half = values.size() / 2;
+
+    JobFuture<int> first;
+    JobFuture<int> second;
+    first.Run([data, half]() {
+        int sum = 0;
+        for (size_t i = 0; i < half; i++)
+            sum += data[i];
+        return sum;
+    });
+    second.Run([data, half]() {
+        int sum = 0;
+        for (size_t i = half; i < half * 2; i++)
+            sum += data[i];
+        return sum;
+    });
+    ASSERT_EQ(first.Get() + second.Get(), 999 * 1000 / 2);
+}
+
+TEST(JobPoolTest, future_rethrows_exceptions)
+{
+    JobFuture<int> future;
+    future.Run([]() -> int { throw std::runtime_error("job failed"); });
+    ASSERT_THROW(future.Get(), std::runtime_error);
+}
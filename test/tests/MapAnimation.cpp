@@ -0,0 +1,134 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <gtest/gtest.h>
+#include <openrct2/Game.h>
+#include <openrct2/world/Map.h>
+#include <openrct2/world/MapAnimation.h>
+#include <vector>
+
+class MapAnimationTest : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        std::vector<TileElement> tileElements(MAX_TILE_TILE_ELEMENT_POINTERS);
+        for (auto& tileElement : tileElements)
+        {
+            tileElement.ClearAs(TILE_ELEMENT_TYPE_SURFACE);
+            tileElement.flags = TILE_ELEMENT_FLAG_LAST_TILE;
+            tileElement.base_height = 14;
+            tileElement.clearance_height = 14;
+        }
+        map_load_tile_elements(tileElements);
+        map_animation_clear();
+    }
+
+    // Places a banner on the tile, which keeps a banner animation on it alive.
+    static void PlaceBanner(int32_t x, int32_t y, int32_t z)
+    {
+        TileElement* tileElement = tile_element_insert(x, y, z, 0);
+        ASSERT_NE(tileElement, nullptr);
+        tileElement->SetType(TILE_ELEMENT_TYPE_BANNER);
+    }
+};
+
+TEST_F(MapAnimationTest, create_ignores_duplicates)
+{
+    map_animation_create(MAP_ANIMATION_TYPE_BANNER, 10 * 32, 10 * 32, 20);
+    map_animation_create(MAP_ANIMATION_TYPE_BANNER, 10 * 32, 10 * 32, 20);
+    ASSERT_EQ(map_animation_get_count(), 1U);
+
+    map_animation_create(MAP_ANIMATION_TYPE_WALL, 10 * 32, 10 * 32, 20);
+    map_animation_create(MAP_ANIMATION_TYPE_BANNER, 10 * 32, 10 * 32, 22);
+    map_animation_create(MAP_ANIMATION_TYPE_BANNER, 11 * 32, 10 * 32, 20);
+    ASSERT_EQ(map_animation_get_count(), 4U);
+}
+
+TEST_F(MapAnimationTest, create_stops_at_s6_capacity)
+{
+    for (int32_t i = 0; i < MAX_ANIMATED_OBJECTS + 10; i++)
+    {
+        map_animation_create(MAP_ANIMATION_TYPE_BANNER, (i % 200) * 32, (i / 200) * 32, 20);
+    }
+    ASSERT_EQ(map_animation_get_count(), (size_t)MAX_ANIMATED_OBJECTS);
+}
+
+TEST_F(MapAnimationTest, invalidate_removes_stale_animations)
+{
+    // Only every other tile has the banner its animation belongs to.
+    for (int32_t i = 0; i < 100; i++)
+    {
+        if (i % 2 == 0)
+        {
+            PlaceBanner(i, 5, 20);
+        }
+        map_animation_create(MAP_ANIMATION_TYPE_BANNER, i * 32, 5 * 32, 20);
+    }
+    map_animation_create(MAP_ANIMATION_TYPE_REMOVE, 0, 0, 0);
+    ASSERT_EQ(map_animation_get_count(), 101U);
+
+    // Animations nothing can see are checked over a few ticks.
+    for (uint32_t i = 0; i < MAP_ANIMATION_VALIDATE_INTERVAL; i++)
+    {
+        gCurrentTicks = i;
+        map_animation_invalidate_all();
+    }
+    ASSERT_EQ(map_animation_get_count(), 50U);
+    for (const auto& animation : map_animation_get_all())
+    {
+        ASSERT_EQ(animation.type, MAP_ANIMATION_TYPE_BANNER);
+        ASSERT_EQ((animation.x / 32) % 2, 0);
+    }
+
+    // The animations that were moved around by the removals are still found on their tiles.
+    for (int32_t i = 0; i < 100; i += 2)
+    {
+        map_animation_create(MAP_ANIMATION_TYPE_BANNER, i * 32, 5 * 32, 20);
+    }
+    ASSERT_EQ(map_animation_get_count(), 50U);
+}
+
+TEST_F(MapAnimationTest, unseen_animations_are_checked_periodically)
+{
+    map_animation_create(MAP_ANIMATION_TYPE_BANNER, 1 * 32, 0, 20);
+
+    gCurrentTicks = 0;
+    map_animation_invalidate_all();
+    ASSERT_EQ(map_animation_get_count(), 1U);
+
+    // The check is spread out over the map, tile (1, 0) is checked a tick before tile (0, 0).
+    gCurrentTicks = MAP_ANIMATION_VALIDATE_INTERVAL - 1;
+    map_animation_invalidate_all();
+    ASSERT_EQ(map_animation_get_count(), 0U);
+}
+
+TEST_F(MapAnimationTest, load_and_get_round_trip)
+{
+    std::vector<rct_map_animation> animations;
+    for (int32_t i = 0; i < 10; i++)
+    {
+        rct_map_animation animation;
+        animation.type = MAP_ANIMATION_TYPE_BANNER;
+        animation.x = 3 * 32;
+        animation.y = 4 * 32;
+        animation.baseZ = 20 + i;
+        animations.push_back(animation);
+    }
+    map_animation_load(animations);
+
+    auto loaded = map_animation_get_all();
+    ASSERT_EQ(loaded.size(), animations.size());
+    for (size_t i = 0; i < loaded.size(); i++)
+    {
+        ASSERT_EQ(loaded[i].baseZ, animations[i].baseZ);
+    }
+    map_animation_create(MAP_ANIMATION_TYPE_BANNER, 3 * 32, 4 * 32, 25);
+    ASSERT_EQ(map_animation_get_count(), animations.size());
+}
@@ -0,0 +1,105 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <gtest/gtest.h>
+#include <openrct2/drawing/Drawing.h>
+#include <openrct2/util/Util.h>
+#include <random>
+#include <vector>
+
+class PaletteConversionTest : public testing::Test
+{
+protected:
+    // Not a multiple of any vector width, so the scalar tail of each kernel is used as well.
+    static constexpr size_t NumPixels = 1021;
+
+    std::vector<uint8_t> Bits = std::vector<uint8_t>(NumPixels);
+    std::vector<uint8_t> LightBits = std::vector<uint8_t>(NumPixels);
+    std::vector<uint32_t> Palette = std::vector<uint32_t>(256);
+    std::vector<uint32_t> LightPalette = std::vector<uint32_t>(256);
+
+    void SetUp() override
+    {
+        std::mt19937 random(0);
+        for (size_t i = 0; i < NumPixels; i++)
+        {
+            Bits[i] = (uint8_t)random();
+            // Include unlit pixels and the brightest light, which saturates every channel.
+            LightBits[i] = i % 3 == 0 ? 0 : (i % 7 == 0 ? 255 : (uint8_t)random());
+        }
+        for (size_t i = 0; i < 256; i++)
+        {
+            Palette[i] = (uint32_t)random();
+            LightPalette[i] = (uint32_t)random();
+        }
+    }
+
+    std::vector<uint32_t> Convert(
+        void (*func)(const uint8_t* RESTRICT, uint32_t* RESTRICT, size_t, const uint32_t* RESTRICT))
+    {
+        std::vector<uint32_t> pixels(NumPixels);
+        func(Bits.data(), pixels.data(), NumPixels, Palette.data());
+        return pixels;
+    }
+
+    std::vector<uint32_t> ConvertLit(
+        void (*func)(
+            const uint8_t* RESTRICT, const uint8_t* RESTRICT, uint32_t* RESTRICT, size_t, const uint32_t* RESTRICT,
+            const uint32_t* RESTRICT))
+    {
+        std::vector<uint32_t> pixels(NumPixels);
+        func(Bits.data(), LightBits.data(), pixels.data(), NumPixels, Palette.data(), LightPalette.data());
+        return pixels;
+    }
+};
+
+TEST_F(PaletteConversionTest, scalar)
+{
+    auto pixels = Convert(palette_to_rgba_scalar);
+    auto litPixels = ConvertLit(palette_to_rgba_lit_scalar);
+    for (size_t i = 0; i < NumPixels; i++)
+    {
+        ASSERT_EQ(pixels[i], Palette[Bits[i]]);
+        if (LightBits[i] == 0)
+        {
+            ASSERT_EQ(litPixels[i], pixels[i]);
+        }
+        else if (LightBits[i] == 255)
+        {
+            // The brightest light saturates every channel with a light colour of at least 43, (43 * 255 * 6) >> 8 is 256.
+            uint32_t light = LightPalette[Bits[i]];
+            for (int32_t shift = 0; shift < 32; shift += 8)
+            {
+                if (((light >> shift) & 0xFF) >= 43)
+                {
+                    ASSERT_EQ((litPixels[i] >> shift) & 0xFF, 0xFFU);
+                }
+            }
+        }
+    }
+}
+
+TEST_F(PaletteConversionTest, sse4_1_matches_scalar)
+{
+    if (!sse41_available())
+    {
+        return;
+    }
+    ASSERT_EQ(ConvertLit(palette_to_rgba_lit_sse4_1), ConvertLit(palette_to_rgba_lit_scalar));
+}
+
+TEST_F(PaletteConversionTest, avx2_matches_scalar)
+{
+    if (!avx2_available())
+    {
+        return;
+    }
+    ASSERT_EQ(Convert(palette_to_rgba_avx2), Convert(palette_to_rgba_scalar));
+    ASSERT_EQ(ConvertLit(palette_to_rgba_lit_avx2), ConvertLit(palette_to_rgba_lit_scalar));
+}
@@ -4,7 +4,9 @@
 #include "openrct2/ride/Station.h"
 #include "openrct2/scenario/Scenario.h"
 
+#include <cstdlib>
 #include <gtest/gtest.h>
+#include <openrct2/Cheats.h>
 #include <openrct2/Context.h>
 #include <openrct2/Game.h>
 #include <openrct2/OpenRCT2.h>
@@ -12,6 +14,7 @@
 #include <openrct2/platform/platform.h>
 #include <openrct2/world/Footpath.h>
 #include <openrct2/world/Map.h>
+#include <openrct2/world/Park.h>
 
 using namespace OpenRCT2;
 
@@ -256,3 +259,125 @@ INSTANTIATE_TEST_CASE_P(
         SimplePathfindingScenario("PathWithFences", { 11, 6, 14 }, 10000),
         SimplePathfindingScenario("PathWithCliff", { 7, 17, 14 }, 10000)),
     SimplePathfindingScenario::ToName);
+
+/**
+ * Edits the map next to the start of a guest's route, then checks that the direction the guest picks with the search
+ * results cached before the edit is the one it picks with an empty cache.
+ */
+class PathfindingCacheTest : public PathfindingTestBase
+{
+protected:
+    const TileCoordsXYZ Start = { 3, 13, 14 };
+    TileCoordsXYZ Goal;
+    TileCoordsXYZ EntranceLocation;
+    ride_id_t RideIndex = RIDE_ID_NULL;
+    // The tile the guest steps on first, where the edits are made
+    TileCoordsXYZ NextTile;
+    int32_t StartDirection = -1;
+
+    void SetUp() override
+    {
+        // Every test edits the map, so each one starts from a fresh copy of the park
+        load_from_sv6(TestData::GetParkPath("pathfinding-tests.sv6").c_str());
+        game_load_init();
+        PathfindingTestBase::SetUp();
+        gCheatsSandboxMode = true;
+        gParkFlags |= PARK_FLAGS_NO_MONEY;
+
+        Ride* ride = FindRideByName("TwoUnequalRoutes", &RideIndex);
+        ASSERT_NE(ride, nullptr);
+        auto entrancePos = ride_get_entrance_location(ride, 0);
+        EntranceLocation = TileCoordsXYZ(entrancePos.x, entrancePos.y, entrancePos.z);
+        Goal = TileCoordsXYZ(
+            entrancePos.x - TileDirectionDelta[entrancePos.direction].x,
+            entrancePos.y - TileDirectionDelta[entrancePos.direction].y, entrancePos.z);
+
+        // Fills the cache with the searches from the start
+        StartDirection = ChooseDirection();
+        ASSERT_NE(StartDirection, -1);
+        NextTile = Start;
+        NextTile += TileDirectionDelta[StartDirection];
+    }
+
+    void TearDown() override
+    {
+        gCheatsSandboxMode = false;
+    }
+
+    int32_t ChooseDirection() const
+    {
+        scenario_rand_seed(0x12345678, 0x87654321);
+        rct_peep* peep = peep_generate(Start.x * 32 + 16, Start.y * 32 + 16, Start.z * 8);
+        peep->outside_of_park = 0;
+        peep->guest_heading_to_ride_id = RideIndex;
+        gPeepPathFindGoalPosition = Goal;
+        int32_t direction = peep_pathfind_choose_direction(Start, peep);
+        peep_sprite_remove(peep);
+        return direction;
+    }
+
+    void ExpectCachedDirectionMatchesUncached() const
+    {
+        int32_t cachedDirection = ChooseDirection();
+        peep_pathfind_cache_clear();
+        int32_t uncachedDirection = ChooseDirection();
+        EXPECT_EQ(cachedDirection, uncachedDirection);
+    }
+
+    static TileElement* FindElement(const TileCoordsXYZ& location, int32_t type)
+    {
+        TileElement* tileElement = map_get_first_element_at(location.x, location.y);
+        do
+        {
+            if (tileElement->GetType() == type && std::abs(tileElement->base_height - location.z) <= 2)
+                return tileElement;
+        } while (!(tileElement++)->IsLastForTile());
+        return nullptr;
+    }
+};
+
+TEST_F(PathfindingCacheTest, PathRemoved)
+{
+    TileElement* pathElement = FindElement(NextTile, TILE_ELEMENT_TYPE_PATH);
+    ASSERT_NE(pathElement, nullptr);
+    tile_element_remove(pathElement);
+    ExpectCachedDirectionMatchesUncached();
+}
+
+TEST_F(PathfindingCacheTest, PathBecomesQueue)
+{
+    TileElement* tileElement = FindElement(NextTile, TILE_ELEMENT_TYPE_PATH);
+    ASSERT_NE(tileElement, nullptr);
+    PathElement* pathElement = tileElement->AsPath();
+    int32_t type = pathElement->GetPathEntryIndex() | (1 << 7);
+    int32_t slope = pathElement->IsSloped() ? (pathElement->GetSlopeDirection() | FOOTPATH_PROPERTIES_FLAG_IS_SLOPED) : 0;
+    money32 cost = footpath_place(
+        type, NextTile.x * 32, NextTile.y * 32, pathElement->base_height, slope,
+        GAME_COMMAND_FLAG_APPLY | GAME_COMMAND_FLAG_ALLOW_DURING_PAUSED);
+    ASSERT_NE(cost, MONEY32_UNDEFINED);
+    ASSERT_TRUE(FindElement(NextTile, TILE_ELEMENT_TYPE_PATH)->AsPath()->IsQueue());
+    ExpectCachedDirectionMatchesUncached();
+}
+
+TEST_F(PathfindingCacheTest, NoEntryBannerPlaced)
+{
+    TileElement* pathElement = FindElement(NextTile, TILE_ELEMENT_TYPE_PATH);
+    ASSERT_NE(pathElement, nullptr);
+    uint8_t z = pathElement->base_height;
+    TileElement* tileElement = tile_element_insert(NextTile.x, NextTile.y, z, 0);
+    ASSERT_NE(tileElement, nullptr);
+    tileElement->SetType(TILE_ELEMENT_TYPE_BANNER);
+    tileElement->clearance_height = z + 2;
+    BannerElement* bannerElement = tileElement->AsBanner();
+    bannerElement->SetPosition(direction_reverse(StartDirection));
+    bannerElement->SetAllowedEdges(0);
+    ExpectCachedDirectionMatchesUncached();
+}
+
+TEST_F(PathfindingCacheTest, RideEntranceRemoved)
+{
+    TileElement* entranceElement = FindElement(EntranceLocation, TILE_ELEMENT_TYPE_ENTRANCE);
+    ASSERT_NE(entranceElement, nullptr);
+    tile_element_remove(entranceElement);
+    ExpectCachedDirectionMatchesUncached();
+}
@@ -19,7 +19,9 @@
 #include <openrct2/core/String.hpp>
 #include <openrct2/platform/platform.h>
 #include <openrct2/ride/Ride.h>
+#include <openrct2/ride/RideRatings.h>
 #include <string>
+#include <vector>
 
 using namespace OpenRCT2;
 
@@ -51,6 +53,55 @@ protected:
         }
     }
 
+    void CheckRatings()
+    {
+        // Load expected ratings
+        auto expectedDataPath = Path::Combine(TestData::GetBasePath(), "ratings", "bpb.sv6.txt");
+        auto expectedRatings = File::ReadAllLines(expectedDataPath);
+
+        // Check ride ratings
+        int expI = 0;
+        for (int rideId = 0; rideId < MAX_RIDES; rideId++)
+        {
+            Ride* ride = get_ride(rideId);
+            if (ride->type != RIDE_TYPE_NULL)
+            {
+                std::string actual = FormatRatings(ride);
+                std::string expected = expectedRatings[expI];
+                ASSERT_STREQ(actual.c_str(), expected.c_str());
+
+                expI++;
+            }
+        }
+    }
+
+    /**
+     * Lets the rating processor go around every ride once, rating them in place, and returns the lifecycle flags of
+     * each ride afterwards.
+     */
+    std::vector<uint32_t> GetLifecycleFlagsFromProcessor()
+    {
+        // A ride is rated in full between the processor moving on to it and moving on to the next one
+        int32_t numRidesStarted = 0;
+        uint8_t currentRide = gRideRatingsCalcData.current_ride;
+        while (numRidesStarted <= MAX_RIDES)
+        {
+            ride_ratings_update_all();
+            if (gRideRatingsCalcData.current_ride != currentRide)
+            {
+                currentRide = gRideRatingsCalcData.current_ride;
+                numRidesStarted++;
+            }
+        }
+
+        std::vector<uint32_t> lifecycleFlags(MAX_RIDES);
+        for (int rideId = 0; rideId < MAX_RIDES; rideId++)
+        {
+            lifecycleFlags[rideId] = get_ride(rideId)->lifecycle_flags;
+        }
+        return lifecycleFlags;
+    }
+
     std::string FormatRatings(Ride* ride)
     {
         rating_tuple ratings = ride->ratings;
@@ -79,23 +130,38 @@ TEST_F(RideRatings, all)
     ASSERT_EQ(gRideCount, 134);
 
     CalculateRatingsForAllRides();
+    CheckRatings();
+}
 
-    // Load expected ratings
-    auto expectedDataPath = Path::Combine(TestData::GetBasePath(), "ratings", "bpb.sv6.txt");
-    auto expectedRatings = File::ReadAllLines(expectedDataPath);
+TEST_F(RideRatings, all_at_once)
+{
+    std::string path = TestData::GetParkPath("bpb.sv6");
 
-    // Check ride ratings
-    int expI = 0;
+    gOpenRCT2Headless = true;
+    gOpenRCT2NoGraphics = true;
+
+    core_init();
+    auto context = CreateContext();
+    bool initialised = context->Initialise();
+    ASSERT_TRUE(initialised);
+
+    load_from_sv6(path.c_str());
+    ASSERT_EQ(gRideCount, 134);
+    auto expectedLifecycleFlags = GetLifecycleFlagsFromProcessor();
+    load_from_sv6(path.c_str());
+
+    // Rating the rides in parallel must give the same ratings as rating them one by one, and must not
+    // disturb the ride the rating processor is busy with.
+    auto calcData = gRideRatingsCalcData;
+    ride_ratings_calculate_all();
+    CheckRatings();
+    ASSERT_EQ(gRideRatingsCalcData.current_ride, calcData.current_ride);
+    ASSERT_EQ(gRideRatingsCalcData.state, calcData.state);
+    ASSERT_EQ(gRideRatingsCalcData.proximity_total, calcData.proximity_total);
+
+    // Flat rides mark themselves as tested when they are rated
     for (int rideId = 0; rideId < MAX_RIDES; rideId++)
     {
-        Ride* ride = get_ride(rideId);
-        if (ride->type != RIDE_TYPE_NULL)
-        {
-            std::string actual = FormatRatings(ride);
-            std::string expected = expectedRatings[expI];
-            ASSERT_STREQ(actual.c_str(), expected.c_str());
-
-            expI++;
-        }
+        ASSERT_EQ(get_ride(rideId)->lifecycle_flags, expectedLifecycleFlags[rideId]);
     }
 }
@@ -0,0 +1,248 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "TestData.h"
+
+#include <gtest/gtest.h>
+#include <openrct2/Context.h>
+#include <openrct2/Game.h>
+#include <openrct2/OpenRCT2.h>
+#include <openrct2/ParkImporter.h>
+#include <openrct2/core/MemoryStream.h>
+#include <openrct2/object/ObjectManager.h>
+#include <openrct2/platform/platform.h>
+#include <openrct2/rct2/S6Exporter.h>
+#include <openrct2/ride/Ride.h>
+#include <openrct2/world/Park.h>
+#include <openrct2/world/Sprite.h>
+#include <memory>
+#include <vector>
+
+using namespace OpenRCT2;
+
+class SpritePoolTest : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        reset_sprite_list();
+    }
+
+    void TearDown() override
+    {
+        reset_sprite_list();
+    }
+
+    static std::vector<rct_sprite*> CreateSprites(size_t count)
+    {
+        std::vector<rct_sprite*> sprites;
+        for (size_t i = 0; i < count; i++)
+        {
+            rct_sprite* sprite = create_sprite(SPRITE_IDENTIFIER_PEEP);
+            if (sprite == nullptr)
+                break;
+            sprite->generic.sprite_identifier = SPRITE_IDENTIFIER_PEEP;
+            sprites.push_back(sprite);
+        }
+        return sprites;
+    }
+};
+
+TEST_F(SpritePoolTest, starts_at_s6_capacity)
+{
+    ASSERT_EQ(sprite_get_capacity(), (size_t)SPRITE_POOL_INITIAL_CAPACITY);
+    ASSERT_EQ(gSpriteListCount[SPRITE_LIST_NULL], SPRITE_POOL_INITIAL_CAPACITY);
+}
+
+TEST_F(SpritePoolTest, grows_beyond_s6_capacity)
+{
+    constexpr size_t count = SPRITE_POOL_INITIAL_CAPACITY + SPRITE_POOL_CHUNK_SIZE + 1;
+    auto sprites = CreateSprites(count);
+    ASSERT_EQ(sprites.size(), count);
+    ASSERT_EQ(sprite_get_capacity(), (size_t)SPRITE_POOL_INITIAL_CAPACITY + 2 * SPRITE_POOL_CHUNK_SIZE);
+    ASSERT_EQ(gSpriteListCount[SPRITE_LIST_UNKNOWN], count);
+    ASSERT_EQ(gSpriteListCount[SPRITE_LIST_NULL], sprite_get_capacity() - count);
+
+    // Ids stay unique and keep resolving to the same sprite after the pool has grown.
+    std::vector<bool> seen(sprite_get_capacity());
+    for (auto sprite : sprites)
+    {
+        uint16_t spriteIndex = sprite->generic.sprite_index;
+        ASSERT_FALSE(seen[spriteIndex]);
+        seen[spriteIndex] = true;
+        ASSERT_EQ(get_sprite(spriteIndex), sprite);
+    }
+}
+
+TEST_F(SpritePoolTest, removed_sprites_are_reused)
+{
+    auto sprites = CreateSprites(SPRITE_POOL_INITIAL_CAPACITY + 1);
+    size_t capacity = sprite_get_capacity();
+    uint16_t removedIndex = sprites.back()->generic.sprite_index;
+    sprite_remove(sprites.back());
+
+    // The free list now holds the rest of the new chunk, take all of it to get the removed sprite back.
+    size_t numFree = gSpriteListCount[SPRITE_LIST_NULL];
+    auto reused = CreateSprites(numFree);
+    ASSERT_EQ(reused.size(), numFree);
+    ASSERT_EQ(sprite_get_capacity(), capacity);
+
+    bool found = false;
+    for (auto sprite : reused)
+    {
+        found |= sprite->generic.sprite_index == removedIndex;
+    }
+    ASSERT_TRUE(found);
+}
+
+TEST_F(SpritePoolTest, stops_at_max_sprites)
+{
+    auto sprites = CreateSprites(MAX_SPRITES + 1);
+    ASSERT_EQ(sprites.size(), (size_t)MAX_SPRITES);
+    ASSERT_EQ(sprite_get_capacity(), (size_t)MAX_SPRITES);
+    ASSERT_EQ(create_sprite(SPRITE_IDENTIFIER_PEEP), nullptr);
+}
+
+TEST_F(SpritePoolTest, reset_shrinks_pool)
+{
+    CreateSprites(SPRITE_POOL_INITIAL_CAPACITY + 1);
+    ASSERT_GT(sprite_get_capacity(), (size_t)SPRITE_POOL_INITIAL_CAPACITY);
+    reset_sprite_list();
+    ASSERT_EQ(sprite_get_capacity(), (size_t)SPRITE_POOL_INITIAL_CAPACITY);
+    ASSERT_EQ(try_get_sprite(SPRITE_POOL_INITIAL_CAPACITY), nullptr);
+}
+
+TEST_F(SpritePoolTest, fast_checksum_tracks_sprite_state)
+{
+    auto sprites = CreateSprites(SPRITE_POOL_INITIAL_CAPACITY + 1);
+    uint64_t checksum = sprite_checksum_fast();
+    ASSERT_EQ(sprite_checksum_fast(), checksum);
+
+    // Screen bounds are not game state.
+    sprites.back()->generic.sprite_left = 100;
+    ASSERT_EQ(sprite_checksum_fast(), checksum);
+
+    sprites.back()->generic.z = 10;
+    ASSERT_NE(sprite_checksum_fast(), checksum);
+    sprites.back()->generic.z = 0;
+    ASSERT_EQ(sprite_checksum_fast(), checksum);
+
+    // Sprites are hashed along with their index, so swapping the state of two sprites changes the checksum.
+    sprites[0]->generic.z = 1;
+    sprites[1]->generic.z = 2;
+    checksum = sprite_checksum_fast();
+    sprites[0]->generic.z = 2;
+    sprites[1]->generic.z = 1;
+    ASSERT_NE(sprite_checksum_fast(), checksum);
+}
+
+/**
+ * Saves a park whose sprite pool has grown beyond what S6 files hold and loads it back.
+ */
+class SpritePoolSaveTest : public testing::Test
+{
+protected:
+    std::unique_ptr<IContext> Context;
+    Ride* RaceRide = nullptr;
+    uint16_t HighVehicleIndex = SPRITE_INDEX_NULL;
+
+    void SetUp() override
+    {
+        gOpenRCT2Headless = true;
+        gOpenRCT2NoGraphics = true;
+
+        core_init();
+        Context = CreateContext();
+        ASSERT_TRUE(Context->Initialise());
+        load_from_sv6(TestData::GetParkPath("bpb.sv6").c_str());
+
+        // Fill the pool beyond the S6 limit with sprites that can not be left out of a save, so that guests have to
+        // be dropped and the sprites above the limit are moved into their slots.
+        size_t numSprites = gSpriteListCount[SPRITE_LIST_NULL] + 1000;
+        for (size_t i = 0; i < numSprites; i++)
+        {
+            rct_sprite* sprite = create_sprite(SPRITE_IDENTIFIER_VEHICLE);
+            ASSERT_NE(sprite, nullptr);
+            sprite->generic.sprite_identifier = SPRITE_IDENTIFIER_VEHICLE;
+            HighVehicleIndex = sprite->generic.sprite_index;
+        }
+        ASSERT_GT(sprite_get_capacity(), (size_t)RCT2_MAX_SPRITES);
+        ASSERT_GE(HighVehicleIndex, RCT2_MAX_SPRITES);
+
+        // Reference one of the sprites above the limit from outside the sprite array
+        for (int32_t rideIndex = 0; rideIndex < MAX_RIDES && RaceRide == nullptr; rideIndex++)
+        {
+            Ride* ride = get_ride(rideIndex);
+            if (ride->type != RIDE_TYPE_NULL)
+            {
+                RaceRide = ride;
+            }
+        }
+        ASSERT_NE(RaceRide, nullptr);
+        RaceRide->race_winner = HighVehicleIndex;
+    }
+
+    void TearDown() override
+    {
+        Context = nullptr;
+    }
+
+    void Load(MemoryStream& parkData)
+    {
+        parkData.SetPosition(0);
+        auto importer = ParkImporter::CreateS6(Context->GetObjectRepository());
+        auto loadResult = importer->LoadFromStream(&parkData, false);
+        Context->GetObjectManager().LoadObjects(loadResult.RequiredObjects.data(), loadResult.RequiredObjects.size());
+        importer->Import();
+    }
+};
+
+TEST_F(SpritePoolSaveTest, save_downgrades_pool)
+{
+    auto numGuestsInPark = gNumGuestsInPark;
+
+    MemoryStream parkData;
+    S6Exporter exporter;
+    exporter.Export();
+    exporter.SaveGame(&parkData);
+    Load(parkData);
+
+    // Guests were left out to make room, and the reference follows the sprite into its new slot
+    ASSERT_EQ(sprite_get_capacity(), (size_t)RCT2_MAX_SPRITES);
+    ASSERT_LT(gNumGuestsInPark, numGuestsInPark);
+    ASSERT_LT(RaceRide->race_winner, RCT2_MAX_SPRITES);
+    ASSERT_EQ(get_sprite(RaceRide->race_winner)->generic.sprite_identifier, SPRITE_IDENTIFIER_VEHICLE);
+}
+
+TEST_F(SpritePoolSaveTest, extended_pool_restores_exact_state)
+{
+    auto checksum = sprite_checksum_fast();
+    auto capacity = sprite_get_capacity();
+    auto numGuestsInPark = gNumGuestsInPark;
+    auto numGuestsHeadingForPark = gNumGuestsHeadingForPark;
+
+    // Save the way network maps and replays do
+    MemoryStream parkData;
+    MemoryStream poolData;
+    S6Exporter exporter;
+    exporter.ExtendedSpritePoolFollows = true;
+    exporter.Export();
+    exporter.SaveGame(&parkData);
+    sprite_write_extended_pool(&poolData);
+
+    Load(parkData);
+    poolData.SetPosition(0);
+    sprite_read_extended_pool(&poolData);
+
+    ASSERT_EQ(sprite_get_capacity(), capacity);
+    ASSERT_EQ(sprite_checksum_fast(), checksum);
+    ASSERT_EQ(gNumGuestsInPark, numGuestsInPark);
+    ASSERT_EQ(gNumGuestsHeadingForPark, numGuestsHeadingForPark);
+    ASSERT_EQ(RaceRide->race_winner, HighVehicleIndex);
+}
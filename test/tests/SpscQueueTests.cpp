@@ -0,0 +1,66 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <openrct2/core/SpscQueue.h>
+#include <thread>
+
+TEST(SpscQueueTest, pops_in_push_order)
+{
+    SpscQueue<std::unique_ptr<int>> queue;
+    std::unique_ptr<int> value;
+    ASSERT_FALSE(queue.TryPop(value));
+    for (int i = 0; i < 10; i++)
+    {
+        queue.Push(std::make_unique<int>(i));
+    }
+    for (int i = 0; i < 10; i++)
+    {
+        ASSERT_TRUE(queue.TryPop(value));
+        ASSERT_EQ(*value, i);
+    }
+    ASSERT_FALSE(queue.TryPop(value));
+}
+
+TEST(SpscQueueTest, hands_values_between_threads)
+{
+    constexpr int count = 100000;
+    SpscQueue<int> queue;
+    std::thread producer([&queue]() {
+        for (int i = 1; i <= count; i++)
+        {
+            queue.Push(i);
+        }
+    });
+
+    int expected = 1;
+    while (expected <= count)
+    {
+        int value;
+        if (queue.TryPop(value))
+        {
+            ASSERT_EQ(value, expected);
+            expected++;
+        }
+    }
+    producer.join();
+}
+
+TEST(SpscQueueTest, destroys_values_left_in_queue)
+{
+    auto value = std::make_shared<int>(1);
+    {
+        SpscQueue<std::shared_ptr<int>> queue;
+        queue.Push(value);
+        queue.Push(value);
+        ASSERT_EQ(value.use_count(), 3);
+    }
+    ASSERT_EQ(value.use_count(), 1);
+}
@@ -0,0 +1,185 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <gtest/gtest.h>
+#include <openrct2/world/Map.h>
+#include <vector>
+
+class TileElementStoreTest : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        map_load_tile_elements(CreateFlatMap());
+    }
+
+    static std::vector<TileElement> CreateFlatMap()
+    {
+        std::vector<TileElement> tileElements(MAX_TILE_TILE_ELEMENT_POINTERS);
+        for (auto& tileElement : tileElements)
+        {
+            tileElement.ClearAs(TILE_ELEMENT_TYPE_SURFACE);
+            tileElement.flags = TILE_ELEMENT_FLAG_LAST_TILE;
+            tileElement.base_height = 14;
+            tileElement.clearance_height = 14;
+        }
+        return tileElements;
+    }
+
+    static size_t CountElements(int32_t x, int32_t y)
+    {
+        size_t count = 1;
+        for (const TileElement* tileElement = map_get_first_element_at(x, y); !tileElement->IsLastForTile(); tileElement++)
+        {
+            count++;
+        }
+        return count;
+    }
+};
+
+TEST_F(TileElementStoreTest, load_and_get_round_trip)
+{
+    auto tileElements = CreateFlatMap();
+    // Give a tile in the middle of the map a second element.
+    size_t index = 100 + 100 * MAXIMUM_MAP_SIZE_TECHNICAL;
+    tileElements[index].flags = 0;
+    TileElement wall = {};
+    wall.ClearAs(TILE_ELEMENT_TYPE_WALL);
+    wall.flags = TILE_ELEMENT_FLAG_LAST_TILE;
+    wall.base_height = 20;
+    tileElements.insert(tileElements.begin() + index + 1, wall);
+
+    map_load_tile_elements(tileElements);
+    ASSERT_EQ(map_get_num_tile_elements(), tileElements.size());
+    ASSERT_EQ(CountElements(100, 100), 2U);
+    ASSERT_EQ(map_get_first_element_at(100, 100)[1].GetType(), TILE_ELEMENT_TYPE_WALL);
+    ASSERT_EQ(CountElements(101, 100), 1U);
+
+    auto saved = map_get_tile_elements();
+    ASSERT_EQ(saved.size(), tileElements.size());
+    for (size_t i = 0; i < saved.size(); i++)
+    {
+        ASSERT_EQ(saved[i].GetType(), tileElements[i].GetType());
+        ASSERT_EQ(saved[i].flags, tileElements[i].flags);
+        ASSERT_EQ(saved[i].base_height, tileElements[i].base_height);
+    }
+}
+
+TEST_F(TileElementStoreTest, short_input_leaves_blank_tiles)
+{
+    std::vector<TileElement> tileElements(CreateFlatMap());
+    tileElements.resize(10);
+    map_load_tile_elements(tileElements);
+    ASSERT_EQ(map_get_num_tile_elements(), (size_t)MAX_TILE_TILE_ELEMENT_POINTERS);
+    ASSERT_EQ(map_get_first_element_at(200, 200)->GetType(), TILE_ELEMENT_TYPE_SURFACE);
+}
+
+TEST_F(TileElementStoreTest, insert_only_moves_own_tile)
+{
+    for (int32_t i = 0; i < 2000; i++)
+    {
+        ASSERT_TRUE(map_check_free_elements_and_reorganise(1));
+        TileElement* neighbour = map_get_first_element_at(11, 10);
+        TileElement* inserted = tile_element_insert(10, 10, 20 + (i % 100), 0);
+        ASSERT_NE(inserted, nullptr);
+        inserted->SetType(TILE_ELEMENT_TYPE_SMALL_SCENERY);
+        ASSERT_EQ(map_get_first_element_at(11, 10), neighbour);
+    }
+    ASSERT_EQ(CountElements(10, 10), 2001U);
+    ASSERT_EQ(map_get_num_tile_elements(), (size_t)MAX_TILE_TILE_ELEMENT_POINTERS + 2000);
+
+    // Elements stay sorted by height and the surface stays first.
+    const TileElement* tileElement = map_get_first_element_at(10, 10);
+    ASSERT_EQ(tileElement->GetType(), TILE_ELEMENT_TYPE_SURFACE);
+    for (size_t i = 1; i < 2001; i++)
+    {
+        ASSERT_LE(tileElement[i - 1].base_height, tileElement[i].base_height);
+    }
+}
+
+TEST_F(TileElementStoreTest, remove_updates_count)
+{
+    tile_element_insert(10, 10, 20, 0)->SetType(TILE_ELEMENT_TYPE_SMALL_SCENERY);
+    ASSERT_EQ(CountElements(10, 10), 2U);
+    tile_element_remove(&map_get_first_element_at(10, 10)[1]);
+    ASSERT_EQ(CountElements(10, 10), 1U);
+    ASSERT_EQ(map_get_num_tile_elements(), (size_t)MAX_TILE_TILE_ELEMENT_POINTERS);
+}
+
+TEST_F(TileElementStoreTest, store_is_limited_to_s6_capacity)
+{
+    auto tileElements = CreateFlatMap();
+    // Stack all the spare elements on the first tile.
+    tileElements[0].flags = 0;
+    TileElement spare = tileElements[0];
+    spare.base_height = 20;
+    size_t numSpare = MAX_TILE_ELEMENTS - MAX_TILE_TILE_ELEMENT_POINTERS;
+    tileElements.insert(tileElements.begin() + 1, numSpare, spare);
+    tileElements[numSpare].flags = TILE_ELEMENT_FLAG_LAST_TILE;
+
+    map_load_tile_elements(tileElements);
+    ASSERT_EQ(map_get_num_tile_elements(), (size_t)MAX_TILE_ELEMENTS);
+    ASSERT_FALSE(map_check_free_elements_and_reorganise(1));
+    ASSERT_EQ(tile_element_insert(10, 10, 20, 0), nullptr);
+}
+
+TEST_F(TileElementStoreTest, holes_are_reused_once_released)
+{
+    tile_element_insert(10, 10, 20, 0);
+    TileElement* oldBlock = map_get_first_element_at(10, 10);
+    tile_element_insert(10, 10, 30, 0);
+
+    // The two elements tile (10, 10) had are not reused until the next check.
+    tile_element_insert(12, 10, 20, 0);
+    ASSERT_NE(map_get_first_element_at(12, 10), oldBlock);
+
+    ASSERT_TRUE(map_check_free_elements_and_reorganise(1));
+    tile_element_insert(13, 10, 20, 0);
+    ASSERT_EQ(map_get_first_element_at(13, 10), oldBlock);
+    ASSERT_EQ(CountElements(13, 10), 2U);
+    ASSERT_EQ(CountElements(10, 10), 3U);
+}
+
+TEST_F(TileElementStoreTest, compaction_is_incremental)
+{
+    // Grow one tile in every chunk far beyond its share, leaving plenty of holes behind.
+    for (int32_t i = 0; i < 50; i++)
+    {
+        ASSERT_TRUE(map_check_free_elements_and_reorganise(1));
+        for (int32_t y = 0; y < MAXIMUM_MAP_SIZE_TECHNICAL; y += 32)
+        {
+            for (int32_t x = 0; x < MAXIMUM_MAP_SIZE_TECHNICAL; x += 32)
+            {
+                tile_element_insert(x, y, 20 + i, 0);
+            }
+        }
+    }
+    auto before = map_get_tile_elements();
+
+    // Each update compacts a single chunk, so the chunk of the first tile is compacted by the first update
+    // and the chunk of the last tile only by a later one.
+    TileElement* first = map_get_first_element_at(0, 0);
+    TileElement* last = map_get_first_element_at(224, 224);
+    map_update_tile_element_store();
+    ASSERT_NE(map_get_first_element_at(0, 0), first);
+    ASSERT_EQ(map_get_first_element_at(224, 224), last);
+    for (int32_t i = 0; i < 64; i++)
+    {
+        map_update_tile_element_store();
+    }
+    ASSERT_NE(map_get_first_element_at(224, 224), last);
+
+    auto after = map_get_tile_elements();
+    ASSERT_EQ(after.size(), before.size());
+    for (size_t i = 0; i < after.size(); i++)
+    {
+        ASSERT_EQ(after[i].base_height, before[i].base_height);
+        ASSERT_EQ(after[i].flags, before[i].flags);
+    }
+}